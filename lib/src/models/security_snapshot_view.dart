@@ -0,0 +1,161 @@
+// GENERATED CODE - DO NOT MODIFY BY HAND.
+// Generated by linux/tools/snapshot_view_main.cpp from
+// linux/snapshot_record.h and src/check_registry.h.
+
+import 'dart:typed_data';
+
+/// Read-only view over the binary security snapshot record, format
+/// version 1.
+///
+/// Nothing is decoded up front; each getter reads its field from [bytes]
+/// when called. [bytes] can be stored or forwarded unchanged.
+class SecuritySnapshotView {
+  /// Wraps [bytes]; throws a [FormatException] unless they hold a record
+  /// of [formatVersion].
+  SecuritySnapshotView(this.bytes) : _data = ByteData.sublistView(bytes) {
+    if (bytes.lengthInBytes < recordSize || magic != recordMagic) {
+      throw const FormatException('Not a security snapshot record');
+    }
+    if (version != formatVersion ||
+        size < recordSize ||
+        size > bytes.lengthInBytes) {
+      throw FormatException(
+        'Unsupported security snapshot record (version $version, size $size)',
+      );
+    }
+  }
+
+  static const int recordMagic = 0x4B465355;
+  static const int formatVersion = 1;
+  static const int recordSize = 64;
+
+  /// Bit of each check in [checkBits], [presentBits] and [failedBits].
+  static const Map<String, int> checkIndex = {
+    'isRooted': 1,
+    'isJailbroken': 2,
+    'isEmulator': 3,
+    'isDebuggerAttached': 5,
+    'isScreenCaptureBlocked': 8,
+    'isUsbCableAttached': 9,
+    'verifyAppIntegrity': 12,
+    'hasProxySettings': 20,
+    'hasVPNConnection': 21,
+    'isDeveloperModeEnabled': 23,
+  };
+
+  static const List<String> platformNames = [
+    'unknown',
+    'linux',
+    'windows',
+  ];
+
+  static const List<String> usbConnectionTypeNames = [
+    'none',
+    'data_transfer',
+    'usb_charging',
+    'usb_debugging',
+    'charging',
+  ];
+
+  static const List<String> powerSourceNames = [
+    'unknown',
+    'none',
+    'ac',
+    'usb',
+    'wireless',
+  ];
+
+  final Uint8List bytes;
+  final ByteData _data;
+
+  int get magic => _data.getUint32(0, Endian.little);
+
+  int get version => _data.getUint16(4, Endian.little);
+
+  int get size => _data.getUint16(6, Endian.little);
+
+  int get checkBits => _data.getUint64(8, Endian.little);
+
+  int get presentBits => _data.getUint64(16, Endian.little);
+
+  int get failedBits => _data.getUint64(24, Endian.little);
+
+  int get timestamp => _data.getInt64(32, Endian.little);
+
+  int get durationMicros => _data.getInt64(40, Endian.little);
+
+  int get queueDepth => _data.getUint32(48, Endian.little);
+
+  int get usbDeviceCount => _data.getUint32(52, Endian.little);
+
+  String get platform => _name(platformNames, _data.getUint8(56));
+
+  String get usbConnectionType =>
+      _name(usbConnectionTypeNames, _data.getUint8(57));
+
+  String get powerSource => _name(powerSourceNames, _data.getUint8(58));
+
+  int get usbFlags => _data.getUint8(59);
+  bool get isCharging => (usbFlags & 0x1) != 0;
+  bool get isDataTransfer => (usbFlags & 0x2) != 0;
+  bool get isUsbCharging => (usbFlags & 0x4) != 0;
+  bool get isConnectedToComputer => (usbFlags & 0x8) != 0;
+  bool get isConnectedViaUsb => (usbFlags & 0x10) != 0;
+
+  /// The `isRooted` result, or null if that check did not run.
+  bool? get isRooted => _check(1);
+  /// The `isJailbroken` result, or null if that check did not run.
+  bool? get isJailbroken => _check(2);
+  /// The `isEmulator` result, or null if that check did not run.
+  bool? get isEmulator => _check(3);
+  /// The `isDebuggerAttached` result, or null if that check did not run.
+  bool? get isDebuggerAttached => _check(5);
+  /// The `isScreenCaptureBlocked` result, or null if that check did not run.
+  bool? get isScreenCaptureBlocked => _check(8);
+  /// The `isUsbCableAttached` result, or null if that check did not run.
+  bool? get isUsbCableAttached => _check(9);
+  /// The `verifyAppIntegrity` result, or null if that check did not run.
+  bool? get verifyAppIntegrity => _check(12);
+  /// The `hasProxySettings` result, or null if that check did not run.
+  bool? get hasProxySettings => _check(20);
+  /// The `hasVPNConnection` result, or null if that check did not run.
+  bool? get hasVPNConnection => _check(21);
+  /// The `isDeveloperModeEnabled` result, or null if that check did not run.
+  bool? get isDeveloperModeEnabled => _check(23);
+
+  /// The result of the check named [name], or null if it did not run.
+  bool? check(String name) {
+    final index = checkIndex[name];
+    return index == null ? null : _check(index);
+  }
+
+  /// Checks that threw instead of answering.
+  List<String> get failedChecks => [
+    for (final entry in checkIndex.entries)
+      if ((failedBits & (1 << entry.value)) != 0) entry.key,
+  ];
+
+  /// The snapshot in the shape getSecuritySnapshot() returns.
+  Map<String, dynamic> toMap() {
+    final map = <String, dynamic>{};
+    for (final entry in checkIndex.entries) {
+      final value = _check(entry.value);
+      if (value != null) map[entry.key] = value;
+    }
+    map['failedChecks'] = failedChecks;
+    map['platform'] = platform;
+    map['timestamp'] = timestamp;
+    map['durationMicros'] = durationMicros;
+    map['queueDepth'] = queueDepth;
+    return map;
+  }
+
+  bool? _check(int index) {
+    final bit = 1 << index;
+    if ((presentBits & bit) == 0) return null;
+    return (checkBits & bit) != 0;
+  }
+
+  static String _name(List<String> names, int code) =>
+      code < names.length ? names[code] : 'unknown';
+}
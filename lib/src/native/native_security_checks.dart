@@ -0,0 +1,172 @@
+import 'dart:ffi';
+import 'dart:io';
+
+import 'package:ffi/ffi.dart';
+
+import 'native_security_snapshot.dart';
+
+/// Mirrors usfk_snapshot_t in linux/native_api.h.
+final class _UsfkSnapshot extends Struct {
+  @Uint32()
+  external int size;
+  @Uint8()
+  external int isRooted;
+  @Uint8()
+  external int isJailbroken;
+  @Uint8()
+  external int isEmulator;
+  @Uint8()
+  external int isDebuggerAttached;
+  @Uint8()
+  external int isScreenCaptureBlocked;
+  @Uint8()
+  external int isUsbCableAttached;
+  @Uint8()
+  external int hasProxySettings;
+  @Uint8()
+  external int hasVpnConnection;
+  @Uint8()
+  external int isDeveloperModeEnabled;
+  @Array(3)
+  external Array<Uint8> reserved;
+  @Int64()
+  external int timestampMs;
+  @Int64()
+  external int durationUs;
+}
+
+typedef _CheckNative = Int32 Function();
+typedef _Check = int Function();
+typedef _SnapshotNative = Int32 Function(Pointer<_UsfkSnapshot>);
+typedef _Snapshot = int Function(Pointer<_UsfkSnapshot>);
+typedef _VersionNative = Uint32 Function();
+
+/// The cheap native checks called synchronously through the plugin's C
+/// API (linux/native_api.h), so sensitive UI actions can be gated inline
+/// instead of awaiting a method-channel reply.
+///
+/// Each getter runs its check on the calling thread; usable from any
+/// isolate. The answers and the logging are those of the method channel,
+/// which stays available.
+///
+/// Most checks touch the filesystem or the kernel: path probes, a USB
+/// rescan, an rtnetlink dump for the VPN check. They normally take well
+/// under a millisecond but can block on slow I/O, so they are not leaf
+/// calls and the VM can still reach a safepoint while one runs. Only the
+/// debugger, screen capture and proxy checks, which read memory, an
+/// already open procfs file or the environment, are bound as leaf calls.
+///
+/// Only the Linux plugin exports the API; [instance] is null elsewhere.
+class NativeSecurityChecks {
+  NativeSecurityChecks._(DynamicLibrary library)
+    : _isRooted = _lookupCheck(library, 'usfk_is_rooted'),
+      _isJailbroken = _lookupCheck(library, 'usfk_is_jailbroken'),
+      _isEmulator = _lookupCheck(library, 'usfk_is_emulator'),
+      _isDebuggerAttached = _lookupCheck(
+        library,
+        'usfk_is_debugger_attached',
+        isLeaf: true,
+      ),
+      _isScreenCaptureBlocked = _lookupCheck(
+        library,
+        'usfk_is_screen_capture_blocked',
+        isLeaf: true,
+      ),
+      _isUsbCableAttached = _lookupCheck(
+        library,
+        'usfk_is_usb_cable_attached',
+      ),
+      _hasProxySettings = _lookupCheck(
+        library,
+        'usfk_has_proxy_settings',
+        isLeaf: true,
+      ),
+      _hasVpnConnection = _lookupCheck(library, 'usfk_has_vpn_connection'),
+      _isDeveloperModeEnabled = _lookupCheck(
+        library,
+        'usfk_is_developer_mode_enabled',
+      ),
+      _snapshot = library.lookupFunction<_SnapshotNative, _Snapshot>(
+        'usfk_snapshot',
+      );
+
+  /// Bound on first use in each isolate; null if the plugin library is not
+  /// loaded or predates the C API.
+  static final NativeSecurityChecks? instance = _load();
+
+  static const String _libraryName = 'libultra_secure_flutter_kit_plugin.so';
+
+  final _Check _isRooted;
+  final _Check _isJailbroken;
+  final _Check _isEmulator;
+  final _Check _isDebuggerAttached;
+  final _Check _isScreenCaptureBlocked;
+  final _Check _isUsbCableAttached;
+  final _Check _hasProxySettings;
+  final _Check _hasVpnConnection;
+  final _Check _isDeveloperModeEnabled;
+  final _Snapshot _snapshot;
+
+  /// Reused by every snapshot() on this isolate; never freed.
+  late final Pointer<_UsfkSnapshot> _buffer = calloc<_UsfkSnapshot>();
+
+  bool get isRooted => _isRooted() != 0;
+  bool get isJailbroken => _isJailbroken() != 0;
+  bool get isEmulator => _isEmulator() != 0;
+  bool get isDebuggerAttached => _isDebuggerAttached() != 0;
+  bool get isScreenCaptureBlocked => _isScreenCaptureBlocked() != 0;
+  bool get isUsbCableAttached => _isUsbCableAttached() != 0;
+  bool get hasProxySettings => _hasProxySettings() != 0;
+  bool get hasVPNConnection => _hasVpnConnection() != 0;
+  bool get isDeveloperModeEnabled => _isDeveloperModeEnabled() != 0;
+
+  /// All of the above in one call.
+  NativeSecuritySnapshot snapshot() {
+    final native = _buffer.ref;
+    native.size = sizeOf<_UsfkSnapshot>();
+    if (_snapshot(_buffer) != 0) {
+      throw StateError('usfk_snapshot rejected the request');
+    }
+    return NativeSecuritySnapshot(
+      isRooted: native.isRooted != 0,
+      isJailbroken: native.isJailbroken != 0,
+      isEmulator: native.isEmulator != 0,
+      isDebuggerAttached: native.isDebuggerAttached != 0,
+      isScreenCaptureBlocked: native.isScreenCaptureBlocked != 0,
+      isUsbCableAttached: native.isUsbCableAttached != 0,
+      hasProxySettings: native.hasProxySettings != 0,
+      hasVPNConnection: native.hasVpnConnection != 0,
+      isDeveloperModeEnabled: native.isDeveloperModeEnabled != 0,
+      timestamp: native.timestampMs,
+      durationMicros: native.durationUs,
+    );
+  }
+
+  static _Check _lookupCheck(
+    DynamicLibrary library,
+    String name, {
+    bool isLeaf = false,
+  }) => library.lookupFunction<_CheckNative, _Check>(name, isLeaf: isLeaf);
+
+  static NativeSecurityChecks? _load() {
+    if (!Platform.isLinux) return null;
+    // The runner links the plugin, so its symbols are normally visible in
+    // the process already; opening it by name covers other loaders.
+    for (final open in [
+      DynamicLibrary.process,
+      () => DynamicLibrary.open(_libraryName),
+    ]) {
+      try {
+        final library = open();
+        if (!library.providesSymbol('usfk_api_version')) continue;
+        final version = library
+            .lookupFunction<_VersionNative, int Function()>('usfk_api_version')();
+        if (version < 1) continue;
+        return NativeSecurityChecks._(library);
+      } on ArgumentError {
+        continue;
+      }
+    }
+    return null;
+  }
+}
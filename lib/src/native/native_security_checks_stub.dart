@@ -0,0 +1,25 @@
+import 'native_security_snapshot.dart';
+
+/// Stand-in for platforms without dart:ffi (web); [instance] is always
+/// null there.
+class NativeSecurityChecks {
+  NativeSecurityChecks._();
+
+  static final NativeSecurityChecks? instance = null;
+
+  bool get isRooted => throw _unsupported;
+  bool get isJailbroken => throw _unsupported;
+  bool get isEmulator => throw _unsupported;
+  bool get isDebuggerAttached => throw _unsupported;
+  bool get isScreenCaptureBlocked => throw _unsupported;
+  bool get isUsbCableAttached => throw _unsupported;
+  bool get hasProxySettings => throw _unsupported;
+  bool get hasVPNConnection => throw _unsupported;
+  bool get isDeveloperModeEnabled => throw _unsupported;
+
+  NativeSecuritySnapshot snapshot() => throw _unsupported;
+
+  static final _unsupported = UnsupportedError(
+    'Native security checks need dart:ffi',
+  );
+}
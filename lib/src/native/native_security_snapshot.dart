@@ -0,0 +1,46 @@
+/// Result of [NativeSecurityChecks.snapshot]: the cheap native checks,
+/// run synchronously on the calling isolate's thread.
+class NativeSecuritySnapshot {
+  const NativeSecuritySnapshot({
+    required this.isRooted,
+    required this.isJailbroken,
+    required this.isEmulator,
+    required this.isDebuggerAttached,
+    required this.isScreenCaptureBlocked,
+    required this.isUsbCableAttached,
+    required this.hasProxySettings,
+    required this.hasVPNConnection,
+    required this.isDeveloperModeEnabled,
+    required this.timestamp,
+    required this.durationMicros,
+  });
+
+  final bool isRooted;
+  final bool isJailbroken;
+  final bool isEmulator;
+  final bool isDebuggerAttached;
+  final bool isScreenCaptureBlocked;
+  final bool isUsbCableAttached;
+  final bool hasProxySettings;
+  final bool hasVPNConnection;
+  final bool isDeveloperModeEnabled;
+
+  /// Milliseconds since the epoch when the checks started.
+  final int timestamp;
+  final int durationMicros;
+
+  /// The checks keyed like getSecuritySnapshot().
+  Map<String, dynamic> toMap() => {
+    'isRooted': isRooted,
+    'isJailbroken': isJailbroken,
+    'isEmulator': isEmulator,
+    'isDebuggerAttached': isDebuggerAttached,
+    'isScreenCaptureBlocked': isScreenCaptureBlocked,
+    'isUsbCableAttached': isUsbCableAttached,
+    'hasProxySettings': hasProxySettings,
+    'hasVPNConnection': hasVPNConnection,
+    'isDeveloperModeEnabled': isDeveloperModeEnabled,
+    'timestamp': timestamp,
+    'durationMicros': durationMicros,
+  };
+}
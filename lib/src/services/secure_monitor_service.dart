@@ -4,6 +4,7 @@ import 'dart:math';
 import 'dart:typed_data';
 
 import 'package:crypto/crypto.dart';
+import 'package:flutter/services.dart' show MissingPluginException;
 import 'package:ultra_secure_flutter_kit/src/models/security_models.dart';
 import 'package:ultra_secure_flutter_kit/ultra_secure_flutter_kit_platform_interface.dart';
 
@@ -39,6 +40,8 @@ class SecureMonitorService {
   Timer? _monitoringTimer;
   Timer? _threatAnalysisTimer;
   Timer? _autoResponseTimer;
+  StreamSubscription<Map<String, dynamic>>? _nativeEventSubscription;
+  bool _vpnConnected = false;
   int _threatCount = 0;
   int _blockedAttempts = 0;
   int _apiHits = 0;
@@ -143,6 +146,9 @@ class SecureMonitorService {
         _executeAutoResponse();
       });
 
+      // Native state changes are pushed as they happen where supported.
+      await _startNativeEventMonitoring();
+
       _logSecurityEvent('Real-time monitoring started', LogLevel.info);
     } catch (e) {
       _logSecurityEvent('Monitoring start failed: $e', LogLevel.error);
@@ -213,6 +219,106 @@ class SecureMonitorService {
     }
   }
 
+  /// Subscribe to native security events and start the platform monitor
+  Future<void> _startNativeEventMonitoring() async {
+    try {
+      _nativeEventSubscription = UltraSecureFlutterKitPlatform.instance
+          .securityEvents()
+          .listen(
+            _handleNativeSecurityEvent,
+            onError: (Object e) {
+              _logSecurityEvent(
+                'Native security events unavailable: $e',
+                LogLevel.debug,
+              );
+            },
+          );
+      await UltraSecureFlutterKitPlatform.instance.enableRealTimeMonitoring();
+    } catch (e) {
+      _logSecurityEvent(
+        'Native event monitoring unavailable: $e',
+        LogLevel.debug,
+      );
+    }
+  }
+
+  /// Handle a state change pushed by the native monitor
+  void _handleNativeSecurityEvent(Map<String, dynamic> event) {
+    try {
+      _logSecurityEvent(
+        'Native security event: ${event['type']} ${event['name'] ?? ''}',
+        LogLevel.debug,
+      );
+
+      SecurityThreat? threat;
+      if (event['type'] == 'codeTampered') {
+        threat = SecurityThreat(
+          type: SecurityThreatType.appTamperingDetected,
+          level: SecurityThreatLevel.critical,
+          description: 'Code modified in memory: ${event['name']}',
+          timestamp: DateTime.now(),
+          metadata: event,
+        );
+      } else if (event['type'] == 'assetTampered') {
+        threat = SecurityThreat(
+          type: SecurityThreatType.appTamperingDetected,
+          level: SecurityThreatLevel.critical,
+          description: 'Bundled asset ${event['status']}: ${event['name']}',
+          timestamp: DateTime.now(),
+          metadata: event,
+        );
+      } else if (event['type'] == 'debuggerAttached' ||
+          event['type'] == 'dumpableReset') {
+        threat = SecurityThreat(
+          type: SecurityThreatType.debuggerDetected,
+          level: SecurityThreatLevel.critical,
+          description: 'Debugger activity: ${event['name']} '
+              '(tracer PID: ${event['tracerPid']})',
+          timestamp: DateTime.now(),
+          metadata: event,
+        );
+      } else if (event['type'] == 'executionStalled') {
+        // A stopped process, but also possibly a starved host; the tracer
+        // itself is reported separately as debuggerAttached
+        threat = SecurityThreat(
+          type: SecurityThreatType.suspiciousBehaviorDetected,
+          level: SecurityThreatLevel.medium,
+          description: 'Execution stalled for ${event['stallMillis']} ms',
+          timestamp: DateTime.now(),
+          metadata: event,
+        );
+      } else if (event['hasVPNConnection'] is bool) {
+        // Sent only when the classification changes; raise a threat when a
+        // VPN comes up, not again while it stays up
+        final wasConnected = _vpnConnected;
+        _vpnConnected = event['hasVPNConnection'] as bool;
+        if (_vpnConnected && !wasConnected) {
+          threat = SecurityThreat(
+            type: SecurityThreatType.vpnDetected,
+            level: SecurityThreatLevel.low,
+            description: 'VPN connection detected: ${event['name']}',
+            timestamp: DateTime.now(),
+            metadata: event,
+          );
+        }
+      }
+
+      if (threat != null) {
+        _activeThreats.add(threat);
+        _threatCount++;
+        _lastThreatTime = DateTime.now();
+
+        _threatController.add(threat);
+        _logSecurityEvent(
+          'New threat detected: ${threat.description}',
+          LogLevel.warning,
+        );
+      }
+    } catch (e) {
+      _logSecurityEvent('Native event handling failed: $e', LogLevel.error);
+    }
+  }
+
   /// Analyze detected threats
   void _analyzeThreats() {
     try {
@@ -422,16 +528,33 @@ class SecureMonitorService {
   /// Get device security status
   Future<DeviceSecurityStatus> getDeviceSecurityStatus() async {
     try {
-      final isRooted = await _checkRootStatus();
-      final isJailbroken = await _checkJailbreakStatus();
-      final isEmulator = await _checkEmulatorStatus();
-      final isDebuggerAttached = await _checkDebuggerStatus();
-      final hasProxy = await _checkProxyStatus();
-      final hasVPN = await _checkVPNStatus();
+      // Prefer one native snapshot over a round trip per check; fall back to
+      // the individual checks on platforms that do not provide it.
+      final snapshot = await _fetchSecuritySnapshot();
+      bool? fromSnapshot(String key) {
+        final value = snapshot?[key];
+        return value is bool ? value : null;
+      }
+
+      final isRooted = fromSnapshot('isRooted') ?? await _checkRootStatus();
+      final isJailbroken =
+          fromSnapshot('isJailbroken') ?? await _checkJailbreakStatus();
+      final isEmulator =
+          fromSnapshot('isEmulator') ?? await _checkEmulatorStatus();
+      final isDebuggerAttached =
+          fromSnapshot('isDebuggerAttached') ?? await _checkDebuggerStatus();
+      final hasProxy =
+          fromSnapshot('hasProxySettings') ?? await _checkProxyStatus();
+      final hasVPN = fromSnapshot('hasVPNConnection') ?? await _checkVPNStatus();
       final isScreenCaptureBlocked = _config?.enableScreenshotBlocking ?? false;
       final isSSLValid = await _checkSSLStatus();
-      final isDeveloperModeEnabled = await _checkDeveloperModeStatus();
-      final isUsbCableAttached = await _checkUsbCableStatus();
+      final isDeveloperModeEnabled =
+          _config?.enableDeveloperModeDetection != true
+          ? false
+          : fromSnapshot('isDeveloperModeEnabled') ??
+                await _checkDeveloperModeStatus();
+      final isUsbCableAttached =
+          fromSnapshot('isUsbCableAttached') ?? await _checkUsbCableStatus();
 
       final riskScore = _calculateRiskScore(
         isRooted: isRooted,
@@ -524,6 +647,22 @@ class SecureMonitorService {
     Duration? expiresIn,
   }) async {
     try {
+      // Natively the value goes to the persistent encrypted store; the
+      // in-memory map is the fallback for platforms without one.
+      try {
+        await UltraSecureFlutterKitPlatform.instance.secureStore(
+          key,
+          value,
+          expiresIn: expiresIn,
+        );
+        _logSecurityEvent('Data stored securely: $key', LogLevel.info);
+        return;
+      } on MissingPluginException {
+        // No native store on this platform.
+      } on UnimplementedError {
+        // No native store on this platform.
+      }
+
       // 1. Encrypt the data
       final encryptedValue = await encryptSensitiveData(value);
 
@@ -546,6 +685,19 @@ class SecureMonitorService {
   /// Secure data retrieval
   Future<String?> secureRetrieve(String key) async {
     try {
+      try {
+        final value = await UltraSecureFlutterKitPlatform.instance
+            .secureRetrieve(key);
+        if (value != null) {
+          _logSecurityEvent('Data retrieved securely: $key', LogLevel.info);
+        }
+        return value;
+      } on MissingPluginException {
+        // No native store on this platform.
+      } on UnimplementedError {
+        // No native store on this platform.
+      }
+
       final data = _secureStorage[key];
       if (data == null) return null;
 
@@ -571,6 +723,13 @@ class SecureMonitorService {
   /// Delete secure data
   Future<void> secureDelete(String key) async {
     try {
+      try {
+        await UltraSecureFlutterKitPlatform.instance.secureDelete(key);
+      } on MissingPluginException {
+        // No native store on this platform.
+      } on UnimplementedError {
+        // No native store on this platform.
+      }
       _secureStorage.remove(key);
       _logSecurityEvent('Data deleted securely: $key', LogLevel.info);
     } catch (e) {
@@ -582,6 +741,13 @@ class SecureMonitorService {
   /// Clear all secure data
   Future<void> clearAllSecureData() async {
     try {
+      try {
+        await UltraSecureFlutterKitPlatform.instance.clearAllSecureData();
+      } on MissingPluginException {
+        // No native store on this platform.
+      } on UnimplementedError {
+        // No native store on this platform.
+      }
       _secureStorage.clear();
       _logSecurityEvent('All secure data cleared', LogLevel.info);
     } catch (e) {
@@ -590,11 +756,27 @@ class SecureMonitorService {
     }
   }
 
+  /// Marks values sealed by the native cipher; base64 never contains ':'.
+  static const String _nativeCipherPrefix = 'usfk1:';
+
   /// Encrypt sensitive data
+  ///
+  /// Uses the platform's authenticated cipher where there is one and falls
+  /// back to the plain encoding elsewhere.
   Future<String> encryptSensitiveData(String data) async {
     try {
-      // Simple encryption for demo (use proper encryption in production)
       final bytes = utf8.encode(data);
+      try {
+        final sealed = await UltraSecureFlutterKitPlatform.instance.encrypt(
+          Uint8List.fromList(bytes),
+        );
+        return '$_nativeCipherPrefix${base64Encode(sealed)}';
+      } on MissingPluginException {
+        // No native cipher on this platform.
+      } on UnimplementedError {
+        // No native cipher on this platform.
+      }
+      // Simple encryption for demo (use proper encryption in production)
       final encrypted = base64Encode(bytes);
       return encrypted;
     } catch (e) {
@@ -606,6 +788,12 @@ class SecureMonitorService {
   /// Decrypt sensitive data
   Future<String> decryptSensitiveData(String encryptedData) async {
     try {
+      if (encryptedData.startsWith(_nativeCipherPrefix)) {
+        final opened = await UltraSecureFlutterKitPlatform.instance.decrypt(
+          base64Decode(encryptedData.substring(_nativeCipherPrefix.length)),
+        );
+        return utf8.decode(opened);
+      }
       // Simple decryption for demo (use proper decryption in production)
       final bytes = base64Decode(encryptedData);
       final decrypted = utf8.decode(bytes);
@@ -711,6 +899,8 @@ class SecureMonitorService {
       _monitoringTimer?.cancel();
       _threatAnalysisTimer?.cancel();
       _autoResponseTimer?.cancel();
+      await _nativeEventSubscription?.cancel();
+      _nativeEventSubscription = null;
 
       await _threatController.close();
       await _statusController.close();
@@ -981,6 +1171,19 @@ class SecureMonitorService {
     }
   }
 
+  /// Fetch all native checks in one round trip, or null when the platform
+  /// has no snapshot support.
+  Future<Map<String, dynamic>?> _fetchSecuritySnapshot() async {
+    try {
+      final snapshot = await UltraSecureFlutterKitPlatform.instance
+          .getSecuritySnapshot();
+      return snapshot.isEmpty ? null : snapshot;
+    } catch (e) {
+      _logSecurityEvent('Security snapshot unavailable: $e', LogLevel.debug);
+      return null;
+    }
+  }
+
   Future<bool> _checkRootStatus() async {
     try {
       // Check root status (placeholder)
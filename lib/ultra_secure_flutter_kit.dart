@@ -1,6 +1,10 @@
 library ultra_secure_flutter_kit;
 
 export 'src/models/security_models.dart';
+export 'src/models/security_snapshot_view.dart';
+export 'src/native/native_security_checks_stub.dart'
+    if (dart.library.ffi) 'src/native/native_security_checks.dart';
+export 'src/native/native_security_snapshot.dart';
 export 'src/services/secure_monitor_service.dart';
 
 import 'package:flutter/foundation.dart';
@@ -8,6 +12,9 @@ import 'package:local_auth/local_auth.dart' as local_auth;
 
 import 'ultra_secure_flutter_kit_platform_interface.dart';
 import 'src/models/security_models.dart';
+import 'src/models/security_snapshot_view.dart';
+import 'src/native/native_security_checks_stub.dart'
+    if (dart.library.ffi) 'src/native/native_security_checks.dart';
 import 'src/services/secure_monitor_service.dart';
 
 /// Main class for Ultra Secure Flutter Kit
@@ -53,6 +60,10 @@ class UltraSecureFlutterKit {
   ProtectionStatus get protectionStatus =>
       SecureMonitorService.instance.currentStatus;
 
+  /// Synchronous native checks through dart:ffi, or null where the
+  /// platform plugin has no C API (everything but Linux)
+  NativeSecurityChecks? get nativeChecks => NativeSecurityChecks.instance;
+
   /// Get security metrics
   Map<String, dynamic> get securityMetrics =>
       SecureMonitorService.instance.securityMetrics;
@@ -190,6 +201,71 @@ class UltraSecureFlutterKit {
     }
   }
 
+  /// Encrypt bytes with the native authenticated cipher
+  Future<Uint8List> encryptBytes(Uint8List data) async {
+    try {
+      return await UltraSecureFlutterKitPlatform.instance.encrypt(data);
+    } catch (e) {
+      print('Encryption failed: $e');
+      rethrow;
+    }
+  }
+
+  /// Decrypt bytes produced by [encryptBytes] or [encryptStream]
+  Future<Uint8List> decryptBytes(Uint8List data) async {
+    try {
+      return await UltraSecureFlutterKitPlatform.instance.decrypt(data);
+    } catch (e) {
+      print('Decryption failed: $e');
+      rethrow;
+    }
+  }
+
+  /// Encrypt a byte stream chunk by chunk, without holding it in memory
+  ///
+  /// The output joined together is what [encryptBytes] returns for the
+  /// input joined together.
+  Stream<Uint8List> encryptStream(Stream<List<int>> input) =>
+      _cipherStream((platform) => platform.beginEncrypt(), input);
+
+  /// Decrypt a stream produced by [encryptStream] or [encryptBytes]
+  ///
+  /// Only authenticated plaintext is emitted; an altered or truncated
+  /// input ends the stream with an error.
+  Stream<Uint8List> decryptStream(Stream<List<int>> input) =>
+      _cipherStream((platform) => platform.beginDecrypt(), input);
+
+  // The native stream is opened on listen, inside the generator, so a
+  // stream that is never listened to holds no native slot, and a failing
+  // begin ends the stream with its error.
+  Stream<Uint8List> _cipherStream(
+    Future<int> Function(UltraSecureFlutterKitPlatform platform) begin,
+    Stream<List<int>> input,
+  ) async* {
+    final platform = UltraSecureFlutterKitPlatform.instance;
+    final handle = await begin(platform);
+    var finished = false;
+    try {
+      // Each chunk is awaited before the next is sent: the native side
+      // expects a stream's calls in order.
+      await for (final chunk in input) {
+        final output = await platform.cipherUpdate(
+          handle,
+          chunk is Uint8List ? chunk : Uint8List.fromList(chunk),
+        );
+        if (output.isNotEmpty) yield output;
+      }
+      finished = true;
+      final output = await platform.cipherFinish(handle);
+      if (output.isNotEmpty) yield output;
+    } finally {
+      if (!finished) {
+        // Close the native stream after an error or a cancelled listen.
+        await platform.cipherFinish(handle).catchError((_) => Uint8List(0));
+      }
+    }
+  }
+
   /// Sanitize input data
   String sanitizeInput(String input) {
     try {
@@ -297,6 +373,19 @@ class UltraSecureFlutterKit {
     }
   }
 
+  /// Get emulator detection details (confidence and detection source)
+  Future<Map<String, dynamic>> getEmulatorDetails() async {
+    try {
+      return await _runInBackground(() async {
+        return await UltraSecureFlutterKitPlatform.instance
+            .getEmulatorDetails();
+      });
+    } catch (e) {
+      print('Emulator details retrieval failed: $e');
+      return {};
+    }
+  }
+
   /// Check if debugger is attached
   Future<bool> isDebuggerAttached() async {
     try {
@@ -416,6 +505,18 @@ class UltraSecureFlutterKit {
     }
   }
 
+  /// List attached USB devices
+  Future<List<Map<String, dynamic>>> listUsbDevices() async {
+    try {
+      return await _runInBackground(() async {
+        return await UltraSecureFlutterKitPlatform.instance.listUsbDevices();
+      });
+    } catch (e) {
+      print('USB device listing failed: $e');
+      return [];
+    }
+  }
+
   /// Get app signature
   Future<String> getAppSignature() async {
     try {
@@ -454,6 +555,20 @@ class UltraSecureFlutterKit {
     }
   }
 
+  /// Re-validate the cached device fingerprint, returning true if it changed
+  Future<bool> refreshFingerprint({bool force = false}) async {
+    try {
+      return await _runInBackground(() async {
+        return await UltraSecureFlutterKitPlatform.instance.refreshFingerprint(
+          force: force,
+        );
+      });
+    } catch (e) {
+      debugPrint('Device fingerprint refresh failed: $e');
+      return false;
+    }
+  }
+
   /// Enable secure flag
   Future<void> enableSecureFlag() async {
     try {
@@ -493,11 +608,17 @@ class UltraSecureFlutterKit {
   }
 
   /// Prevent reverse engineering
-  Future<void> preventReverseEngineering() async {
+  ///
+  /// On Linux this also starts a debugger watchdog whose findings arrive
+  /// as security events; [denyDebuggerAttach] additionally blocks ptrace
+  /// attach from non-root debuggers.
+  Future<void> preventReverseEngineering({
+    bool denyDebuggerAttach = false,
+  }) async {
     try {
       await _runInBackground(() async {
         return await UltraSecureFlutterKitPlatform.instance
-            .preventReverseEngineering();
+            .preventReverseEngineering(denyDebuggerAttach: denyDebuggerAttach);
       });
     } catch (e) {
       debugPrint('Reverse engineering prevention failed: $e');
@@ -589,6 +710,29 @@ class UltraSecureFlutterKit {
     }
   }
 
+  /// Run all device security checks in a single native call
+  Future<Map<String, dynamic>> getSecuritySnapshot() async {
+    try {
+      return await _runInBackground(() async {
+        return await UltraSecureFlutterKitPlatform.instance
+            .getSecuritySnapshot();
+      });
+    } catch (e) {
+      print('Security snapshot failed: $e');
+      return {};
+    }
+  }
+
+  /// Native call counts and latency percentiles per method
+  Future<Map<String, dynamic>> getPerformanceStats() async {
+    try {
+      return await UltraSecureFlutterKitPlatform.instance.getPerformanceStats();
+    } catch (e) {
+      print('Performance stats retrieval failed: $e');
+      return {};
+    }
+  }
+
   /// Configure SSL pinning
   Future<void> configureSSLPinning(
     List<String> certificates,
@@ -621,6 +765,81 @@ class UltraSecureFlutterKit {
     }
   }
 
+  /// Set the native log level ('debug', 'info', 'warning', 'error', 'off')
+  Future<void> setLogLevel(String level) async {
+    try {
+      await UltraSecureFlutterKitPlatform.instance.setLogLevel(level);
+    } catch (e) {
+      print('Setting log level failed: $e');
+    }
+  }
+
+  /// Running debuggers and instrumentation tools, and the process tracing
+  /// the app if any
+  Future<Map<String, dynamic>> getRunningAnalysisTools() async {
+    try {
+      return await _runInBackground(() async {
+        return await UltraSecureFlutterKitPlatform.instance
+            .getRunningAnalysisTools();
+      });
+    } catch (e) {
+      print('Analysis tool detection failed: $e');
+      return {};
+    }
+  }
+
+  /// Network interfaces by kind, and the default route behind the VPN check
+  Future<Map<String, dynamic>> getNetworkInterfaces() async {
+    try {
+      return await UltraSecureFlutterKitPlatform.instance.getNetworkInterfaces();
+    } catch (e) {
+      print('Network interface listing failed: $e');
+      return {};
+    }
+  }
+
+  /// Check the bundled Flutter assets and app code against the signed
+  /// manifest generated at build time
+  ///
+  /// Hashing runs in the background, assets in use first; without [wait]
+  /// this reports progress so far.
+  Future<Map<String, dynamic>> verifyAssets({bool wait = false}) async {
+    try {
+      return await UltraSecureFlutterKitPlatform.instance.verifyAssets(
+        wait: wait,
+      );
+    } catch (e) {
+      print('Asset verification failed: $e');
+      return {};
+    }
+  }
+
+  /// Security snapshot as a lazily decoded binary record, or null where the
+  /// platform only answers getSecuritySnapshot() with a map
+  Future<SecuritySnapshotView?> getSecuritySnapshotRecord() async {
+    try {
+      final bytes = await _runInBackground(() async {
+        return await UltraSecureFlutterKitPlatform.instance
+            .getSecuritySnapshotRecord();
+      });
+      return bytes.isEmpty ? null : SecuritySnapshotView(bytes);
+    } catch (e) {
+      print('Security snapshot record failed: $e');
+      return null;
+    }
+  }
+
+  /// Set the process names treated as analysis tools (empty for defaults)
+  Future<void> setProcessSignatures(List<String> signatures) async {
+    try {
+      await UltraSecureFlutterKitPlatform.instance.setProcessSignatures(
+        signatures,
+      );
+    } catch (e) {
+      print('Setting process signatures failed: $e');
+    }
+  }
+
   /// Check if biometric authentication is available
   Future<bool> isBiometricAvailable() async {
     try {
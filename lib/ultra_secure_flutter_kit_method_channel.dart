@@ -9,6 +9,10 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
   @visibleForTesting
   final methodChannel = const MethodChannel('ultra_secure_flutter_kit');
 
+  /// The event channel used to receive native security state changes.
+  @visibleForTesting
+  final eventChannel = const EventChannel('ultra_secure_flutter_kit/events');
+
   @override
   Future<String?> getPlatformVersion() async {
     final version = await methodChannel.invokeMethod<String>(
@@ -35,6 +39,15 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
     return result ?? false;
   }
 
+  @override
+  Future<Map<String, dynamic>> getEmulatorDetails() async {
+    final result = await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+      'getEmulatorDetails',
+    );
+    if (result == null) return <String, dynamic>{};
+    return result.map((key, value) => MapEntry(key.toString(), value));
+  }
+
   @override
   Future<bool> isDebuggerAttached() async {
     final result = await methodChannel.invokeMethod<bool>('isDebuggerAttached');
@@ -97,6 +110,21 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
     }
   }
 
+  @override
+  Future<List<Map<String, dynamic>>> listUsbDevices() async {
+    final result = await methodChannel.invokeMethod<List<dynamic>>(
+      'listUsbDevices',
+    );
+    if (result == null) return <Map<String, dynamic>>[];
+    return result
+        .whereType<Map>()
+        .map(
+          (device) =>
+              device.map((key, value) => MapEntry(key.toString(), value)),
+        )
+        .toList();
+  }
+
   /// Helper method to create default USB status
   Map<String, dynamic> _getDefaultUsbStatus(String error) {
     return <String, dynamic>{
@@ -134,6 +162,15 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
     return result ?? '';
   }
 
+  @override
+  Future<bool> refreshFingerprint({bool force = false}) async {
+    final result = await methodChannel.invokeMethod<bool>(
+      'refreshFingerprint',
+      {'force': force},
+    );
+    return result ?? false;
+  }
+
   @override
   Future<void> enableSecureFlag() async {
     await methodChannel.invokeMethod<void>('enableSecureFlag');
@@ -150,8 +187,12 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
   }
 
   @override
-  Future<void> preventReverseEngineering() async {
-    await methodChannel.invokeMethod<void>('preventReverseEngineering');
+  Future<void> preventReverseEngineering({
+    bool denyDebuggerAttach = false,
+  }) async {
+    await methodChannel.invokeMethod<void>('preventReverseEngineering', {
+      'denyDebuggerAttach': denyDebuggerAttach,
+    });
   }
 
   @override
@@ -192,6 +233,46 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
     return result?.cast<String>() ?? [];
   }
 
+  @override
+  Future<Map<String, dynamic>> getSecuritySnapshot() async {
+    final result = await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+      'getSecuritySnapshot',
+    );
+    if (result == null) return <String, dynamic>{};
+    return result.map((key, value) => MapEntry(key.toString(), value));
+  }
+
+  @override
+  Future<Map<String, dynamic>> getPerformanceStats() async {
+    final result = await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+      'getPerformanceStats',
+    );
+    if (result == null) return <String, dynamic>{};
+    return _stringKeyed(result);
+  }
+
+  /// Converts a platform map, including nested maps and maps in lists, to
+  /// String keys.
+  static Map<String, dynamic> _stringKeyed(Map<dynamic, dynamic> map) {
+    return map.map(
+      (key, value) => MapEntry(key.toString(), _stringKeyedValue(value)),
+    );
+  }
+
+  static dynamic _stringKeyedValue(dynamic value) {
+    if (value is Map) return _stringKeyed(value);
+    if (value is List) return value.map(_stringKeyedValue).toList();
+    return value;
+  }
+
+  @override
+  Stream<Map<String, dynamic>> securityEvents() {
+    return eventChannel.receiveBroadcastStream().map((event) {
+      if (event is! Map) return <String, dynamic>{};
+      return event.map((key, value) => MapEntry(key.toString(), value));
+    });
+  }
+
   @override
   Future<void> configureSSLPinning(
     List<String> certificates,
@@ -210,4 +291,125 @@ class MethodChannelUltraSecureFlutterKit extends UltraSecureFlutterKitPlatform {
     });
     return result ?? false;
   }
+
+  @override
+  Future<void> setLogLevel(String level) async {
+    await methodChannel.invokeMethod<void>('setLogLevel', {'level': level});
+  }
+
+  @override
+  Future<Map<String, dynamic>> getRunningAnalysisTools() async {
+    final result = await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+      'getRunningAnalysisTools',
+    );
+    if (result == null) return <String, dynamic>{};
+    return _stringKeyed(result);
+  }
+
+  @override
+  Future<Map<String, dynamic>> getNetworkInterfaces() async {
+    final result = await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+      'getNetworkInterfaces',
+    );
+    if (result == null) return <String, dynamic>{};
+    return _stringKeyed(result);
+  }
+
+  @override
+  Future<Uint8List> getSecuritySnapshotRecord() async {
+    final result = await methodChannel.invokeMethod<Uint8List>(
+      'getSecuritySnapshot',
+      {'format': 'binary'},
+    );
+    return result ?? Uint8List(0);
+  }
+
+  @override
+  Future<void> setProcessSignatures(List<String> signatures) async {
+    await methodChannel.invokeMethod<void>('setProcessSignatures', {
+      'signatures': signatures,
+    });
+  }
+
+  @override
+  Future<Uint8List> encrypt(Uint8List data) async {
+    final result = await methodChannel.invokeMethod<Uint8List>('encrypt', {
+      'data': data,
+    });
+    return result ?? Uint8List(0);
+  }
+
+  @override
+  Future<Uint8List> decrypt(Uint8List data) async {
+    final result = await methodChannel.invokeMethod<Uint8List>('decrypt', {
+      'data': data,
+    });
+    return result ?? Uint8List(0);
+  }
+
+  @override
+  Future<int> beginEncrypt() async {
+    return (await methodChannel.invokeMethod<int>('beginEncrypt'))!;
+  }
+
+  @override
+  Future<int> beginDecrypt() async {
+    return (await methodChannel.invokeMethod<int>('beginDecrypt'))!;
+  }
+
+  @override
+  Future<Uint8List> cipherUpdate(int handle, Uint8List data) async {
+    final result = await methodChannel.invokeMethod<Uint8List>(
+      'cipherUpdate',
+      {'handle': handle, 'data': data},
+    );
+    return result ?? Uint8List(0);
+  }
+
+  @override
+  Future<Uint8List> cipherFinish(int handle) async {
+    final result = await methodChannel.invokeMethod<Uint8List>(
+      'cipherFinish',
+      {'handle': handle},
+    );
+    return result ?? Uint8List(0);
+  }
+
+  @override
+  Future<void> secureStore(
+    String key,
+    String value, {
+    Duration? expiresIn,
+  }) async {
+    await methodChannel.invokeMethod<void>('secureStore', {
+      'key': key,
+      'value': value,
+      if (expiresIn != null) 'expiresInMillis': expiresIn.inMilliseconds,
+    });
+  }
+
+  @override
+  Future<String?> secureRetrieve(String key) {
+    return methodChannel.invokeMethod<String>('secureRetrieve', {'key': key});
+  }
+
+  @override
+  Future<void> secureDelete(String key) async {
+    await methodChannel.invokeMethod<bool>('secureDelete', {'key': key});
+  }
+
+  @override
+  Future<void> clearAllSecureData() async {
+    await methodChannel.invokeMethod<void>('clearAllSecureData');
+  }
+
+  @override
+  Future<Map<String, dynamic>> verifyAssets({bool wait = false}) async {
+    final result = await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+      'verifyAssets',
+      {'wait': wait},
+    );
+    if (result == null) return <String, dynamic>{};
+    return _stringKeyed(result);
+  }
 }
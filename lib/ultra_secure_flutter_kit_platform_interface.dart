@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
 import 'ultra_secure_flutter_kit_method_channel.dart';
@@ -41,6 +43,12 @@ abstract class UltraSecureFlutterKitPlatform extends PlatformInterface {
     throw UnimplementedError('isEmulator() has not been implemented.');
   }
 
+  /// Details of the emulator check: `isEmulator`, `confidence` (0.0-1.0),
+  /// `source` of the verdict and the matched `vendor`.
+  Future<Map<String, dynamic>> getEmulatorDetails() {
+    throw UnimplementedError('getEmulatorDetails() has not been implemented.');
+  }
+
   Future<bool> isDebuggerAttached() {
     throw UnimplementedError('isDebuggerAttached() has not been implemented.');
   }
@@ -75,6 +83,12 @@ abstract class UltraSecureFlutterKitPlatform extends PlatformInterface {
     );
   }
 
+  /// Attached USB devices (root hubs excluded) with their vendor/product
+  /// ids, device class and descriptor strings.
+  Future<List<Map<String, dynamic>>> listUsbDevices() {
+    throw UnimplementedError('listUsbDevices() has not been implemented.');
+  }
+
   Future<String> getAppSignature() {
     throw UnimplementedError('getAppSignature() has not been implemented.');
   }
@@ -89,6 +103,14 @@ abstract class UltraSecureFlutterKitPlatform extends PlatformInterface {
     );
   }
 
+  /// Re-validate the cached device fingerprint and app signature.
+  ///
+  /// Returns true when the fingerprint changed. With [force] the values are
+  /// recomputed even if none of their sources changed.
+  Future<bool> refreshFingerprint({bool force = false}) {
+    throw UnimplementedError('refreshFingerprint() has not been implemented.');
+  }
+
   Future<void> enableSecureFlag() {
     throw UnimplementedError('enableSecureFlag() has not been implemented.');
   }
@@ -105,7 +127,11 @@ abstract class UltraSecureFlutterKitPlatform extends PlatformInterface {
     );
   }
 
-  Future<void> preventReverseEngineering() {
+  /// Looks for analysis tools and, where supported, starts watching for
+  /// debuggers; attaches, detaches and stalls arrive on the security event
+  /// stream. [denyDebuggerAttach] also makes the process refuse ptrace
+  /// attach from non-root debuggers on Linux, which disables core dumps.
+  Future<void> preventReverseEngineering({bool denyDebuggerAttach = false}) {
     throw UnimplementedError(
       'preventReverseEngineering() has not been implemented.',
     );
@@ -141,6 +167,28 @@ abstract class UltraSecureFlutterKitPlatform extends PlatformInterface {
     );
   }
 
+  /// Run the device security checks natively in one call.
+  ///
+  /// The returned map is keyed by the method name of each standalone check
+  /// (e.g. `isRooted`, `hasVPNConnection`), plus `failedChecks`, `timestamp`
+  /// and `durationMicros`.
+  Future<Map<String, dynamic>> getSecuritySnapshot() {
+    throw UnimplementedError('getSecuritySnapshot() has not been implemented.');
+  }
+
+  /// Per-method native call statistics: for each method called so far,
+  /// its call and error counts and mean/p50/p90/p99/max latency in
+  /// microseconds, under 'methods'; worker pool counters under 'scheduler'.
+  Future<Map<String, dynamic>> getPerformanceStats() {
+    throw UnimplementedError('getPerformanceStats() has not been implemented.');
+  }
+
+  /// Stream of native security state changes (network links, addresses and
+  /// USB devices) pushed by the platform as they happen.
+  Stream<Map<String, dynamic>> securityEvents() {
+    throw UnimplementedError('securityEvents() has not been implemented.');
+  }
+
   Future<void> configureSSLPinning(
     List<String> certificates,
     List<String> publicKeys,
@@ -151,4 +199,115 @@ abstract class UltraSecureFlutterKitPlatform extends PlatformInterface {
   Future<bool> verifySSLPinning(String url) {
     throw UnimplementedError('verifySSLPinning() has not been implemented.');
   }
+
+  /// Sets the native log level: 'debug', 'info', 'warning', 'error' or
+  /// 'off'. Debug messages are only present in debug builds.
+  Future<void> setLogLevel(String level) {
+    throw UnimplementedError('setLogLevel() has not been implemented.');
+  }
+
+  /// Debuggers and instrumentation tools currently running: 'processes'
+  /// lists each match with its 'pid', 'name', 'exe' and the 'signature'
+  /// it matched, 'tracer' describes the process tracing the app (null if
+  /// none), and 'eventDriven' tells whether the list is kept current by
+  /// kernel notifications rather than rescans.
+  Future<Map<String, dynamic>> getRunningAnalysisTools() {
+    throw UnimplementedError(
+      'getRunningAnalysisTools() has not been implemented.',
+    );
+  }
+
+  /// Network interfaces classified by link kind: 'interfaces' lists each
+  /// one's 'index', 'name', 'kind', 'type' (loopback, ethernet, tunnel,
+  /// ppp, virtual or other), 'hardwareType', 'isUp' and 'isTunnel';
+  /// 'defaultRouteInterfaces', 'defaultRouteViaTunnel', 'hasVPN' and
+  /// 'vpnInterface' explain the hasVPNConnection() verdict.
+  Future<Map<String, dynamic>> getNetworkInterfaces() {
+    throw UnimplementedError('getNetworkInterfaces() has not been implemented.');
+  }
+
+  /// getSecuritySnapshot() as a fixed-layout binary record, plus the USB
+  /// connection status; read it with `SecuritySnapshotView`. Empty when the
+  /// platform has no binary snapshot.
+  Future<Uint8List> getSecuritySnapshotRecord() {
+    throw UnimplementedError(
+      'getSecuritySnapshotRecord() has not been implemented.',
+    );
+  }
+
+  /// Replaces the process names getRunningAnalysisTools() looks for; a
+  /// trailing '*' matches by prefix. An empty list restores the defaults.
+  Future<void> setProcessSignatures(List<String> signatures) {
+    throw UnimplementedError('setProcessSignatures() has not been implemented.');
+  }
+
+  /// Encrypts [data] with the native authenticated cipher (AES-256-GCM or
+  /// ChaCha20-Poly1305, whichever the CPU runs faster) under the app's
+  /// persistent data key. The result carries its own header and tags.
+  Future<Uint8List> encrypt(Uint8List data) {
+    throw UnimplementedError('encrypt() has not been implemented.');
+  }
+
+  /// Reverses [encrypt]; throws a PlatformException if [data] was altered
+  /// or truncated.
+  Future<Uint8List> decrypt(Uint8List data) {
+    throw UnimplementedError('decrypt() has not been implemented.');
+  }
+
+  /// Opens a native encryption stream and returns its handle. Feed it with
+  /// [cipherUpdate] and close it with [cipherFinish]; the concatenated
+  /// outputs equal what [encrypt] returns for the concatenated inputs.
+  Future<int> beginEncrypt() {
+    throw UnimplementedError('beginEncrypt() has not been implemented.');
+  }
+
+  /// Opens a native decryption stream for the output of [encrypt] or an
+  /// encryption stream. Only authenticated plaintext is returned.
+  Future<int> beginDecrypt() {
+    throw UnimplementedError('beginDecrypt() has not been implemented.');
+  }
+
+  /// Passes the next chunk of a stream and returns the output it
+  /// completed, possibly empty. Calls on one handle must not overlap.
+  Future<Uint8List> cipherUpdate(int handle, Uint8List data) {
+    throw UnimplementedError('cipherUpdate() has not been implemented.');
+  }
+
+  /// Returns the rest of a stream's output and closes it, also when it
+  /// throws.
+  Future<Uint8List> cipherFinish(int handle) {
+    throw UnimplementedError('cipherFinish() has not been implemented.');
+  }
+
+  /// Stores [value] under [key] in the platform's persistent encrypted
+  /// store, replacing any earlier value. With [expiresIn], the value reads
+  /// as absent once that much time has passed.
+  Future<void> secureStore(String key, String value, {Duration? expiresIn}) {
+    throw UnimplementedError('secureStore() has not been implemented.');
+  }
+
+  /// The value stored under [key], or null if there is none or it expired.
+  Future<String?> secureRetrieve(String key) {
+    throw UnimplementedError('secureRetrieve() has not been implemented.');
+  }
+
+  /// Removes [key] from the persistent store.
+  Future<void> secureDelete(String key) {
+    throw UnimplementedError('secureDelete() has not been implemented.');
+  }
+
+  /// Removes every key from the persistent store.
+  Future<void> clearAllSecureData() {
+    throw UnimplementedError('clearAllSecureData() has not been implemented.');
+  }
+
+  /// Progress of checking the bundled assets against the signed manifest
+  /// generated at build time: 'manifestFound', 'signatureValid',
+  /// 'complete', 'verified', 'filesTotal', 'filesVerified', 'mismatched'
+  /// and 'missing' (relative paths), 'filesHashed' and 'bytesHashed'.
+  /// Files are hashed in the background; with [wait] the reply comes once
+  /// every file has been checked.
+  Future<Map<String, dynamic>> verifyAssets({bool wait = false}) {
+    throw UnimplementedError('verifyAssets() has not been implemented.');
+  }
 }
@@ -123,7 +123,9 @@ class UltraSecureFlutterKitWeb extends UltraSecureFlutterKitPlatform {
   }
 
   @override
-  Future<void> preventReverseEngineering() async {
+  Future<void> preventReverseEngineering({
+    bool denyDebuggerAttach = false,
+  }) async {
     // Prevent reverse engineering in web environment
     _preventWebReverseEngineering();
   }
@@ -0,0 +1,502 @@
+#include "aead_cipher.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#elif defined(__aarch64__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <openssl/rand.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr uint8_t kFormatVersion = 1;
+constexpr size_t kSaltSize = 16;
+constexpr size_t kNoncePrefixSize = 7;
+constexpr size_t kNonceSize = 12;
+constexpr size_t kSaltOffset = 3;
+constexpr size_t kNoncePrefixOffset = kSaltOffset + kSaltSize;
+static_assert(kNoncePrefixOffset + kNoncePrefixSize == kAeadHeaderSize);
+static_assert(kSaltSize == RecordCipher::kSaltSize);
+static_assert(kNonceSize + kAeadTagSize == RecordCipher::kOverhead);
+
+// Segment sizes a header may declare: 1 KiB to 16 MiB.
+constexpr unsigned kMinSegmentLog2 = 10;
+constexpr unsigned kMaxSegmentLog2 = 24;
+
+constexpr char kStreamKeyInfo[] = "ultra_secure_flutter_kit aead v1";
+constexpr char kRecordKeyInfo[] = "ultra_secure_flutter_kit store v1";
+
+const EVP_CIPHER* CipherFor(AeadAlgorithm algorithm) {
+  switch (algorithm) {
+    case AeadAlgorithm::kAes256Gcm:
+      return EVP_aes_256_gcm();
+    case AeadAlgorithm::kChaCha20Poly1305:
+      return EVP_chacha20_poly1305();
+  }
+  return nullptr;
+}
+
+unsigned Log2(size_t value) {
+  unsigned bits = 0;
+  while ((size_t{1} << (bits + 1)) <= value) {
+    ++bits;
+  }
+  return bits;
+}
+
+// HKDF-SHA256(root, salt, info || algorithm) into `key`.
+template <size_t kInfoSize>
+void DeriveKey(const SecureVector<uint8_t>& root_key, const uint8_t* salt,
+               const char (&info_text)[kInfoSize], AeadAlgorithm algorithm,
+               uint8_t* key) {
+  uint8_t info[kInfoSize];
+  memcpy(info, info_text, kInfoSize - 1);
+  info[kInfoSize - 1] = static_cast<uint8_t>(algorithm);
+
+  EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_HKDF, nullptr);
+  size_t length = 32;
+  const bool derived =
+      context != nullptr && EVP_PKEY_derive_init(context) > 0 &&
+      EVP_PKEY_CTX_set_hkdf_md(context, EVP_sha256()) > 0 &&
+      EVP_PKEY_CTX_set1_hkdf_salt(context, salt,
+                                  static_cast<int>(kSaltSize)) > 0 &&
+      EVP_PKEY_CTX_set1_hkdf_key(context, root_key.data(),
+                                 static_cast<int>(root_key.size())) > 0 &&
+      EVP_PKEY_CTX_add1_hkdf_info(context, info,
+                                  static_cast<int>(sizeof(info))) > 0 &&
+      EVP_PKEY_derive(context, key, &length) > 0 && length == 32;
+  EVP_PKEY_CTX_free(context);
+  if (!derived) {
+    throw std::runtime_error("key derivation failed");
+  }
+}
+
+// A cipher context keyed once with `key`, for encryption or decryption.
+// Throws std::runtime_error on failure.
+EVP_CIPHER_CTX* NewKeyedContext(AeadAlgorithm algorithm, const uint8_t* key,
+                                bool encrypt) {
+  const EVP_CIPHER* cipher = CipherFor(algorithm);
+  if (cipher == nullptr) {
+    throw std::runtime_error("unsupported cipher");
+  }
+  EVP_CIPHER_CTX* context = EVP_CIPHER_CTX_new();
+  if (context == nullptr ||
+      EVP_CipherInit_ex(context, cipher, nullptr, key, nullptr,
+                        encrypt ? 1 : 0) != 1) {
+    EVP_CIPHER_CTX_free(context);
+    throw std::runtime_error("cipher initialisation failed");
+  }
+  return context;
+}
+
+}  // namespace
+
+// Seals or opens the segments of one message, reusing one cipher context
+// keyed once; each segment only sets a new nonce.
+class SegmentCipher {
+ public:
+  SegmentCipher(const SecureVector<uint8_t>& root_key, const uint8_t* header,
+                bool encrypt) {
+    memcpy(header_, header, kAeadHeaderSize);
+    const auto algorithm = static_cast<AeadAlgorithm>(header[1]);
+    uint8_t key[32];
+    DeriveKey(root_key, header + kSaltOffset, kStreamKeyInfo, algorithm, key);
+    try {
+      context_ = NewKeyedContext(algorithm, key, encrypt);
+    } catch (...) {
+      SecureZero(key, sizeof(key));
+      throw;
+    }
+    SecureZero(key, sizeof(key));
+  }
+
+  ~SegmentCipher() { EVP_CIPHER_CTX_free(context_); }
+
+  SegmentCipher(const SegmentCipher&) = delete;
+  SegmentCipher& operator=(const SegmentCipher&) = delete;
+
+  void Seal(const uint8_t* data, size_t size, bool last,
+            std::vector<uint8_t>* out) {
+    StartSegment(last);
+    const size_t start = out->size();
+    out->resize(start + size + kAeadTagSize);
+    uint8_t* target = out->data() + start;
+    int length = 0;
+    if (EVP_EncryptUpdate(context_, target, &length, data,
+                          static_cast<int>(size)) != 1 ||
+        EVP_EncryptFinal_ex(context_, target + length, &length) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context_, EVP_CTRL_AEAD_GET_TAG, kAeadTagSize,
+                            target + size) != 1) {
+      out->resize(start);
+      throw std::runtime_error("encryption failed");
+    }
+  }
+
+  void Open(const uint8_t* data, size_t size, bool last,
+            std::vector<uint8_t>* out) {
+    if (size < kAeadTagSize) {
+      throw std::runtime_error("truncated segment");
+    }
+    StartSegment(last);
+    const size_t text_size = size - kAeadTagSize;
+    const size_t start = out->size();
+    out->resize(start + text_size);
+    uint8_t* target = out->data() + start;
+    int length = 0;
+    // Nothing reaches the caller until the tag has been checked.
+    if (EVP_DecryptUpdate(context_, target, &length, data,
+                          static_cast<int>(text_size)) != 1 ||
+        EVP_CIPHER_CTX_ctrl(context_, EVP_CTRL_AEAD_SET_TAG, kAeadTagSize,
+                            const_cast<uint8_t*>(data + text_size)) != 1 ||
+        EVP_DecryptFinal_ex(context_, target + length, &length) != 1) {
+      SecureZero(target, text_size);
+      out->resize(start);
+      throw std::runtime_error("message failed authentication");
+    }
+  }
+
+ private:
+  void StartSegment(bool last) {
+    if (finished_) {
+      throw std::runtime_error("data after the last segment");
+    }
+    if (counter_ == std::numeric_limits<uint32_t>::max()) {
+      throw std::runtime_error("message too long");
+    }
+    uint8_t nonce[kNonceSize];
+    memcpy(nonce, header_ + kNoncePrefixOffset, kNoncePrefixSize);
+    nonce[7] = static_cast<uint8_t>(counter_ >> 24);
+    nonce[8] = static_cast<uint8_t>(counter_ >> 16);
+    nonce[9] = static_cast<uint8_t>(counter_ >> 8);
+    nonce[10] = static_cast<uint8_t>(counter_);
+    nonce[11] = last ? 1 : 0;
+    ++counter_;
+    finished_ = last;
+
+    int length = 0;
+    if (EVP_CipherInit_ex(context_, nullptr, nullptr, nullptr, nonce, -1) !=
+            1 ||
+        EVP_CipherUpdate(context_, nullptr, &length, header_,
+                         static_cast<int>(kAeadHeaderSize)) != 1) {
+      throw std::runtime_error("cipher initialisation failed");
+    }
+  }
+
+  EVP_CIPHER_CTX* context_ = nullptr;
+  uint8_t header_[kAeadHeaderSize];
+  uint32_t counter_ = 0;
+  bool finished_ = false;
+};
+
+const char* AeadAlgorithmName(AeadAlgorithm algorithm) {
+  switch (algorithm) {
+    case AeadAlgorithm::kAes256Gcm:
+      return "AES-256-GCM";
+    case AeadAlgorithm::kChaCha20Poly1305:
+      return "ChaCha20-Poly1305";
+  }
+  return "unknown";
+}
+
+AeadAlgorithm PreferredAeadAlgorithm() {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax, ebx, ecx, edx;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES) != 0 &&
+      (ecx & bit_PCLMUL) != 0) {
+    return AeadAlgorithm::kAes256Gcm;
+  }
+#elif defined(__aarch64__)
+  const unsigned long capabilities = getauxval(AT_HWCAP);
+  if ((capabilities & HWCAP_AES) != 0 && (capabilities & HWCAP_PMULL) != 0) {
+    return AeadAlgorithm::kAes256Gcm;
+  }
+#endif
+  return AeadAlgorithm::kChaCha20Poly1305;
+}
+
+size_t EncryptedMessageSize(size_t plaintext_size) {
+  const size_t segments =
+      std::max<size_t>(1, (plaintext_size + kAeadSegmentSize - 1) /
+                              kAeadSegmentSize);
+  return kAeadHeaderSize + plaintext_size + segments * kAeadTagSize;
+}
+
+StreamEncryptor::StreamEncryptor(const SecureVector<uint8_t>& root_key,
+                                 AeadAlgorithm algorithm, size_t segment_size)
+    : segment_size_(size_t{1} << std::clamp(Log2(segment_size),
+                                            kMinSegmentLog2,
+                                            kMaxSegmentLog2)) {
+  header_[0] = kFormatVersion;
+  header_[1] = static_cast<uint8_t>(algorithm);
+  header_[2] = static_cast<uint8_t>(Log2(segment_size_));
+  if (RAND_bytes(header_ + kSaltOffset,
+                 static_cast<int>(kSaltSize + kNoncePrefixSize)) != 1) {
+    throw std::runtime_error("random number generator failed");
+  }
+  cipher_ = std::make_unique<SegmentCipher>(root_key, header_, true);
+  pending_.reserve(segment_size_);
+}
+
+StreamEncryptor::~StreamEncryptor() = default;
+
+void StreamEncryptor::Update(const uint8_t* data, size_t size,
+                             std::vector<uint8_t>* out) {
+  if (!header_written_) {
+    out->insert(out->end(), header_, header_ + kAeadHeaderSize);
+    header_written_ = true;
+  }
+  // A full segment is only sealed once more data follows it, since the
+  // last segment is sealed differently. Whole segments of the input are
+  // sealed in place rather than copied through `pending_`.
+  while (size > 0) {
+    if (pending_.empty() && size > segment_size_) {
+      cipher_->Seal(data, segment_size_, false, out);
+      data += segment_size_;
+      size -= segment_size_;
+      continue;
+    }
+    if (pending_.size() == segment_size_) {
+      cipher_->Seal(pending_.data(), segment_size_, false, out);
+      pending_.clear();
+      continue;
+    }
+    const size_t take = std::min(segment_size_ - pending_.size(), size);
+    pending_.insert(pending_.end(), data, data + take);
+    data += take;
+    size -= take;
+  }
+}
+
+void StreamEncryptor::Finish(std::vector<uint8_t>* out) {
+  Update(nullptr, 0, out);
+  cipher_->Seal(pending_.data(), pending_.size(), true, out);
+  pending_.clear();
+}
+
+StreamDecryptor::StreamDecryptor(const SecureVector<uint8_t>& root_key)
+    : root_key_(root_key) {}
+
+StreamDecryptor::~StreamDecryptor() = default;
+
+void StreamDecryptor::ReadHeader() {
+  if (header_[0] != kFormatVersion) {
+    throw std::runtime_error("unsupported message version");
+  }
+  if (CipherFor(static_cast<AeadAlgorithm>(header_[1])) == nullptr) {
+    throw std::runtime_error("unsupported cipher");
+  }
+  if (header_[2] < kMinSegmentLog2 || header_[2] > kMaxSegmentLog2) {
+    throw std::runtime_error("unsupported segment size");
+  }
+  segment_size_ = size_t{1} << header_[2];
+  cipher_ = std::make_unique<SegmentCipher>(root_key_, header_.data(), false);
+  pending_.reserve(segment_size_ + kAeadTagSize);
+}
+
+void StreamDecryptor::Update(const uint8_t* data, size_t size,
+                             std::vector<uint8_t>* out) {
+  if (cipher_ == nullptr) {
+    const size_t take = std::min(kAeadHeaderSize - header_.size(), size);
+    header_.insert(header_.end(), data, data + take);
+    data += take;
+    size -= take;
+    if (header_.size() < kAeadHeaderSize) {
+      return;
+    }
+    ReadHeader();
+  }
+
+  const size_t sealed_size = segment_size_ + kAeadTagSize;
+  while (size > 0) {
+    if (pending_.empty() && size > sealed_size) {
+      cipher_->Open(data, sealed_size, false, out);
+      data += sealed_size;
+      size -= sealed_size;
+      continue;
+    }
+    if (pending_.size() == sealed_size) {
+      cipher_->Open(pending_.data(), sealed_size, false, out);
+      pending_.clear();
+      continue;
+    }
+    const size_t take = std::min(sealed_size - pending_.size(), size);
+    pending_.insert(pending_.end(), data, data + take);
+    data += take;
+    size -= take;
+  }
+}
+
+void StreamDecryptor::Finish(std::vector<uint8_t>* out) {
+  if (cipher_ == nullptr) {
+    throw std::runtime_error("truncated message");
+  }
+  cipher_->Open(pending_.data(), pending_.size(), true, out);
+  pending_.clear();
+}
+
+std::vector<uint8_t> EncryptMessage(const SecureVector<uint8_t>& root_key,
+                                    const uint8_t* data, size_t size) {
+  std::vector<uint8_t> out;
+  out.reserve(EncryptedMessageSize(size));
+  StreamEncryptor encryptor(root_key);
+  encryptor.Update(data, size, &out);
+  encryptor.Finish(&out);
+  return out;
+}
+
+std::vector<uint8_t> DecryptMessage(const SecureVector<uint8_t>& root_key,
+                                    const uint8_t* data, size_t size) {
+  std::vector<uint8_t> out;
+  out.reserve(size);
+  StreamDecryptor decryptor(root_key);
+  decryptor.Update(data, size, &out);
+  decryptor.Finish(&out);
+  return out;
+}
+
+RecordCipher::RecordCipher(const SecureVector<uint8_t>& root_key,
+                           const uint8_t* salt, AeadAlgorithm algorithm) {
+  uint8_t key[32];
+  DeriveKey(root_key, salt, kRecordKeyInfo, algorithm, key);
+  try {
+    encrypt_context_ = NewKeyedContext(algorithm, key, true);
+    decrypt_context_ = NewKeyedContext(algorithm, key, false);
+  } catch (...) {
+    SecureZero(key, sizeof(key));
+    EVP_CIPHER_CTX_free(encrypt_context_);
+    throw;
+  }
+  SecureZero(key, sizeof(key));
+}
+
+RecordCipher::~RecordCipher() {
+  EVP_CIPHER_CTX_free(encrypt_context_);
+  EVP_CIPHER_CTX_free(decrypt_context_);
+}
+
+void RecordCipher::Seal(const uint8_t* data, size_t size, const uint8_t* aad,
+                        size_t aad_size, uint8_t* out) {
+  EVP_CIPHER_CTX* context = encrypt_context_;
+  uint8_t* text = out + kNonceSize;
+  int length = 0;
+  if (RAND_bytes(out, static_cast<int>(kNonceSize)) != 1 ||
+      EVP_EncryptInit_ex(context, nullptr, nullptr, nullptr, out) != 1 ||
+      EVP_EncryptUpdate(context, nullptr, &length, aad,
+                        static_cast<int>(aad_size)) != 1 ||
+      EVP_EncryptUpdate(context, text, &length, data,
+                        static_cast<int>(size)) != 1 ||
+      EVP_EncryptFinal_ex(context, text + length, &length) != 1 ||
+      EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_AEAD_GET_TAG, kAeadTagSize,
+                          text + size) != 1) {
+    throw std::runtime_error("encryption failed");
+  }
+}
+
+bool RecordCipher::Open(const uint8_t* record, size_t size, const uint8_t* aad,
+                        size_t aad_size, uint8_t* out) {
+  if (size < kOverhead) {
+    return false;
+  }
+  EVP_CIPHER_CTX* context = decrypt_context_;
+  const size_t text_size = size - kOverhead;
+  const uint8_t* text = record + kNonceSize;
+  int length = 0;
+  if (EVP_DecryptInit_ex(context, nullptr, nullptr, nullptr, record) != 1 ||
+      EVP_DecryptUpdate(context, nullptr, &length, aad,
+                        static_cast<int>(aad_size)) != 1 ||
+      EVP_DecryptUpdate(context, out, &length, text,
+                        static_cast<int>(text_size)) != 1 ||
+      EVP_CIPHER_CTX_ctrl(context, EVP_CTRL_AEAD_SET_TAG, kAeadTagSize,
+                          const_cast<uint8_t*>(text + text_size)) != 1 ||
+      EVP_DecryptFinal_ex(context, out + length, &length) != 1) {
+    SecureZero(out, text_size);
+    return false;
+  }
+  return true;
+}
+
+CipherStreamTable::CipherStreamTable(KeySource root_key)
+    : root_key_(root_key) {}
+
+int64_t CipherStreamTable::Begin(bool encrypt) {
+  auto stream = std::make_shared<Stream>();
+  const SecureVector<uint8_t>& key = root_key_();
+  if (encrypt) {
+    stream->encryptor = std::make_unique<StreamEncryptor>(key);
+  } else {
+    stream->decryptor = std::make_unique<StreamDecryptor>(key);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (streams_.size() >= kMaxOpenStreams) {
+    throw std::runtime_error("too many open cipher streams");
+  }
+  const int64_t handle = next_handle_++;
+  streams_.emplace(handle, std::move(stream));
+  return handle;
+}
+
+std::shared_ptr<CipherStreamTable::Stream> CipherStreamTable::Find(
+    int64_t handle) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = streams_.find(handle);
+  if (it == streams_.end()) {
+    throw std::runtime_error("unknown cipher stream");
+  }
+  return it->second;
+}
+
+std::vector<uint8_t> CipherStreamTable::Update(int64_t handle,
+                                               const uint8_t* data,
+                                               size_t size) {
+  const auto stream = Find(handle);
+  std::lock_guard<std::mutex> lock(stream->mutex);
+  std::vector<uint8_t> out;
+  if (stream->encryptor) {
+    out.reserve(EncryptedMessageSize(size));
+    stream->encryptor->Update(data, size, &out);
+  } else {
+    out.reserve(size);
+    stream->decryptor->Update(data, size, &out);
+  }
+  return out;
+}
+
+std::vector<uint8_t> CipherStreamTable::Finish(int64_t handle) {
+  std::shared_ptr<Stream> stream;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = streams_.find(handle);
+    if (it == streams_.end()) {
+      throw std::runtime_error("unknown cipher stream");
+    }
+    stream = std::move(it->second);
+    streams_.erase(it);
+  }
+  std::lock_guard<std::mutex> lock(stream->mutex);
+  std::vector<uint8_t> out;
+  if (stream->encryptor) {
+    stream->encryptor->Finish(&out);
+  } else {
+    stream->decryptor->Finish(&out);
+  }
+  return out;
+}
+
+size_t CipherStreamTable::OpenStreams() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return streams_.size();
+}
+
+}  // namespace ultra_secure_flutter_kit
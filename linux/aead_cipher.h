@@ -0,0 +1,182 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_AEAD_CIPHER_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_AEAD_CIPHER_H_
+
+// Authenticated encryption for encryptSensitiveData and the streaming
+// cipher methods.
+//
+// Messages use a segmented format, so a stream can be decrypted without
+// buffering it whole and without releasing unauthenticated plaintext:
+//
+//   header:  version (1) | algorithm (1) | log2 segment size (1) |
+//            salt (16) | nonce prefix (7)
+//   segments: ciphertext | tag (16), every segment but the last holding
+//            exactly one segment of plaintext
+//
+// Each message gets its own key, HKDF-SHA256(DataKey(), salt), and
+// segment i is sealed under the nonce prefix | i (32-bit big-endian) |
+// last-segment flag with the header as associated data. Dropping,
+// reordering or truncating segments therefore fails authentication, as
+// does changing the header. A one-shot message is a stream that was
+// written in one call.
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "secure_memory.h"
+
+// OpenSSL's EVP_CIPHER_CTX, without pulling its headers in here.
+struct evp_cipher_ctx_st;
+
+namespace ultra_secure_flutter_kit {
+
+enum class AeadAlgorithm : uint8_t {
+  kAes256Gcm = 1,
+  kChaCha20Poly1305 = 2,
+};
+
+const char* AeadAlgorithmName(AeadAlgorithm algorithm);
+
+// AES-256-GCM where the CPU has AES and carry-less multiply instructions
+// (AES-NI and PCLMULQDQ, or the ARMv8 crypto extensions), where it runs
+// at several GB/s; ChaCha20-Poly1305 elsewhere, where it is the faster of
+// the two and has no table-lookup timing leaks. Either decrypts anywhere.
+AeadAlgorithm PreferredAeadAlgorithm();
+
+constexpr size_t kAeadHeaderSize = 26;
+constexpr size_t kAeadTagSize = 16;
+constexpr size_t kAeadSegmentSize = 64 * 1024;
+
+// Size of the message EncryptMessage() produces for `plaintext_size`
+// bytes.
+size_t EncryptedMessageSize(size_t plaintext_size);
+
+class SegmentCipher;
+
+class StreamEncryptor {
+ public:
+  // Throws std::runtime_error if OpenSSL cannot set up the cipher.
+  StreamEncryptor(const SecureVector<uint8_t>& root_key,
+                  AeadAlgorithm algorithm = PreferredAeadAlgorithm(),
+                  size_t segment_size = kAeadSegmentSize);
+  ~StreamEncryptor();
+
+  // Appends the header and every segment that is known not to be the
+  // last one. Plaintext that does not fill a segment is held in
+  // SecureArena memory until the next call.
+  void Update(const uint8_t* data, size_t size, std::vector<uint8_t>* out);
+  // Appends the last segment.
+  void Finish(std::vector<uint8_t>* out);
+
+ private:
+  uint8_t header_[kAeadHeaderSize];
+  bool header_written_ = false;
+  const size_t segment_size_;
+  SecureVector<uint8_t> pending_;
+  std::unique_ptr<SegmentCipher> cipher_;
+};
+
+class StreamDecryptor {
+ public:
+  explicit StreamDecryptor(const SecureVector<uint8_t>& root_key);
+  ~StreamDecryptor();
+
+  // Appends the plaintext of every complete segment that is known not to
+  // be the last one. Throws std::runtime_error on a malformed header or a
+  // segment that does not authenticate.
+  void Update(const uint8_t* data, size_t size, std::vector<uint8_t>* out);
+  // Appends the last segment's plaintext. Throws if the message was
+  // truncated.
+  void Finish(std::vector<uint8_t>* out);
+
+ private:
+  void ReadHeader();
+
+  const SecureVector<uint8_t>& root_key_;
+  std::vector<uint8_t> header_;
+  size_t segment_size_ = 0;
+  std::vector<uint8_t> pending_;
+  std::unique_ptr<SegmentCipher> cipher_;
+};
+
+// One-shot forms of the above. DecryptMessage() throws std::runtime_error
+// if the message does not authenticate.
+std::vector<uint8_t> EncryptMessage(const SecureVector<uint8_t>& root_key,
+                                    const uint8_t* data, size_t size);
+std::vector<uint8_t> DecryptMessage(const SecureVector<uint8_t>& root_key,
+                                    const uint8_t* data, size_t size);
+
+// Seals small independent records under one key, for the secure store's
+// log. A record is nonce (12) | ciphertext | tag (16). The key is derived
+// once per log, HKDF-SHA256(root, salt), and nonces are random, so no
+// record costs a key derivation; 2^32 records per salt stay well inside
+// the random-nonce bound. Not thread-safe.
+class RecordCipher {
+ public:
+  static constexpr size_t kSaltSize = 16;
+  static constexpr size_t kOverhead = 12 + kAeadTagSize;
+
+  // Throws std::runtime_error if OpenSSL cannot set up the cipher.
+  RecordCipher(const SecureVector<uint8_t>& root_key, const uint8_t* salt,
+               AeadAlgorithm algorithm);
+  ~RecordCipher();
+
+  RecordCipher(const RecordCipher&) = delete;
+  RecordCipher& operator=(const RecordCipher&) = delete;
+
+  // Writes size + kOverhead bytes to `out`, authenticating `aad` as well.
+  void Seal(const uint8_t* data, size_t size, const uint8_t* aad,
+            size_t aad_size, uint8_t* out);
+  // Writes size - kOverhead bytes of plaintext to `out`. Returns false,
+  // with `out` zeroed, if the record does not authenticate.
+  bool Open(const uint8_t* record, size_t size, const uint8_t* aad,
+            size_t aad_size, uint8_t* out);
+
+ private:
+  evp_cipher_ctx_st* encrypt_context_ = nullptr;
+  evp_cipher_ctx_st* decrypt_context_ = nullptr;
+};
+
+// Open streams of the beginEncrypt/beginDecrypt channel methods, by
+// handle. Calls on different handles run in parallel; calls on one handle
+// must come in order, which the Dart side guarantees by awaiting each.
+class CipherStreamTable {
+ public:
+  static constexpr size_t kMaxOpenStreams = 64;
+
+  // Where streams get their root key; called on the first Begin().
+  using KeySource = const SecureVector<uint8_t>& (*)();
+
+  explicit CipherStreamTable(KeySource root_key);
+
+  // Throws std::runtime_error when kMaxOpenStreams are already open.
+  int64_t Begin(bool encrypt);
+  // Throw std::runtime_error for an unknown handle, or what the stream
+  // throws. Finish() closes the stream even when it throws.
+  std::vector<uint8_t> Update(int64_t handle, const uint8_t* data,
+                              size_t size);
+  std::vector<uint8_t> Finish(int64_t handle);
+
+  size_t OpenStreams() const;
+
+ private:
+  struct Stream {
+    std::mutex mutex;
+    std::unique_ptr<StreamEncryptor> encryptor;
+    std::unique_ptr<StreamDecryptor> decryptor;
+  };
+
+  std::shared_ptr<Stream> Find(int64_t handle) const;
+
+  const KeySource root_key_;
+  mutable std::mutex mutex_;
+  std::map<int64_t, std::shared_ptr<Stream>> streams_;
+  int64_t next_handle_ = 1;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_AEAD_CIPHER_H_
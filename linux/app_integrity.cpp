@@ -0,0 +1,421 @@
+#include "app_integrity.h"
+
+#include <fcntl.h>
+#include <openssl/evp.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "asset_integrity.h"
+#include "parallel_for.h"
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr uint8_t kLeafPrefix = 0x00;
+constexpr uint8_t kNodePrefix = 0x01;
+
+// A file modified within this window of being hashed could change again
+// without its mtime moving (timestamps are only as fine as the kernel
+// tick), so it is not cached.
+constexpr int64_t kRacyWindowNs = 2000000000;
+
+Digest HashParts(uint8_t prefix, const void* first, size_t first_size,
+                 const void* second, size_t second_size) {
+  Digest digest{};
+  EVP_MD_CTX* context = EVP_MD_CTX_new();
+  EVP_DigestInit_ex(context, EVP_sha256(), nullptr);
+  EVP_DigestUpdate(context, &prefix, 1);
+  EVP_DigestUpdate(context, first, first_size);
+  if (second_size > 0) {
+    EVP_DigestUpdate(context, second, second_size);
+  }
+  EVP_DigestFinal_ex(context, digest.data(), nullptr);
+  EVP_MD_CTX_free(context);
+  return digest;
+}
+
+int HexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+int64_t MtimeNanos(const struct stat& info) {
+  return static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+         info.st_mtim.tv_nsec;
+}
+
+std::string ExecutablePath() {
+  char buffer[4096];
+  const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+  if (length <= 0) {
+    return std::string();
+  }
+  return std::string(buffer, static_cast<size_t>(length));
+}
+
+std::string DirectoryOf(const std::string& path) {
+  const size_t slash = path.rfind('/');
+  return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+}
+
+std::string BaseName(const std::string& path) {
+  const size_t slash = path.rfind('/');
+  return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+// Finds the on-disk path of a bundle file: the executable itself, a
+// library that is currently mapped, or the bundle's lib/ directory.
+std::string ResolveBundleFile(const std::string& name,
+                              const std::string& executable) {
+  if (name == BaseName(executable)) {
+    return executable;
+  }
+
+  std::string mapped;
+  const std::string suffix = "/" + name;
+  ScanLines("/proc/self/maps", [&](std::string_view line) {
+    const size_t path_start = line.find('/');
+    if (path_start == std::string_view::npos) {
+      return true;
+    }
+    const std::string_view path = line.substr(path_start);
+    if (path.size() >= suffix.size() &&
+        path.substr(path.size() - suffix.size()) == suffix) {
+      mapped.assign(path.data(), path.size());
+      return false;
+    }
+    return true;
+  });
+  if (!mapped.empty()) {
+    return mapped;
+  }
+  return DirectoryOf(executable) + "/lib/" + name;
+}
+
+}  // namespace
+
+Digest MerkleRoot(const std::vector<Digest>& leaves) {
+  if (leaves.empty()) {
+    return HashParts(kLeafPrefix, "", 0, nullptr, 0);
+  }
+  std::vector<Digest> level = leaves;
+  while (level.size() > 1) {
+    std::vector<Digest> parent;
+    parent.reserve((level.size() + 1) / 2);
+    for (size_t i = 0; i < level.size(); i += 2) {
+      if (i + 1 < level.size()) {
+        parent.push_back(HashParts(kNodePrefix, level[i].data(), 32,
+                                   level[i + 1].data(), 32));
+      } else {
+        parent.push_back(level[i]);
+      }
+    }
+    level.swap(parent);
+  }
+  return level.front();
+}
+
+HashOutcome HashFileMerkle(const std::string& path,
+                           const MerkleDigest* expected, MerkleDigest* out,
+                           size_t workers, uint64_t* bytes_hashed) {
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return HashOutcome::kUnreadable;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    return HashOutcome::kUnreadable;
+  }
+
+  const uint64_t size = static_cast<uint64_t>(info.st_size);
+  if (expected != nullptr && expected->size != size) {
+    close(fd);
+    return HashOutcome::kMismatch;
+  }
+
+  const size_t chunk_count =
+      size == 0 ? 0 : (size + kIntegrityChunkSize - 1) / kIntegrityChunkSize;
+  if (expected != nullptr && expected->leaves.size() != chunk_count) {
+    close(fd);
+    return HashOutcome::kMismatch;
+  }
+
+  const uint8_t* data = nullptr;
+  if (size > 0) {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      return HashOutcome::kUnreadable;
+    }
+    madvise(mapping, size, MADV_WILLNEED);
+    data = static_cast<const uint8_t*>(mapping);
+  }
+  close(fd);
+
+  out->size = size;
+  out->leaves.assign(chunk_count, Digest{});
+  std::atomic<bool> mismatch{false};
+  std::atomic<uint64_t> hashed{0};
+
+  const size_t worker_count = workers == 0 ? HardwareWorkers() : workers;
+  ParallelFor(chunk_count, worker_count, [&](size_t i) {
+    const size_t offset = i * kIntegrityChunkSize;
+    const size_t length =
+        std::min<uint64_t>(kIntegrityChunkSize, size - offset);
+    out->leaves[i] = HashParts(kLeafPrefix, data + offset, length, nullptr, 0);
+    hashed.fetch_add(length, std::memory_order_relaxed);
+    if (expected != nullptr && out->leaves[i] != expected->leaves[i]) {
+      mismatch.store(true);
+      return false;
+    }
+    return true;
+  });
+
+  if (data != nullptr) {
+    munmap(const_cast<uint8_t*>(data), size);
+  }
+  if (bytes_hashed != nullptr) {
+    *bytes_hashed += hashed.load();
+  }
+  if (mismatch.load()) {
+    return HashOutcome::kMismatch;
+  }
+
+  out->root = MerkleRoot(out->leaves);
+  if (expected != nullptr && out->root != expected->root) {
+    return HashOutcome::kMismatch;
+  }
+  return HashOutcome::kOk;
+}
+
+std::string DigestToHex(const Digest& digest) {
+  std::string hex;
+  hex.reserve(digest.size() * 2);
+  for (const uint8_t byte : digest) {
+    hex += "0123456789abcdef"[byte / 16];
+    hex += "0123456789abcdef"[byte % 16];
+  }
+  return hex;
+}
+
+bool DigestFromHex(std::string_view hex, Digest* digest) {
+  if (hex.size() != digest->size() * 2) {
+    return false;
+  }
+  for (size_t i = 0; i < digest->size(); ++i) {
+    const int high = HexNibble(hex[i * 2]);
+    const int low = HexNibble(hex[i * 2 + 1]);
+    if (high < 0 || low < 0) {
+      return false;
+    }
+    (*digest)[i] = static_cast<uint8_t>(high * 16 + low);
+  }
+  return true;
+}
+
+std::string FormatIntegrityManifest(const std::vector<ManifestEntry>& entries) {
+  std::string text;
+  for (const auto& entry : entries) {
+    for (const char c : entry.name) {
+      const auto byte = static_cast<uint8_t>(c);
+      if (byte <= ' ' || byte == '%' || byte == 0x7f) {
+        text += '%';
+        text += "0123456789ABCDEF"[byte / 16];
+        text += "0123456789ABCDEF"[byte % 16];
+      } else {
+        text += c;
+      }
+    }
+    text += ' ';
+    text += std::to_string(entry.digest.size);
+    text += ' ';
+    text += DigestToHex(entry.digest.root);
+    text += ' ';
+    for (size_t i = 0; i < entry.digest.leaves.size(); ++i) {
+      if (i > 0) {
+        text += ',';
+      }
+      text += DigestToHex(entry.digest.leaves[i]);
+    }
+    text += '\n';
+  }
+  return text;
+}
+
+bool ParseIntegrityManifest(std::string_view text,
+                            std::vector<ManifestEntry>* entries) {
+  while (!text.empty()) {
+    const size_t newline = text.find('\n');
+    const std::string_view line = text.substr(0, newline);
+    text.remove_prefix(newline == std::string_view::npos ? text.size()
+                                                         : newline + 1);
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::string_view fields[4];
+    size_t field_count = 0;
+    size_t start = 0;
+    while (start <= line.size() && field_count < 4) {
+      size_t end = line.find(' ', start);
+      if (end == std::string_view::npos) {
+        end = line.size();
+      }
+      fields[field_count++] = line.substr(start, end - start);
+      start = end + 1;
+    }
+    if (field_count < 3) {
+      return false;
+    }
+
+    ManifestEntry entry;
+    const std::string_view name = fields[0];
+    for (size_t i = 0; i < name.size(); ++i) {
+      if (name[i] != '%') {
+        entry.name += name[i];
+        continue;
+      }
+      const int high = i + 2 < name.size() ? HexNibble(name[i + 1]) : -1;
+      const int low = i + 2 < name.size() ? HexNibble(name[i + 2]) : -1;
+      if (high < 0 || low < 0) {
+        return false;
+      }
+      entry.name += static_cast<char>(high * 16 + low);
+      i += 2;
+    }
+
+    const std::string size(fields[1]);
+    char* size_end = nullptr;
+    entry.digest.size = std::strtoull(size.c_str(), &size_end, 10);
+    if (size.empty() || *size_end != '\0' ||
+        !DigestFromHex(fields[2], &entry.digest.root)) {
+      return false;
+    }
+
+    const std::string_view leaves = fields[3];
+    start = 0;
+    while (start < leaves.size()) {
+      size_t end = leaves.find(',', start);
+      if (end == std::string_view::npos) {
+        end = leaves.size();
+      }
+      Digest leaf;
+      if (!DigestFromHex(leaves.substr(start, end - start), &leaf)) {
+        return false;
+      }
+      entry.digest.leaves.push_back(leaf);
+      start = end + 1;
+    }
+    entries->push_back(std::move(entry));
+  }
+  return true;
+}
+
+AppIntegrityVerifier& AppIntegrityVerifier::Instance() {
+  static AppIntegrityVerifier* instance = new AppIntegrityVerifier();
+  return *instance;
+}
+
+void AppIntegrityVerifier::SetManifestPath(std::string path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  manifest_path_ = std::move(path);
+}
+
+void AppIntegrityVerifier::SetPublicKey(const std::array<uint8_t, 32>& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  public_key_ = key;
+  has_public_key_ = true;
+}
+
+IntegrityReport AppIntegrityVerifier::Verify() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  IntegrityReport report;
+
+  const std::string executable = ExecutablePath();
+  const std::string manifest_path =
+      manifest_path_.empty() ? DirectoryOf(executable) + "/data/" +
+                                   kIntegrityManifestName
+                             : manifest_path_;
+
+  std::ifstream file(manifest_path, std::ios::binary);
+  if (!file.is_open()) {
+    // Debug and `flutter run` builds are never installed, so they have no
+    // manifest to check against.
+    return report;
+  }
+  report.manifest_found = true;
+  std::ostringstream text;
+  text << file.rdbuf();
+  const std::string contents = text.str();
+
+  std::string_view body;
+  std::vector<ManifestEntry> entries;
+  if (!has_public_key_ ||
+      !VerifyAssetManifest(contents, public_key_, &body) ||
+      !ParseIntegrityManifest(body, &entries)) {
+    return report;
+  }
+  report.signature_valid = true;
+
+  for (const auto& entry : entries) {
+    const std::string path = ResolveBundleFile(entry.name, executable);
+
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+      report.missing.push_back(entry.name);
+      continue;
+    }
+
+    auto cached = verified_.find(path);
+    if (cached != verified_.end() && cached->second.device == info.st_dev &&
+        cached->second.inode == info.st_ino &&
+        cached->second.mtime_ns == MtimeNanos(info) &&
+        cached->second.size == static_cast<uint64_t>(info.st_size) &&
+        cached->second.root == entry.digest.root) {
+      continue;
+    }
+
+    MerkleDigest actual;
+    ++report.files_hashed;
+    const HashOutcome outcome = HashFileMerkle(path, &entry.digest, &actual);
+    if (outcome == HashOutcome::kUnreadable) {
+      report.missing.push_back(entry.name);
+      verified_.erase(path);
+    } else if (outcome == HashOutcome::kMismatch) {
+      report.mismatched.push_back(entry.name);
+      verified_.erase(path);
+    } else if (std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+                       .count() -
+                   MtimeNanos(info) <
+               kRacyWindowNs) {
+      verified_.erase(path);
+    } else {
+      CachedFile& file = verified_[path];
+      file.device = info.st_dev;
+      file.inode = info.st_ino;
+      file.mtime_ns = MtimeNanos(info);
+      file.size = static_cast<uint64_t>(info.st_size);
+      file.root = actual.root;
+    }
+  }
+
+  report.verified = report.mismatched.empty() && report.missing.empty();
+  return report;
+}
+
+}  // namespace ultra_secure_flutter_kit
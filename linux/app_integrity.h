@@ -0,0 +1,115 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_APP_INTEGRITY_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_APP_INTEGRITY_H_
+
+#include <sys/types.h>
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+using Digest = std::array<uint8_t, 32>;
+
+// Files are hashed in chunks of this size. Each chunk is a Merkle leaf
+// (SHA-256 of 0x00 || chunk) and pairs of nodes are combined as
+// SHA-256(0x01 || left || right), with an odd node promoted unchanged.
+constexpr size_t kIntegrityChunkSize = 1 << 20;
+
+// File name of the manifest, installed into the bundle's data directory.
+constexpr const char* kIntegrityManifestName =
+    "ultra_secure_flutter_kit_integrity.manifest";
+
+struct MerkleDigest {
+  uint64_t size = 0;
+  Digest root{};
+  std::vector<Digest> leaves;
+};
+
+enum class HashOutcome { kOk, kUnreadable, kMismatch };
+
+// Memory-maps `path` and hashes its chunks on up to `workers` threads, one
+// per core for 0. When
+// `expected` is given, workers compare each leaf as soon as it is hashed
+// and the whole pass stops at the first mismatching chunk. `bytes_hashed`,
+// if given, is increased by the bytes actually read.
+HashOutcome HashFileMerkle(const std::string& path,
+                           const MerkleDigest* expected, MerkleDigest* out,
+                           size_t workers = 0,
+                           uint64_t* bytes_hashed = nullptr);
+
+Digest MerkleRoot(const std::vector<Digest>& leaves);
+
+std::string DigestToHex(const Digest& digest);
+bool DigestFromHex(std::string_view hex, Digest* digest);
+
+// One file per line: "<name> <size> <root-hex> <leaf-hex>[,<leaf-hex>...]".
+// `name` is the file's base name within the bundle, or for the asset
+// manifest its path relative to the bundle. Spaces, control characters and
+// '%' in names are written as %XX.
+struct ManifestEntry {
+  std::string name;
+  MerkleDigest digest;
+};
+
+std::string FormatIntegrityManifest(const std::vector<ManifestEntry>& entries);
+// Lines starting with '#' are skipped. False on any malformed line.
+bool ParseIntegrityManifest(std::string_view text,
+                            std::vector<ManifestEntry>* entries);
+
+struct IntegrityReport {
+  bool manifest_found = false;
+  bool signature_valid = false;
+  // Every file in a correctly signed manifest matched.
+  bool verified = false;
+  std::vector<std::string> mismatched;
+  std::vector<std::string> missing;
+  // Files that had to be hashed; the rest were served from the cache.
+  size_t files_hashed = 0;
+};
+
+// Verifies the running executable and the libraries listed in the
+// manifest that was generated when the bundle was installed. The manifest
+// is signed like the asset manifest (asset_integrity.h), so one rewritten
+// to match modified binaries is refused.
+//
+// A file whose (device, inode, mtime, size) matches a previous successful
+// verification is not hashed again, so repeat calls cost one stat() per
+// file.
+class AppIntegrityVerifier {
+ public:
+  static AppIntegrityVerifier& Instance();
+
+  IntegrityReport Verify();
+
+  // Defaults to <executable dir>/data/<kIntegrityManifestName>.
+  void SetManifestPath(std::string path);
+  // The Ed25519 key the manifest must be signed with (AssetManifestKey).
+  // Until it is set every manifest is refused.
+  void SetPublicKey(const std::array<uint8_t, 32>& key);
+
+ private:
+  struct CachedFile {
+    dev_t device = 0;
+    ino_t inode = 0;
+    int64_t mtime_ns = 0;
+    uint64_t size = 0;
+    Digest root{};
+  };
+
+  AppIntegrityVerifier() = default;
+
+  std::mutex mutex_;
+  std::string manifest_path_;
+  bool has_public_key_ = false;
+  std::array<uint8_t, 32> public_key_{};
+  std::unordered_map<std::string, CachedFile> verified_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_APP_INTEGRITY_H_
@@ -0,0 +1,518 @@
+#include "asset_integrity.h"
+
+#include <openssl/evp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+#include "parallel_for.h"
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+// As in app_integrity.cpp: a file modified this recently could change
+// again without its mtime moving, so its result is not cached.
+constexpr int64_t kRacyWindowNs = 2000000000;
+
+constexpr uint32_t kOpenEvents = IN_OPEN;
+constexpr uint32_t kChangeEvents = IN_CLOSE_WRITE | IN_ATTRIB | IN_CREATE |
+                                   IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+
+int64_t MtimeNanos(const struct stat& info) {
+  return static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+         info.st_mtim.tv_nsec;
+}
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+std::string ExecutableDirectory() {
+  char buffer[4096];
+  const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+  if (length <= 0) {
+    return ".";
+  }
+  const std::string path(buffer, static_cast<size_t>(length));
+  return path.substr(0, path.rfind('/'));
+}
+
+std::string DirectoryOf(const std::string& path) {
+  const size_t slash = path.rfind('/');
+  return slash == std::string::npos ? std::string(".") : path.substr(0, slash);
+}
+
+void CloseFd(int* fd) {
+  if (*fd >= 0) {
+    close(*fd);
+    *fd = -1;
+  }
+}
+
+}  // namespace
+
+const char* AssetStatusName(AssetStatus status) {
+  switch (status) {
+    case AssetStatus::kPending:
+      return "pending";
+    case AssetStatus::kVerified:
+      return "verified";
+    case AssetStatus::kMismatched:
+      return "mismatched";
+    case AssetStatus::kMissing:
+      return "missing";
+  }
+  return "unknown";
+}
+
+bool VerifyAssetManifest(std::string_view text, const AssetManifestKey& key,
+                         std::string_view* body) {
+  // The signature line is the last one, newline-terminated.
+  if (text.empty() || text.back() != '\n') {
+    return false;
+  }
+  const size_t line_start = text.rfind('\n', text.size() - 2);
+  const size_t signature_start =
+      line_start == std::string_view::npos ? 0 : line_start + 1;
+  std::string_view line = text.substr(signature_start);
+  line.remove_suffix(1);
+  if (line.substr(0, kAssetSignaturePrefix.size()) != kAssetSignaturePrefix) {
+    return false;
+  }
+  line.remove_prefix(kAssetSignaturePrefix.size());
+
+  // An Ed25519 signature is two digests' worth of bytes.
+  Digest first;
+  Digest second;
+  if (line.size() != 128 || !DigestFromHex(line.substr(0, 64), &first) ||
+      !DigestFromHex(line.substr(64), &second)) {
+    return false;
+  }
+  uint8_t signature[64];
+  std::copy(first.begin(), first.end(), signature);
+  std::copy(second.begin(), second.end(), signature + 32);
+
+  EVP_PKEY* public_key = EVP_PKEY_new_raw_public_key(
+      EVP_PKEY_ED25519, nullptr, key.data(), key.size());
+  if (public_key == nullptr) {
+    return false;
+  }
+  EVP_MD_CTX* context = EVP_MD_CTX_new();
+  const bool valid =
+      context != nullptr &&
+      EVP_DigestVerifyInit(context, nullptr, nullptr, nullptr, public_key) ==
+          1 &&
+      EVP_DigestVerify(context, signature, sizeof(signature),
+                       reinterpret_cast<const uint8_t*>(text.data()),
+                       signature_start) == 1;
+  EVP_MD_CTX_free(context);
+  EVP_PKEY_free(public_key);
+  if (valid) {
+    *body = text.substr(0, signature_start);
+  }
+  return valid;
+}
+
+AssetVerifier::AssetVerifier(EventCallback callback)
+    : callback_(std::move(callback)) {}
+
+AssetVerifier::~AssetVerifier() { Stop(); }
+
+bool AssetVerifier::Start(const AssetVerifierOptions& options) {
+  std::lock_guard<std::mutex> start_lock(start_mutex_);
+  if (started_) {
+    return running_.load();
+  }
+  started_ = true;
+
+  const std::string bundle_dir = options.bundle_dir.empty()
+                                     ? ExecutableDirectory()
+                                     : options.bundle_dir;
+  const std::string manifest_path =
+      options.manifest_path.empty()
+          ? bundle_dir + "/data/" + kAssetManifestName
+          : options.manifest_path;
+
+  std::string text;
+  {
+    std::ifstream file(manifest_path, std::ios::binary);
+    if (file.is_open()) {
+      std::ostringstream contents;
+      contents << file.rdbuf();
+      text = contents.str();
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  files_.clear();
+  by_path_.clear();
+  queue_.clear();
+  files_hashed_ = 0;
+  bytes_hashed_ = 0;
+  manifest_found_ = !text.empty();
+  signature_valid_ = false;
+  if (!manifest_found_) {
+    // Debug and `flutter run` builds are never installed, so they have no
+    // manifest to check against.
+    return false;
+  }
+
+  std::string_view body;
+  std::vector<ManifestEntry> entries;
+  if (!VerifyAssetManifest(text, options.public_key, &body) ||
+      !ParseIntegrityManifest(body, &entries)) {
+    lock.unlock();
+    if (callback_) {
+      callback_({kAssetManifestName, AssetStatus::kMismatched});
+    }
+    return false;
+  }
+  signature_valid_ = true;
+
+  files_.resize(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    files_[i].path = bundle_dir + "/" + entries[i].name;
+    files_[i].entry = std::move(entries[i]);
+    by_path_.emplace(files_[i].path, i);
+  }
+  for (size_t i = 0; i < files_.size(); ++i) {
+    Enqueue(i, false);
+  }
+  // Whatever is already mapped (libapp.so, by the time the plugin loads)
+  // is in use, so it goes first.
+  ScanLines("/proc/self/maps", [&](std::string_view line) {
+    const size_t path_start = line.find('/');
+    if (path_start != std::string_view::npos) {
+      auto mapped = by_path_.find(std::string(line.substr(path_start)));
+      if (mapped != by_path_.end()) {
+        Enqueue(mapped->second, true);
+      }
+    }
+    return true;
+  });
+
+  stopping_ = false;
+  running_.store(true);
+  const size_t worker_count = std::min(
+      std::max<size_t>(1, files_.size()),
+      options.workers == 0 ? HardwareWorkers() : options.workers);
+  for (size_t i = 0; i < worker_count; ++i) {
+    workers_.emplace_back(&AssetVerifier::RunWorker, this);
+  }
+  lock.unlock();
+
+  if (options.watch) {
+    inotify_fd_ = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (inotify_fd_ >= 0 && wake_fd_ >= 0) {
+      WatchDirectories();
+      watcher_ = std::thread(&AssetVerifier::RunWatcher, this);
+    } else {
+      CloseFd(&inotify_fd_);
+      CloseFd(&wake_fd_);
+    }
+  }
+  return true;
+}
+
+void AssetVerifier::Stop() {
+  std::lock_guard<std::mutex> start_lock(start_mutex_);
+  started_ = false;
+  if (!running_.exchange(false)) {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stopping_ = true;
+    work_.notify_all();
+    idle_.notify_all();
+    // Verify() callers may be hashing a file; let them finish it.
+    idle_.wait(lock, [this] { return helpers_ == 0; });
+  }
+  if (wake_fd_ >= 0) {
+    const uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) {
+      // The watcher also re-checks running_ after every wakeup.
+    }
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+  if (watcher_.joinable()) {
+    watcher_.join();
+  }
+  CloseFd(&inotify_fd_);
+  CloseFd(&wake_fd_);
+  watched_.clear();
+}
+
+void AssetVerifier::Enqueue(size_t index, bool front) {
+  File& file = files_[index];
+  file.status = AssetStatus::kPending;
+  // A file already queued may be pushed again to move it forward; the
+  // stale entry is skipped when popped.
+  if (file.queued && !front) {
+    return;
+  }
+  file.queued = true;
+  if (front) {
+    queue_.push_front(index);
+  } else {
+    queue_.push_back(index);
+  }
+  work_.notify_one();
+}
+
+bool AssetVerifier::Unchanged(const File& file) const {
+  struct stat info;
+  if (stat(file.path.c_str(), &info) != 0) {
+    return file.status == AssetStatus::kMissing;
+  }
+  return file.status != AssetStatus::kMissing && !file.racy &&
+         file.device == info.st_dev && file.inode == info.st_ino &&
+         file.mtime_ns == MtimeNanos(info) &&
+         file.size == static_cast<uint64_t>(info.st_size);
+}
+
+bool AssetVerifier::HashNext(std::unique_lock<std::mutex>& lock) {
+  size_t index = files_.size();
+  while (!queue_.empty()) {
+    const size_t candidate = queue_.front();
+    queue_.pop_front();
+    if (files_[candidate].queued) {
+      index = candidate;
+      break;
+    }
+  }
+  if (index == files_.size()) {
+    return false;
+  }
+
+  File& file = files_[index];
+  file.queued = false;
+  file.hashing = true;
+  ++hashing_;
+  const std::string path = file.path;
+  const MerkleDigest expected = file.entry.digest;
+  lock.unlock();
+
+  // Stat before and after, so a file replaced while it was being hashed
+  // is not cached under the new file's identity.
+  struct stat before {};
+  struct stat after {};
+  MerkleDigest actual;
+  uint64_t bytes = 0;
+  HashOutcome outcome = HashOutcome::kUnreadable;
+  bool stable = false;
+  const bool found = stat(path.c_str(), &before) == 0;
+  if (found) {
+    // One thread per file: the other workers are busy with other files.
+    outcome = HashFileMerkle(path, &expected, &actual, 1, &bytes);
+    stable = stat(path.c_str(), &after) == 0 &&
+             before.st_dev == after.st_dev && before.st_ino == after.st_ino &&
+             MtimeNanos(before) == MtimeNanos(after) &&
+             before.st_size == after.st_size;
+  }
+
+  lock.lock();
+  file.hashing = false;
+  --hashing_;
+  ++files_hashed_;
+  bytes_hashed_ += bytes;
+  AssetEvent event;
+  if (!file.queued) {
+    // Not changed again (and re-queued) while it was being hashed.
+    if (outcome == HashOutcome::kUnreadable) {
+      file.status = AssetStatus::kMissing;
+    } else if (outcome == HashOutcome::kMismatch) {
+      file.status = AssetStatus::kMismatched;
+    } else {
+      file.status = AssetStatus::kVerified;
+    }
+    if (found) {
+      file.device = before.st_dev;
+      file.inode = before.st_ino;
+      file.mtime_ns = MtimeNanos(before);
+      file.size = static_cast<uint64_t>(before.st_size);
+      file.racy = !stable || NowNanos() - file.mtime_ns < kRacyWindowNs;
+    } else {
+      // Missing: Unchanged() only asks whether it is still missing.
+      file.device = 0;
+      file.inode = 0;
+      file.mtime_ns = 0;
+      file.size = 0;
+      file.racy = false;
+    }
+    if (file.status != file.reported) {
+      if (file.status != AssetStatus::kVerified) {
+        event.name = file.entry.name;
+        event.status = file.status;
+      }
+      file.reported = file.status;
+    }
+  }
+  if (queue_.empty() && hashing_ == 0) {
+    idle_.notify_all();
+  }
+
+  if (!event.name.empty() && callback_) {
+    lock.unlock();
+    callback_(event);
+    lock.lock();
+  }
+  return true;
+}
+
+AssetReport AssetVerifier::Verify(bool wait) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (running_.load()) {
+    for (size_t i = 0; i < files_.size(); ++i) {
+      const File& file = files_[i];
+      if (!file.queued && !file.hashing &&
+          file.status != AssetStatus::kPending && !Unchanged(file)) {
+        Enqueue(i, true);
+      }
+    }
+    ++helpers_;
+    while (wait && !stopping_ && (!queue_.empty() || hashing_ > 0)) {
+      if (!HashNext(lock)) {
+        idle_.wait(lock, [this] {
+          return stopping_ || (queue_.empty() && hashing_ == 0);
+        });
+      }
+    }
+    --helpers_;
+    idle_.notify_all();
+  }
+  return MakeReport();
+}
+
+AssetReport AssetVerifier::MakeReport() const {
+  AssetReport report;
+  report.manifest_found = manifest_found_;
+  report.signature_valid = signature_valid_;
+  report.files_total = files_.size();
+  report.files_hashed = files_hashed_;
+  report.bytes_hashed = bytes_hashed_;
+  report.complete = signature_valid_;
+  for (const auto& file : files_) {
+    switch (file.status) {
+      case AssetStatus::kPending:
+        report.complete = false;
+        break;
+      case AssetStatus::kVerified:
+        ++report.files_verified;
+        break;
+      case AssetStatus::kMismatched:
+        report.mismatched.push_back(file.entry.name);
+        break;
+      case AssetStatus::kMissing:
+        report.missing.push_back(file.entry.name);
+        break;
+    }
+  }
+  report.verified = report.complete && report.mismatched.empty() &&
+                    report.missing.empty();
+  return report;
+}
+
+void AssetVerifier::Prioritize(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto found = by_path_.find(path);
+  if (found != by_path_.end() && files_[found->second].queued) {
+    Enqueue(found->second, true);
+  }
+}
+
+void AssetVerifier::RunWorker() {
+  // Background work: never compete with the UI and raster threads.
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    if (!HashNext(lock)) {
+      work_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+    }
+  }
+}
+
+void AssetVerifier::WatchDirectories() {
+  std::vector<std::string> directories;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& file : files_) {
+      directories.push_back(DirectoryOf(file.path));
+    }
+  }
+  std::sort(directories.begin(), directories.end());
+  directories.erase(std::unique(directories.begin(), directories.end()),
+                    directories.end());
+  for (const auto& directory : directories) {
+    const int watch = inotify_add_watch(inotify_fd_, directory.c_str(),
+                                        kOpenEvents | kChangeEvents);
+    if (watch >= 0) {
+      watched_[watch] = directory;
+    }
+  }
+}
+
+void AssetVerifier::RunWatcher() {
+  alignas(inotify_event) char buffer[16384];
+  pollfd poll_fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+  while (running_.load()) {
+    if (poll(poll_fds, 2, -1) < 0 && errno != EINTR) {
+      return;
+    }
+    if ((poll_fds[1].revents & POLLIN) != 0) {
+      return;
+    }
+    ssize_t length;
+    while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+      HandleWatchEvents(buffer, static_cast<size_t>(length));
+    }
+  }
+}
+
+void AssetVerifier::HandleWatchEvents(const char* buffer, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t offset = 0; offset + sizeof(inotify_event) <= size;) {
+    const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+    offset += sizeof(inotify_event) + event->len;
+    auto directory = watched_.find(event->wd);
+    if (event->len == 0 || directory == watched_.end()) {
+      continue;
+    }
+    auto found = by_path_.find(directory->second + "/" + event->name);
+    if (found == by_path_.end()) {
+      continue;
+    }
+    File& file = files_[found->second];
+    if ((event->mask & kChangeEvents) != 0) {
+      // Written, touched, replaced or removed: whatever was verified
+      // before no longer holds.
+      Enqueue(found->second, true);
+    } else if (file.queued) {
+      // First opened by the engine (or anyone else) while still waiting.
+      Enqueue(found->second, true);
+    }
+  }
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,184 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_ASSET_INTEGRITY_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_ASSET_INTEGRITY_H_
+
+// Verifies the Flutter assets (data/flutter_assets/**) and lib/libapp.so
+// against the signed manifest written when the bundle was installed by
+// tools/asset_manifest_main.cpp.
+//
+// The manifest is an integrity manifest (app_integrity.h) whose names are
+// paths relative to the bundle, followed by one last line
+// "signature <hex>": an Ed25519 signature over every byte before it. The
+// signing key is generated per build directory; its public half is
+// compiled into the plugin, so a manifest rewritten to match modified
+// assets is refused.
+//
+// Nothing is hashed at startup. Start() reads the manifest, checks the
+// signature and hands the files to low-priority background workers, one
+// file per worker at a time so a large bundle is spread over every core.
+// Files already mapped (libapp.so) go first, and an inotify watch on the
+// asset directories moves each file to the front of the queue when the
+// engine first opens it, so the assets in use are checked soonest. The
+// same watch queues a file again when it is written, replaced or deleted.
+
+#include <sys/types.h>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "app_integrity.h"
+
+namespace ultra_secure_flutter_kit {
+
+// File name of the manifest, installed into the bundle's data directory.
+constexpr const char* kAssetManifestName =
+    "ultra_secure_flutter_kit_assets.manifest";
+// Starts the manifest's last line.
+constexpr std::string_view kAssetSignaturePrefix = "signature ";
+
+using AssetManifestKey = std::array<uint8_t, 32>;  // Ed25519 public key
+
+// Splits the signature line off `text` and checks it against `key`. On
+// success `body` is the signed part, ready for ParseIntegrityManifest().
+bool VerifyAssetManifest(std::string_view text, const AssetManifestKey& key,
+                         std::string_view* body);
+
+struct AssetVerifierOptions {
+  // Empty means the directory of the running executable.
+  std::string bundle_dir;
+  // Empty means <bundle_dir>/data/<kAssetManifestName>.
+  std::string manifest_path;
+  AssetManifestKey public_key{};
+  // Background hashing threads; 0 for one per core.
+  size_t workers = 0;
+  // Prioritize files as they are opened, and re-check them when they
+  // change, through inotify.
+  bool watch = true;
+};
+
+enum class AssetStatus : uint8_t { kPending, kVerified, kMismatched, kMissing };
+
+const char* AssetStatusName(AssetStatus status);
+
+struct AssetEvent {
+  std::string name;  // relative to the bundle, or kAssetManifestName
+  AssetStatus status = AssetStatus::kMismatched;
+};
+
+struct AssetReport {
+  bool manifest_found = false;
+  bool signature_valid = false;
+  // No file is waiting to be hashed or being hashed.
+  bool complete = false;
+  // Every file in a correctly signed manifest hashed and matched.
+  bool verified = false;
+  size_t files_total = 0;
+  size_t files_verified = 0;
+  std::vector<std::string> mismatched;
+  std::vector<std::string> missing;
+  // Since Start(); files served from the cache are not counted.
+  size_t files_hashed = 0;
+  uint64_t bytes_hashed = 0;
+};
+
+class AssetVerifier {
+ public:
+  // Called from a worker thread when a file is found mismatched or missing
+  // (again only after it has changed status), and once for a manifest
+  // whose signature does not verify.
+  using EventCallback = std::function<void(const AssetEvent&)>;
+
+  explicit AssetVerifier(EventCallback callback);
+  ~AssetVerifier();
+
+  AssetVerifier(const AssetVerifier&) = delete;
+  AssetVerifier& operator=(const AssetVerifier&) = delete;
+
+  // Reads the manifest and starts the workers without waiting for any
+  // hashing. False if there is no manifest or its signature does not
+  // verify. Later calls return the first call's result until Stop().
+  bool Start(const AssetVerifierOptions& options);
+  void Stop();
+  bool IsRunning() const { return running_.load(); }
+
+  // Reports progress so far. A verified file is re-checked with one
+  // stat(): it is queued again unless its (device, inode, mtime, size) is
+  // unchanged since it was hashed. With `wait` the calling thread helps
+  // hash and the report is complete.
+  AssetReport Verify(bool wait);
+
+  // Moves the file at `path` to the front of the queue if it is waiting.
+  void Prioritize(const std::string& path);
+
+ private:
+  struct File {
+    ManifestEntry entry;
+    std::string path;
+    AssetStatus status = AssetStatus::kPending;
+    bool queued = false;
+    bool hashing = false;
+    // Identity of the file when it was last hashed.
+    dev_t device = 0;
+    ino_t inode = 0;
+    int64_t mtime_ns = 0;
+    uint64_t size = 0;
+    // Modified too recently for its mtime to be trusted.
+    bool racy = false;
+    // Last status passed to the callback, so a file re-hashed with the
+    // same outcome is not reported again.
+    AssetStatus reported = AssetStatus::kVerified;
+  };
+
+  // Require mutex_ to be held.
+  void Enqueue(size_t index, bool front);
+  bool Unchanged(const File& file) const;
+  // Pops and hashes one file, dropping `lock` while hashing. False if the
+  // queue held nothing to do.
+  bool HashNext(std::unique_lock<std::mutex>& lock);
+  AssetReport MakeReport() const;
+
+  void RunWorker();
+  void RunWatcher();
+  void WatchDirectories();
+  void HandleWatchEvents(const char* buffer, size_t size);
+
+  EventCallback callback_;
+
+  std::mutex start_mutex_;
+  bool started_ = false;  // under start_mutex_
+  std::atomic<bool> running_{false};
+
+  mutable std::mutex mutex_;
+  bool stopping_ = false;
+  bool manifest_found_ = false;
+  bool signature_valid_ = false;
+  std::vector<File> files_;
+  std::unordered_map<std::string, size_t> by_path_;
+  std::deque<size_t> queue_;
+  size_t hashing_ = 0;
+  size_t helpers_ = 0;  // Verify() callers hashing alongside the workers
+  size_t files_hashed_ = 0;
+  uint64_t bytes_hashed_ = 0;
+  std::condition_variable work_;
+  std::condition_variable idle_;
+
+  std::vector<std::thread> workers_;
+  std::thread watcher_;
+  int inotify_fd_ = -1;
+  int wake_fd_ = -1;
+  std::unordered_map<int, std::string> watched_;  // descriptor -> directory
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_ASSET_INTEGRITY_H_
@@ -0,0 +1,10 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_BENCHMARK_ALLOCATION_COUNTER_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_BENCHMARK_ALLOCATION_COUNTER_H_
+
+// Calls to operator new since the process started, counted by the
+// replacement operators in allocation_counter.cpp. They live in their own
+// translation unit so the compiler never sees a new/delete pair it can
+// inline into the benchmarks and mistake for a mismatch.
+long AllocationCount();
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_BENCHMARK_ALLOCATION_COUNTER_H_
@@ -0,0 +1,606 @@
+// Google Benchmark suite for the Linux security checks, run against a
+// synthetic filesystem root so results do not depend on the host. Build
+// with -DULTRA_SECURE_FLUTTER_KIT_BUILD_BENCHMARKS=ON and run
+// ./ultra_secure_flutter_kit_bench [benchmark flags].
+//
+// The fixture is generated under $TMPDIR at startup and removed on exit:
+//   /proc/cpuinfo                 kCpuCount processor blocks (~1.4 MB)
+//   /sys/bus/usb/devices          kUsbDeviceCount devices with descriptor
+//                                 files, plus one interface per device and
+//                                 the root hubs
+//   /etc, /sys/class/dmi          os-release, machine-id, DMI strings
+// No tool the path probes look for is present, so every probe walks its
+// whole list; that is the cost paid on a clean machine. The directories
+// they look in are backdated, so iterations after the first measure the
+// PathProbe cache.
+// Network interfaces come from rtnetlink and processes from /proc, which
+// cannot be redirected; those benchmarks measure the host.
+//
+// Besides ns/op, each benchmark reports allocs/op: calls to operator new
+// per iteration.
+
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <ftw.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "../aead_cipher.h"
+#include "../emulator_detector.h"
+#include "../filesystem_root.h"
+#include "../fingerprint_cache.h"
+#include "../network_interfaces.h"
+#include "../proc_reader.h"
+#include "../process_monitor.h"
+#include "../secure_memory.h"
+#include "../secure_store.h"
+#include "../security_snapshot.h"
+#include "../snapshot_record.h"
+#include "../system_checks.h"
+#include "../usb_device_table.h"
+#include "allocation_counter.h"
+
+namespace {
+
+using namespace ultra_secure_flutter_kit;
+
+constexpr int kCpuCount = 1024;
+constexpr int kUsbBusCount = 8;
+constexpr int kUsbDeviceCount = 4096;
+
+// Counts operator new calls over the benchmark loop.
+class AllocationCounter {
+ public:
+  explicit AllocationCounter(benchmark::State& state)
+      : state_(state), start_(AllocationCount()) {}
+
+  ~AllocationCounter() {
+    state_.counters["allocs/op"] =
+        benchmark::Counter(static_cast<double>(AllocationCount() - start_),
+                           benchmark::Counter::kAvgIterations);
+  }
+
+ private:
+  benchmark::State& state_;
+  const long start_;
+};
+
+void MakeDirectories(const std::string& path) {
+  for (size_t slash = path.find('/', 1); slash != std::string::npos;
+       slash = path.find('/', slash + 1)) {
+    mkdir(path.substr(0, slash).c_str(), 0755);
+  }
+  mkdir(path.c_str(), 0755);
+}
+
+void WriteFile(const std::string& path, const std::string& content) {
+  if (FILE* file = fopen(path.c_str(), "w")) {
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+  }
+}
+
+std::string CpuInfo() {
+  std::string content;
+  char block[1024];
+  for (int cpu = 0; cpu < kCpuCount; ++cpu) {
+    snprintf(block, sizeof(block),
+             "processor\t: %d\n"
+             "vendor_id\t: GenuineIntel\n"
+             "cpu family\t: 6\n"
+             "model\t\t: 143\n"
+             "model name\t: Intel(R) Xeon(R) Platinum 8480+\n"
+             "stepping\t: 8\n"
+             "microcode\t: 0x2b000461\n"
+             "cpu MHz\t\t: 2000.000\n"
+             "cache size\t: 107520 KB\n"
+             "physical id\t: %d\n"
+             "siblings\t: %d\n"
+             "core id\t\t: %d\n"
+             "cpu cores\t: 56\n"
+             "apicid\t\t: %d\n"
+             "fpu\t\t: yes\n"
+             "cpuid level\t: 32\n"
+             "flags\t\t: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr "
+             "pge mca cmov pat pse36 clflush dts acpi mmx fxsr sse sse2 ss ht "
+             "tm pbe syscall nx pdpe1gb rdtscp lm constant_tsc art arch_perfmon "
+             "pebs bts rep_good nopl xtopology nonstop_tsc cpuid aperfmperf "
+             "pni pclmulqdq dtes64 monitor ds_cpl vmx smx est tm2 ssse3 sdbg "
+             "fma cx16 xtpr pdcm pcid dca sse4_1 sse4_2 x2apic movbe popcnt "
+             "aes xsave avx f16c rdrand lahf_lm abm 3dnowprefetch avx512f "
+             "avx512dq avx512cd avx512bw avx512vl amx_bf16 amx_tile amx_int8\n"
+             "bugs\t\t: spectre_v1 spectre_v2 spec_store_bypass swapgs\n"
+             "bogomips\t: 4000.00\n"
+             "clflush size\t: 64\n"
+             "cache_alignment\t: 64\n"
+             "address sizes\t: 46 bits physical, 57 bits virtual\n"
+             "power management:\n"
+             "\n",
+             cpu, cpu / 112, kCpuCount, cpu % 56, cpu);
+    content += block;
+  }
+  return content;
+}
+
+void BuildFixture(const std::string& root) {
+  MakeDirectories(root + "/proc/sys/kernel/random");
+  WriteFile(root + "/proc/cpuinfo", CpuInfo());
+  WriteFile(root + "/proc/sys/kernel/random/boot_id",
+            "5f1c3e2a-6f0e-4c8b-9a57-0d2b8f7c1e44\n");
+
+  MakeDirectories(root + "/etc");
+  WriteFile(root + "/etc/os-release",
+            "NAME=\"Ubuntu\"\nVERSION_ID=\"24.04\"\n"
+            "PRETTY_NAME=\"Ubuntu 24.04 LTS\"\nID=ubuntu\n");
+  WriteFile(root + "/etc/machine-id", "0d7f6c2b9a8e4f1db3c5a6e7f8091a2b\n");
+
+  MakeDirectories(root + "/sys/class/dmi/id");
+  WriteFile(root + "/sys/class/dmi/id/sys_vendor", "Dell Inc.\n");
+  WriteFile(root + "/sys/class/dmi/id/product_name", "PowerEdge R760\n");
+
+  const std::string usb = root + "/sys/bus/usb/devices";
+  MakeDirectories(usb);
+  for (int bus = 1; bus <= kUsbBusCount; ++bus) {
+    mkdir((usb + "/usb" + std::to_string(bus)).c_str(), 0755);
+  }
+  char name[64];
+  char value[64];
+  for (int i = 0; i < kUsbDeviceCount; ++i) {
+    // Bus, root port and a hub port: "3-7.12".
+    snprintf(name, sizeof(name), "%d-%d.%d", i % kUsbBusCount + 1,
+             i / kUsbBusCount / 16 + 1, i / kUsbBusCount % 16 + 1);
+    const std::string device = usb + "/" + name;
+    mkdir(device.c_str(), 0755);
+    mkdir((device + ":1.0").c_str(), 0755);
+    snprintf(value, sizeof(value), "%04x\n", 0x1000 + i % 0x8000);
+    WriteFile(device + "/idVendor", value);
+    snprintf(value, sizeof(value), "%04x\n", i);
+    WriteFile(device + "/idProduct", value);
+    WriteFile(device + "/bDeviceClass", "00\n");
+    WriteFile(device + "/manufacturer", "Synthetic Devices Inc.\n");
+    WriteFile(device + "/product", "Benchmark Device\n");
+  }
+
+  MakeDirectories(root + "/usr/bin");
+  MakeDirectories(root + "/usr/local/bin");
+  MakeDirectories(root + "/var/lib");
+  MakeDirectories(root + "/tmp");
+
+  // Age the probed directories like a real /usr/bin; PathProbe does not
+  // cache directories modified in the last few seconds.
+  const struct timespec settled[2] = {{1'600'000'000, 0}, {1'600'000'000, 0}};
+  for (const char* directory :
+       {"/usr/bin", "/usr/local/bin", "/var/lib", "/etc", "/tmp"}) {
+    utimensat(AT_FDCWD, (root + directory).c_str(), settled, 0);
+  }
+}
+
+int RemoveEntry(const char* path, const struct stat*, int, FTW*) {
+  return remove(path);
+}
+
+void RemoveTree(const std::string& root) {
+  nftw(root.c_str(), RemoveEntry, 64, FTW_DEPTH | FTW_PHYS);
+}
+
+// --- Path probes ---------------------------------------------------------
+
+void BM_IsRooted(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindRootTool() != nullptr || IsRunningAsRoot());
+  }
+}
+BENCHMARK(BM_IsRooted);
+
+void BM_IsJailbroken(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindPackageManagerTrace());
+  }
+}
+BENCHMARK(BM_IsJailbroken);
+
+void BM_IsDeveloperModeEnabled(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindDeveloperTool());
+  }
+}
+BENCHMARK(BM_IsDeveloperModeEnabled);
+
+void BM_PreventReverseEngineering(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindReverseEngineeringTools());
+  }
+}
+BENCHMARK(BM_PreventReverseEngineering);
+
+// --- Network -------------------------------------------------------------
+
+// With no link or route change pending: one recv() on the notification
+// socket.
+void BM_HasVPNConnection(benchmark::State& state) {
+  NetworkInterfaceTable network;
+  network.Get();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(network.HasVpn());
+  }
+}
+BENCHMARK(BM_HasVPNConnection);
+
+// The link and route dumps behind the first query and every change.
+void BM_GetNetworkInterfacesDump(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    NetworkInterfaceTable network;
+    benchmark::DoNotOptimize(network.Get());
+  }
+}
+BENCHMARK(BM_GetNetworkInterfacesDump)->Unit(benchmark::kMicrosecond);
+
+void BM_HasProxySettings(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FindProxyVariable(nullptr));
+  }
+}
+BENCHMARK(BM_HasProxySettings);
+
+void BM_IsScreenCaptureBlocked(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(IsScreenCaptureFlagSet());
+  }
+}
+BENCHMARK(BM_IsScreenCaptureBlocked);
+
+// --- /proc readers -------------------------------------------------------
+
+void BM_IsDebuggerAttached(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    long tracer_pid = 0;
+    benchmark::DoNotOptimize(ReadSelfStatusField("TracerPid", &tracer_pid));
+  }
+}
+BENCHMARK(BM_IsDebuggerAttached);
+
+// Includes the host's CPUID tier, so on a VM this measures an early exit.
+void BM_IsEmulator(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DetectEmulator());
+  }
+}
+BENCHMARK(BM_IsEmulator);
+
+// DMI, then the first processor block of the fixture's cpuinfo.
+void BM_IsEmulatorFromFiles(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DetectEmulatorFromFiles());
+  }
+}
+BENCHMARK(BM_IsEmulatorFromFiles);
+
+// The fallback scan over every line of the ~1.4 MB cpuinfo.
+void BM_IsEmulatorFullCpuInfoScan(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ScanCpuInfoLegacy());
+  }
+}
+BENCHMARK(BM_IsEmulatorFullCpuInfoScan);
+
+// --- Processes -----------------------------------------------------------
+// These read the host's /proc: other processes cannot be faked in a fixture.
+
+// The full parallel /proc pass that seeds the table, and what every query
+// costs when the proc connector is unavailable.
+void BM_ProcessTableScan(benchmark::State& state) {
+  ProcessMonitor monitor;
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    monitor.SetSignatures(DefaultProcessSignatures());
+    benchmark::DoNotOptimize(monitor.Matches());
+  }
+}
+BENCHMARK(BM_ProcessTableScan)->Unit(benchmark::kMicrosecond);
+
+// Event-driven queries once the table is seeded.
+void BM_GetRunningAnalysisTools(benchmark::State& state) {
+  ProcessMonitor monitor;
+  monitor.Start();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(monitor.Matches());
+    benchmark::DoNotOptimize(monitor.Tracer());
+  }
+}
+BENCHMARK(BM_GetRunningAnalysisTools);
+
+// --- Fingerprint ---------------------------------------------------------
+
+void BM_GetDeviceFingerprint(benchmark::State& state) {
+  FingerprintCache::Instance().Get();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        FingerprintCache::Instance().Get().device_fingerprint.data());
+  }
+}
+BENCHMARK(BM_GetDeviceFingerprint);
+
+// Re-reads the cache key; the identity is unchanged so nothing is hashed.
+void BM_RefreshFingerprint(benchmark::State& state) {
+  FingerprintCache::Instance().Get();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(FingerprintCache::Instance().Refresh());
+  }
+}
+BENCHMARK(BM_RefreshFingerprint);
+
+// --- Secure memory -------------------------------------------------------
+
+// A hex digest in and out of the preallocated slabs.
+void BM_SecureStringAllocate(benchmark::State& state) {
+  SecureArena::Instance();
+  for (auto _ : state) {
+    SecureString digest(64, 'A');
+    benchmark::DoNotOptimize(digest.data());
+  }
+}
+BENCHMARK(BM_SecureStringAllocate);
+
+// What each secret would cost with its own guarded, locked mapping.
+void BM_LockedMappingPerCall(benchmark::State& state) {
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  for (auto _ : state) {
+    void* mapping = mmap(nullptr, 3 * page, PROT_NONE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    char* data = static_cast<char*>(mapping) + page;
+    mprotect(data, page, PROT_READ | PROT_WRITE);
+    madvise(mapping, 3 * page, MADV_DONTDUMP);
+    mlock(data, page);
+    memset(data, 'A', 64);
+    benchmark::DoNotOptimize(data);
+    SecureZero(data, 64);
+    munlock(data, page);
+    munmap(mapping, 3 * page);
+  }
+}
+BENCHMARK(BM_LockedMappingPerCall);
+
+// --- Encryption ----------------------------------------------------------
+
+// One-shot encrypt and decrypt of a 1 MiB buffer with each algorithm
+// (range(0) is the AeadAlgorithm), under a fixed key rather than
+// DataKey() so nothing is written to the data directory.
+void BM_Encrypt(benchmark::State& state) {
+  const auto algorithm = static_cast<AeadAlgorithm>(state.range(0));
+  const SecureVector<uint8_t> key(32, 0x5a);
+  const std::vector<uint8_t> plaintext(1 << 20, 'A');
+  for (auto _ : state) {
+    std::vector<uint8_t> out;
+    out.reserve(EncryptedMessageSize(plaintext.size()));
+    StreamEncryptor encryptor(key, algorithm);
+    encryptor.Update(plaintext.data(), plaintext.size(), &out);
+    encryptor.Finish(&out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * plaintext.size());
+  state.SetLabel(AeadAlgorithmName(algorithm));
+}
+BENCHMARK(BM_Encrypt)
+    ->Arg(static_cast<int>(AeadAlgorithm::kAes256Gcm))
+    ->Arg(static_cast<int>(AeadAlgorithm::kChaCha20Poly1305))
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Decrypt(benchmark::State& state) {
+  const auto algorithm = static_cast<AeadAlgorithm>(state.range(0));
+  const SecureVector<uint8_t> key(32, 0x5a);
+  const std::vector<uint8_t> plaintext(1 << 20, 'A');
+  std::vector<uint8_t> message;
+  StreamEncryptor encryptor(key, algorithm);
+  encryptor.Update(plaintext.data(), plaintext.size(), &message);
+  encryptor.Finish(&message);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        DecryptMessage(key, message.data(), message.size()).data());
+  }
+  state.SetBytesProcessed(state.iterations() * plaintext.size());
+  state.SetLabel(AeadAlgorithmName(algorithm));
+}
+BENCHMARK(BM_Decrypt)
+    ->Arg(static_cast<int>(AeadAlgorithm::kAes256Gcm))
+    ->Arg(static_cast<int>(AeadAlgorithm::kChaCha20Poly1305))
+    ->Unit(benchmark::kMicrosecond);
+
+// --- Secure store --------------------------------------------------------
+
+const SecureVector<uint8_t>& BenchmarkStoreKey() {
+  static const SecureVector<uint8_t>* key = new SecureVector<uint8_t>(32, 0x5a);
+  return *key;
+}
+
+SecureStoreOptions BenchmarkStoreOptions() {
+  SecureStoreOptions options;
+  options.path = std::string(FilesystemRoot()) + "/secure_store.log";
+  unlink(options.path.c_str());
+  return options;
+}
+
+// Overwrites among 1000 keys with 100-byte values, so compaction runs
+// alongside; writes are acknowledged before the group commit.
+void BM_SecureStorePut(benchmark::State& state) {
+  SecureStore store(&BenchmarkStoreKey, BenchmarkStoreOptions());
+  const std::string value(100, 'v');
+  std::string key = "key0000";
+  int i = 0;
+  for (auto _ : state) {
+    snprintf(key.data() + 3, 5, "%04d", i++ % 1000);
+    store.Put(key, value);
+  }
+  state.SetItemsProcessed(state.iterations());
+  const auto stats = store.GetStats();
+  state.counters["commits"] = static_cast<double>(stats.commits);
+  state.counters["compactions"] = static_cast<double>(stats.compactions);
+}
+BENCHMARK(BM_SecureStorePut)->UseRealTime();
+
+void BM_SecureStoreGet(benchmark::State& state) {
+  SecureStore store(&BenchmarkStoreKey, BenchmarkStoreOptions());
+  const std::string value(100, 'v');
+  std::string key = "key0000";
+  for (int i = 0; i < 1000; ++i) {
+    snprintf(key.data() + 3, 5, "%04d", i);
+    store.Put(key, value);
+  }
+  SecureString out;
+  int i = 0;
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    snprintf(key.data() + 3, 5, "%04d", i++ % 1000);
+    benchmark::DoNotOptimize(store.Get(key, &out));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SecureStoreGet);
+
+// Opening a log of 10000 records: the lazy index rebuild.
+void BM_SecureStoreOpen(benchmark::State& state) {
+  const SecureStoreOptions options = BenchmarkStoreOptions();
+  {
+    SecureStore store(&BenchmarkStoreKey, options);
+    const std::string value(100, 'v');
+    for (int i = 0; i < 10000; ++i) {
+      store.Put("key" + std::to_string(i), value);
+    }
+  }
+  for (auto _ : state) {
+    SecureStore store(&BenchmarkStoreKey, options);
+    SecureString out;
+    benchmark::DoNotOptimize(store.Get("key0", &out));
+  }
+}
+BENCHMARK(BM_SecureStoreOpen)->Unit(benchmark::kMillisecond);
+
+// --- USB -----------------------------------------------------------------
+
+// The startup getdents64 pass over kUsbDeviceCount devices.
+void BM_UsbDeviceTableScan(benchmark::State& state) {
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    UsbDeviceTable table;
+    benchmark::DoNotOptimize(&table);
+  }
+}
+BENCHMARK(BM_UsbDeviceTableScan)->Unit(benchmark::kMillisecond);
+
+// Also what getUsbConnectionStatus costs natively.
+void BM_IsUsbCableAttached(benchmark::State& state) {
+  UsbDeviceTable table;
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.HasDevices());
+  }
+}
+BENCHMARK(BM_IsUsbCableAttached);
+
+// Descriptors are loaded by the first listing; later ones copy the table.
+void BM_ListUsbDevices(benchmark::State& state) {
+  UsbDeviceTable table;
+  table.List();
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(table.List());
+  }
+}
+BENCHMARK(BM_ListUsbDevices)->Unit(benchmark::kMillisecond);
+
+// --- Snapshot ------------------------------------------------------------
+
+// The boolean checks as getSecuritySnapshot runs them, one thread each.
+void BM_GetSecuritySnapshot(benchmark::State& state) {
+  UsbDeviceTable usb_devices;
+  NetworkInterfaceTable network;
+  const std::vector<SecurityCheck> checks = {
+      {"isRooted",
+       [] { return FindRootTool() != nullptr || IsRunningAsRoot(); }},
+      {"isJailbroken", [] { return FindPackageManagerTrace() != nullptr; }},
+      {"isEmulator", [] { return DetectEmulator().detected; }},
+      {"isDebuggerAttached",
+       [] {
+         long tracer_pid = 0;
+         return ReadSelfStatusField("TracerPid", &tracer_pid) &&
+                tracer_pid != 0;
+       }},
+      {"isScreenCaptureBlocked", [] { return IsScreenCaptureFlagSet(); }},
+      {"isUsbCableAttached", [&] { return usb_devices.HasDevices(); }},
+      {"hasProxySettings",
+       [] { return FindProxyVariable(nullptr) != nullptr; }},
+      {"hasVPNConnection", [&] { return network.HasVpn(); }},
+      {"isDeveloperModeEnabled",
+       [] { return FindDeveloperTool() != nullptr; }},
+  };
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(RunSecuritySnapshot(checks));
+  }
+}
+BENCHMARK(BM_GetSecuritySnapshot)->UseRealTime();
+
+// Packing a finished snapshot for getSecuritySnapshot({"format": "binary"}).
+void BM_EncodeSnapshotRecord(benchmark::State& state) {
+  std::vector<Method> ids;
+  for (const auto& method : kMethods) {
+    if (method.IsSnapshotCheck()) {
+      ids.push_back(method.id);
+    }
+  }
+  AllocationCounter allocations(state);
+  for (auto _ : state) {
+    SnapshotRecord record;
+    for (size_t i = 0; i < ids.size(); ++i) {
+      record.SetCheck(ids[i], i % 3 == 0, false);
+    }
+    record.timestamp_ms = 1'700'000'000'000;
+    record.duration_us = 850;
+    record.platform = RecordPlatform::kLinux;
+    benchmark::DoNotOptimize(EncodeSnapshotRecord(record));
+  }
+}
+BENCHMARK(BM_EncodeSnapshotRecord);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  const char* temp = getenv("TMPDIR");
+  std::string root = std::string(temp ? temp : "/tmp") + "/usfk_bench_XXXXXX";
+  if (mkdtemp(root.data()) == nullptr) {
+    perror("mkdtemp");
+    return 1;
+  }
+  BuildFixture(root);
+  SetFilesystemRoot(root);
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  RemoveTree(root);
+  return 0;
+}
@@ -0,0 +1,148 @@
+// Compares the per-call cost of the original std::ifstream based readers
+// with proc_reader.h. Build with -DULTRA_SECURE_FLUTTER_KIT_BUILD_BENCHMARKS=ON
+// and run ./proc_reader_benchmark [iterations].
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include "../proc_reader.h"
+
+namespace {
+
+std::atomic<long> allocation_count{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* pointer = std::malloc(size)) {
+    return pointer;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+
+namespace {
+
+using ultra_secure_flutter_kit::FindField;
+using ultra_secure_flutter_kit::kProcBufferSize;
+using ultra_secure_flutter_kit::ReadFile;
+using ultra_secure_flutter_kit::ReadSelfStatusField;
+using ultra_secure_flutter_kit::ScanLines;
+
+// The readers as they were implemented in the plugin before proc_reader.
+
+bool LegacyTracerPid() {
+  std::ifstream file("/proc/self/status");
+  std::string line;
+  if (file.is_open()) {
+    while (std::getline(file, line)) {
+      if (line.find("TracerPid:") == 0) {
+        std::string pid_str = line.substr(11);
+        return std::stoi(pid_str) != 0;
+      }
+    }
+  }
+  return false;
+}
+
+std::string LegacyPrettyName() {
+  std::ifstream file("/etc/os-release");
+  std::string line;
+  std::string version = "Unknown";
+  if (file.is_open()) {
+    while (std::getline(file, line)) {
+      if (line.find("PRETTY_NAME=") == 0) {
+        version = line.substr(12);
+        break;
+      }
+    }
+  }
+  return version;
+}
+
+bool LegacyCpuInfoScan() {
+  const std::string indicators[] = {"VMware", "VirtualBox", "QEMU", "Xen",
+                                    "KVM"};
+  std::ifstream file("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(file, line)) {
+    for (const auto& indicator : indicators) {
+      if (line.find(indicator) != std::string::npos) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// The same work through proc_reader.
+
+bool TracerPid() {
+  long tracer_pid = 0;
+  return ReadSelfStatusField("TracerPid", &tracer_pid) && tracer_pid != 0;
+}
+
+size_t PrettyName() {
+  char buffer[kProcBufferSize];
+  return FindField(ReadFile("/etc/os-release", buffer, sizeof(buffer)),
+                   "PRETTY_NAME", '=')
+      .size();
+}
+
+bool CpuInfoScan() {
+  static constexpr std::string_view indicators[] = {"VMware", "VirtualBox",
+                                                    "QEMU", "Xen", "KVM"};
+  bool found = false;
+  ScanLines("/proc/cpuinfo", [&found](std::string_view line) {
+    for (const auto& indicator : indicators) {
+      if (line.find(indicator) != std::string_view::npos) {
+        found = true;
+        return false;
+      }
+    }
+    return true;
+  });
+  return found;
+}
+
+template <typename Function>
+void Run(const char* name, long iterations, Function&& function) {
+  // Warm up caches and any lazily opened descriptors.
+  function();
+
+  const long allocations_before = allocation_count.load();
+  const auto start = std::chrono::steady_clock::now();
+  for (long i = 0; i < iterations; ++i) {
+    volatile auto sink = function();
+    (void)sink;
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const long allocations = allocation_count.load() - allocations_before;
+
+  const double ns =
+      std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  std::printf("%-24s %12.0f ns/op %10.2f allocs/op\n", name, ns,
+              static_cast<double>(allocations) / iterations);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const long iterations = argc > 1 ? std::atol(argv[1]) : 20000;
+
+  Run("legacy/TracerPid", iterations, LegacyTracerPid);
+  Run("proc_reader/TracerPid", iterations, TracerPid);
+  Run("legacy/PrettyName", iterations, [] { return LegacyPrettyName().size(); });
+  Run("proc_reader/PrettyName", iterations, PrettyName);
+  Run("legacy/CpuInfoScan", iterations / 10, LegacyCpuInfoScan);
+  Run("proc_reader/CpuInfoScan", iterations / 10, CpuInfoScan);
+  return 0;
+}
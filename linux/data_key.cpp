@@ -0,0 +1,127 @@
+#include "data_key.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <openssl/rand.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr const char* kPluginDirectoryName = "ultra_secure_flutter_kit";
+constexpr const char* kKeyFileName = "data.key";
+
+bool MakeDirectory(const std::string& path) {
+  return mkdir(path.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+// Creates `path` and any missing parents, as the XDG base directory spec
+// asks: ~/.local/share does not exist on a fresh account.
+bool MakeDirectories(const std::string& path) {
+  for (size_t slash = path.find('/', 1); slash != std::string::npos;
+       slash = path.find('/', slash + 1)) {
+    if (!MakeDirectory(path.substr(0, slash))) {
+      return false;
+    }
+  }
+  return MakeDirectory(path);
+}
+
+std::string ExecutableName() {
+  char buffer[4096];
+  const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+  if (length <= 0) {
+    return "flutter_app";
+  }
+  const std::string path(buffer, static_cast<size_t>(length));
+  return path.substr(path.rfind('/') + 1);
+}
+
+bool ReadKey(const std::string& path, uint8_t* key) {
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+  if (fd < 0) {
+    return false;
+  }
+  size_t done = 0;
+  while (done < kDataKeySize) {
+    const ssize_t count = read(fd, key + done, kDataKeySize - done);
+    if (count <= 0) {
+      break;
+    }
+    done += static_cast<size_t>(count);
+  }
+  // Exactly kDataKeySize bytes; a longer file is not ours.
+  char extra;
+  const bool valid = done == kDataKeySize && read(fd, &extra, 1) == 0;
+  close(fd);
+  return valid;
+}
+
+// Writes a fresh key to a temporary file and links it into place, so a
+// crash never leaves a short key file and two processes starting at once
+// agree on one key: the loser of the link() reads the winner's.
+bool CreateKey(const std::string& path, uint8_t* key) {
+  if (RAND_bytes(key, static_cast<int>(kDataKeySize)) != 1) {
+    return false;
+  }
+  std::string temporary = path + ".XXXXXX";
+  // Created with mode 0600.
+  const int fd = mkostemp(temporary.data(), O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  const bool written =
+      write(fd, key, kDataKeySize) == static_cast<ssize_t>(kDataKeySize) &&
+      fsync(fd) == 0;
+  close(fd);
+  const bool linked = written && link(temporary.c_str(), path.c_str()) == 0;
+  const bool lost_race = written && !linked && errno == EEXIST;
+  unlink(temporary.c_str());
+  return linked || (lost_race && ReadKey(path, key));
+}
+
+}  // namespace
+
+std::string PluginDataDirectory() {
+  std::string directory;
+  if (const char* data_home = getenv("XDG_DATA_HOME");
+      data_home != nullptr && data_home[0] == '/') {
+    directory = data_home;
+  } else if (const char* home = getenv("HOME"); home != nullptr) {
+    directory = std::string(home) + "/.local/share";
+  } else {
+    return std::string();
+  }
+  directory += "/" + ExecutableName() + "/" + kPluginDirectoryName;
+  return MakeDirectories(directory) ? directory : std::string();
+}
+
+const SecureVector<uint8_t>& DataKey() {
+  static std::mutex mutex;
+  static SecureVector<uint8_t>* key = nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (key != nullptr) {
+    return *key;
+  }
+  const std::string directory = PluginDataDirectory();
+  if (directory.empty()) {
+    throw std::runtime_error("no data directory for the encryption key");
+  }
+  const std::string path = directory + "/" + kKeyFileName;
+  auto loaded = std::make_unique<SecureVector<uint8_t>>(kDataKeySize);
+  if (!ReadKey(path, loaded->data()) && !CreateKey(path, loaded->data())) {
+    throw std::runtime_error("cannot read or create " + path);
+  }
+  key = loaded.release();
+  return *key;
+}
+
+}  // namespace ultra_secure_flutter_kit
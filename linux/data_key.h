@@ -0,0 +1,34 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_DATA_KEY_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_DATA_KEY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "secure_memory.h"
+
+namespace ultra_secure_flutter_kit {
+
+constexpr size_t kDataKeySize = 32;
+
+// Directory for the plugin's persistent files:
+// $XDG_DATA_HOME/<executable name>/ultra_secure_flutter_kit, by default
+// under ~/.local/share. Created with mode 0700 on first use. Empty if it
+// cannot be created.
+std::string PluginDataDirectory();
+
+// The 256-bit root key that encryptSensitiveData and the secure store
+// derive their keys from.
+//
+// Generated from the OpenSSL CSPRNG on first use and kept in
+// PluginDataDirectory()/data.key, mode 0600, so data encrypted in one run
+// can be read in the next. This protects against other users of the
+// machine and against copies of the data files alone, not against code
+// running as the same user. Loaded once into SecureArena memory.
+//
+// Throws std::runtime_error if the key can be neither read nor created.
+const SecureVector<uint8_t>& DataKey();
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_DATA_KEY_H_
@@ -0,0 +1,369 @@
+#include "debug_watchdog.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/prctl.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr int64_t kNanosPerMilli = 1000000;
+
+// Exit codes of the probe helper.
+constexpr int kProbeAttached = 0;
+constexpr int kProbeRefused = 1;
+
+int64_t MonotonicNanos() {
+  // CLOCK_MONOTONIC is served from the vDSO, and unlike a raw TSC read it
+  // does not advance while the machine is suspended, so a laptop lid
+  // closing is not mistaken for a stall.
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+int64_t ThreadCpuNanos() {
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+int64_t WallMillis() {
+  timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000 + now.tv_nsec / kNanosPerMilli;
+}
+
+// 0 allows any same-user tracer, 1 only ancestors and processes named with
+// PR_SET_PTRACER, 2 only CAP_SYS_PTRACE, 3 nobody. 0 without Yama.
+long YamaPtraceScope() {
+  char buffer[16];
+  long scope = 0;
+  ParseInt(ReadFile("/proc/sys/kernel/yama/ptrace_scope", buffer,
+                    sizeof(buffer)),
+           &scope);
+  return scope;
+}
+
+}  // namespace
+
+const char* DebugSignalName(DebugSignal signal) {
+  switch (signal) {
+    case DebugSignal::kTracerPid:
+      return "tracerPid";
+    case DebugSignal::kAttachProbe:
+      return "attachProbe";
+    case DebugSignal::kDumpableReset:
+      return "dumpableReset";
+    case DebugSignal::kStall:
+      return "stall";
+  }
+  return "unknown";
+}
+
+DebugWatchdog& DebugWatchdog::Instance() {
+  static DebugWatchdog* instance = new DebugWatchdog();
+  return *instance;
+}
+
+DebugWatchdog::DebugWatchdog()
+    : wake_fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {}
+
+DebugWatchdog::~DebugWatchdog() {
+  Stop();
+  if (wake_fd_ >= 0) {
+    close(wake_fd_);
+  }
+}
+
+void DebugWatchdog::Start(const DebugWatchdogOptions& options,
+                          EventCallback callback) {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  StopLocked();
+
+  options_ = options;
+  options_.min_interval =
+      std::max(options_.min_interval, std::chrono::milliseconds(1));
+  options_.max_interval =
+      std::max(options_.max_interval, options_.min_interval);
+  callback_ = std::move(callback);
+
+  if (options_.deny_attach) {
+    previous_dumpable_ = prctl(PR_GET_DUMPABLE, 0, 0, 0, 0);
+    prctl(PR_SET_DUMPABLE, 0, 0, 0, 0);
+  }
+  // A non-dumpable process refuses the helper as it would a debugger, and
+  // with scope 2 or more only root may attach at all.
+  probe_enabled_ = !options_.deny_attach &&
+                   options_.probe_interval.count() > 0 &&
+                   YamaPtraceScope() < 2;
+  next_probe_ms_ = 0;
+  cost_ns_ = 0;
+  stalls_ = 0;
+  tracer_pid_ = 0;
+  hidden_tracer_ = false;
+  ticks_ = 0;
+  probes_ = 0;
+  cpu_us_ = 0;
+  interval_ms_ = options_.min_interval.count();
+
+  running_ = true;
+  thread_ = std::thread(&DebugWatchdog::Run, this);
+}
+
+void DebugWatchdog::Stop() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  StopLocked();
+}
+
+void DebugWatchdog::StopLocked() {
+  if (!running_.exchange(false)) {
+    return;
+  }
+  Wake();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (options_.deny_attach && previous_dumpable_ > 0) {
+    prctl(PR_SET_DUMPABLE, previous_dumpable_, 0, 0, 0);
+  }
+  previous_dumpable_ = -1;
+}
+
+void DebugWatchdog::Wake() {
+  const uint64_t one = 1;
+  // write() is async-signal-safe; a full counter already means "wake up".
+  if (write(wake_fd_, &one, sizeof(one)) < 0) {
+    return;
+  }
+}
+
+DebugWatchdogStats DebugWatchdog::GetStats() const {
+  DebugWatchdogStats stats;
+  stats.ticks = ticks_.load();
+  stats.probes = probes_.load();
+  stats.interval_ms = interval_ms_.load();
+  stats.cpu_us = cpu_us_.load();
+  return stats;
+}
+
+void DebugWatchdog::Run() {
+  const int64_t min_ns = options_.min_interval.count() * kNanosPerMilli;
+  const int64_t max_ns = options_.max_interval.count() * kNanosPerMilli;
+  const int64_t stall_ns = options_.stall_threshold.count() * kNanosPerMilli;
+  const int64_t cpu_start = ThreadCpuNanos();
+  int64_t cpu_last = cpu_start;
+
+  int64_t interval_ns = min_ns;
+  int64_t deadline = MonotonicNanos();
+  while (running_.load()) {
+    const int64_t remaining = deadline - MonotonicNanos();
+    const int timeout_ms = static_cast<int>(
+        std::max<int64_t>(remaining + kNanosPerMilli - 1, 0) / kNanosPerMilli);
+    pollfd poll_fd{wake_fd_, POLLIN, 0};
+    const int ready = poll(&poll_fd, 1, timeout_ms);
+    if (!running_.load()) {
+      break;
+    }
+    if (ready > 0) {
+      uint64_t value;
+      while (read(wake_fd_, &value, sizeof(value)) > 0) {
+      }
+    }
+
+    const int64_t tick_start = MonotonicNanos();
+    bool suspicious = Tick();
+    const int64_t tick_end = MonotonicNanos();
+
+    // Only a timed wake-up has a schedule to be late against; the thread
+    // is runnable the whole time, so being this late means every thread of
+    // the process was held, or the host was starved. A tracer's stop can
+    // end the wait with EINTR rather than a timeout. The tick runs first
+    // so a tracer it finds, or one it sees leave, confirms the stall at
+    // once.
+    const int64_t late = ready <= 0 ? tick_start - deadline : 0;
+    const int64_t stall = std::max(late, tick_end - tick_start);
+    if (stall >= stall_ns) {
+      RecordStall(stall, tick_end, suspicious || IsTraced());
+      suspicious = true;
+    }
+
+    // The probe forks and waits for its helper, which a busy machine can
+    // take longer than the stall threshold over, so it is left out of the
+    // tick's time and the next deadline is set after it.
+    const int64_t now_ms = WallMillis();
+    if (probe_enabled_ && now_ms >= next_probe_ms_ &&
+        tracer_pid_.load() == 0) {
+      next_probe_ms_ = now_ms + options_.probe_interval.count();
+      suspicious |= RunAttachProbe();
+    }
+    const int64_t cpu_after = ThreadCpuNanos();
+
+    // The wake-up is charged too; on some hosts it costs more than the
+    // tick itself.
+    const int64_t cost = cpu_after - cpu_last;
+    cpu_last = cpu_after;
+    cost_ns_ = cost_ns_ == 0 ? cost : (cost_ns_ * 7 + cost) / 8;
+    ticks_.fetch_add(1, std::memory_order_relaxed);
+    cpu_us_ = (cpu_after - cpu_start) / 1000;
+
+    interval_ns = suspicious ? min_ns : std::min(interval_ns * 3 / 2, max_ns);
+    interval_ns = std::max(
+        interval_ns,
+        static_cast<int64_t>(static_cast<double>(cost_ns_) /
+                             std::max(options_.cpu_fraction, 1e-6)));
+    interval_ms_ = interval_ns / kNanosPerMilli;
+    deadline = MonotonicNanos() + interval_ns;
+  }
+}
+
+bool DebugWatchdog::Tick() {
+  bool suspicious = CheckTracerPid();
+  if (options_.deny_attach) {
+    suspicious |= CheckDumpable();
+  }
+  return suspicious;
+}
+
+void DebugWatchdog::RecordStall(int64_t stall_ns, int64_t now_ns,
+                                bool corroborated) {
+  const int64_t window_ns =
+      static_cast<int64_t>(options_.stall_window.count()) * kNanosPerMilli;
+  if (stalls_ == 0 || now_ns - stall_window_start_ns_ > window_ns) {
+    stalls_ = 0;
+    stall_window_start_ns_ = now_ns;
+    longest_stall_ns_ = 0;
+  }
+  ++stalls_;
+  longest_stall_ns_ = std::max(longest_stall_ns_, stall_ns);
+  if (stalls_ < options_.stall_repeats && !corroborated) {
+    return;
+  }
+
+  DebugEvent event;
+  event.signal = DebugSignal::kStall;
+  event.stall_ms = longest_stall_ns_ / kNanosPerMilli;
+  stalls_ = 0;
+  Emit(event);
+}
+
+bool DebugWatchdog::CheckTracerPid() {
+  long tracer_pid = 0;
+  if (!ReadSelfStatusField("TracerPid", &tracer_pid)) {
+    return false;
+  }
+  const pid_t previous = tracer_pid_.exchange(static_cast<pid_t>(tracer_pid));
+  if (previous == tracer_pid) {
+    return false;
+  }
+  DebugEvent event;
+  event.signal = DebugSignal::kTracerPid;
+  event.attached = tracer_pid != 0;
+  event.tracer_pid = static_cast<pid_t>(event.attached ? tracer_pid : previous);
+  Emit(event);
+  return true;
+}
+
+bool DebugWatchdog::CheckDumpable() {
+  if (prctl(PR_GET_DUMPABLE, 0, 0, 0, 0) == 0) {
+    return false;
+  }
+  prctl(PR_SET_DUMPABLE, 0, 0, 0, 0);
+  DebugEvent event;
+  event.signal = DebugSignal::kDumpableReset;
+  Emit(event);
+  return true;
+}
+
+bool DebugWatchdog::RunAttachProbe() {
+  // PTRACE_TRACEME would make the helper our tracee, not our tracer, so a
+  // child attaches to us instead. Yama only lets descendants attach when
+  // named with PR_SET_PTRACER, which needs the child's pid, so the child
+  // waits on a pipe until the parent has named it.
+  int gate[2];
+  if (pipe2(gate, O_CLOEXEC) < 0) {
+    return false;
+  }
+  const pid_t parent = getpid();
+  const pid_t child = fork();
+  if (child < 0) {
+    close(gate[0]);
+    close(gate[1]);
+    return false;
+  }
+  if (child == 0) {
+    // Only async-signal-safe calls from here on.
+    close(gate[1]);
+    char go;
+    if (read(gate[0], &go, 1) != 1) {
+      _exit(2);
+    }
+    if (ptrace(PTRACE_SEIZE, parent, nullptr, nullptr) == 0) {
+      _exit(kProbeAttached);  // exiting detaches
+    }
+    _exit(errno == EPERM ? kProbeRefused : 2);
+  }
+
+  close(gate[0]);
+  prctl(PR_SET_PTRACER, child, 0, 0, 0);
+  const char go = 1;
+  const bool signalled = write(gate[1], &go, 1) == 1;
+  close(gate[1]);
+  int status = 0;
+  while (waitpid(child, &status, 0) < 0 && errno == EINTR) {
+  }
+  prctl(PR_SET_PTRACER, 0, 0, 0, 0);
+  probes_.fetch_add(1, std::memory_order_relaxed);
+  const bool first = probes_.load() == 1;
+
+  if (!signalled || !WIFEXITED(status) ||
+      WEXITSTATUS(status) > kProbeRefused) {
+    // Killed by a seccomp filter or otherwise unable to say; stop trying.
+    probe_enabled_ = false;
+    return false;
+  }
+  if (WEXITSTATUS(status) == kProbeAttached) {
+    hidden_tracer_ = false;
+    return false;
+  }
+  if (first) {
+    // Refused from the start: a sandbox or LSM policy rather than a tracer
+    // that appeared while we watched.
+    probe_enabled_ = false;
+    return false;
+  }
+  // A tracer may have attached between the TracerPid read and the probe.
+  long tracer_pid = 0;
+  if (ReadSelfStatusField("TracerPid", &tracer_pid) && tracer_pid != 0) {
+    return CheckTracerPid();
+  }
+  const bool reported = hidden_tracer_.exchange(true);
+  if (!reported) {
+    DebugEvent event;
+    event.signal = DebugSignal::kAttachProbe;
+    event.attached = true;
+    Emit(event);
+  }
+  // Keep probing; a hidden tracer that leaves shows up as a success.
+  return true;
+}
+
+void DebugWatchdog::Emit(DebugEvent event) {
+  event.timestamp_ms = WallMillis();
+  if (callback_) {
+    callback_(event);
+  }
+}
+
+}  // namespace ultra_secure_flutter_kit
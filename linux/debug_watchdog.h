@@ -0,0 +1,150 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_DEBUG_WATCHDOG_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_DEBUG_WATCHDOG_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ultra_secure_flutter_kit {
+
+struct DebugWatchdogOptions {
+  // Share of one core the watchdog may use, e.g. 0.0005 for 0.05 %. The
+  // interval is stretched as far as needed to stay under it.
+  double cpu_fraction = 0.0005;
+  // Polling interval bounds. The watchdog starts at `min_interval`, backs
+  // off towards `max_interval` while nothing happens and drops back to
+  // `min_interval` after any signal.
+  std::chrono::milliseconds min_interval{10};
+  std::chrono::milliseconds max_interval{250};
+  // A wake-up this much later than scheduled, or a tick that takes this
+  // long, means the process may have been stopped (SIGSTOP, a breakpoint,
+  // a single-stepping tracer).
+  std::chrono::milliseconds stall_threshold{200};
+  // A loaded or throttled host misses the odd deadline too, so a stall is
+  // only reported once `stall_repeats` of them fall within `stall_window`,
+  // or at once when the same tick sees a tracer.
+  int stall_repeats = 3;
+  std::chrono::milliseconds stall_window{10000};
+  // Clears PR_SET_DUMPABLE, which makes /proc/<pid>/mem unreadable and
+  // ptrace attach fail for non-root tracers, and reports anything that
+  // sets it again. Also turns off core dumps.
+  bool deny_attach = false;
+  // How often to test attaching to ourselves from a helper process.
+  std::chrono::milliseconds probe_interval{30000};
+};
+
+enum class DebugSignal : uint8_t {
+  kTracerPid,      // TracerPid changed; `attached` tells which way
+  kAttachProbe,    // the self-attach probe was refused with no tracer shown
+  kDumpableReset,  // PR_SET_DUMPABLE was turned back on behind our back
+  kStall,          // the watchdog thread repeatedly did not run for a while
+};
+
+const char* DebugSignalName(DebugSignal signal);
+
+struct DebugEvent {
+  DebugSignal signal = DebugSignal::kTracerPid;
+  bool attached = false;
+  pid_t tracer_pid = 0;
+  int64_t stall_ms = 0;  // the longest of the stalls reported
+  int64_t timestamp_ms = 0;  // wall clock
+};
+
+struct DebugWatchdogStats {
+  uint64_t ticks = 0;
+  uint64_t probes = 0;
+  int64_t interval_ms = 0;  // current polling interval
+  int64_t cpu_us = 0;       // thread CPU time used since Start()
+};
+
+// Watches for debuggers from a background thread so checks can answer
+// from memory.
+//
+// Each tick re-reads TracerPid through the kept-open /proc/self/status
+// descriptor (one pread), compares the monotonic clock against the
+// scheduled wake-up to spot the whole process having been stopped, and
+// when `deny_attach` is set verifies the dumpable flag. The probe below
+// is timed apart from the tick, so its fork and wait never count as a
+// stall. Every
+// `probe_interval` a forked helper tries PTRACE_SEIZE on this process; a
+// refusal while TracerPid reads 0 means a tracer the status file does not
+// show. PTRACE_ATTACH notifications from the proc connector call Wake(),
+// so attaches are seen immediately rather than on the next tick.
+//
+// The interval adapts between the option bounds and never drops below
+// the measured CPU cost of a wake-up and tick divided by `cpu_fraction`,
+// so the watchdog stays inside its budget on slow machines too.
+class DebugWatchdog {
+ public:
+  using EventCallback = std::function<void(const DebugEvent&)>;
+
+  // The watchdog the plugin and the C API answer from.
+  static DebugWatchdog& Instance();
+
+  DebugWatchdog();
+  ~DebugWatchdog();
+
+  DebugWatchdog(const DebugWatchdog&) = delete;
+  DebugWatchdog& operator=(const DebugWatchdog&) = delete;
+
+  // Starts the watchdog thread, restarting with the new options and
+  // callback if already running. The callback runs on the watchdog
+  // thread.
+  void Start(const DebugWatchdogOptions& options, EventCallback callback);
+  // Stops the thread and restores the dumpable flag.
+  void Stop();
+  // Runs a tick now. Safe to call from any thread, including signal
+  // handlers and the proc connector thread.
+  void Wake();
+
+  bool IsRunning() const { return running_.load(); }
+  // As of the last tick; only meaningful while running.
+  bool IsTraced() const { return tracer_pid_.load() != 0 || hidden_tracer_; }
+  pid_t TracerPid() const { return tracer_pid_.load(); }
+  DebugWatchdogStats GetStats() const;
+
+ private:
+  void StopLocked();
+  void Run();
+  // Returns whether anything suspicious was seen.
+  bool Tick();
+  // Counts a stall of `stall_ns` seen at `now_ns` and reports it once
+  // repeated, or at once when `corroborated` by a tracer in the same tick.
+  void RecordStall(int64_t stall_ns, int64_t now_ns, bool corroborated);
+  bool CheckTracerPid();
+  bool CheckDumpable();
+  bool RunAttachProbe();
+  void Emit(DebugEvent event);
+
+  DebugWatchdogOptions options_;
+  EventCallback callback_;
+  std::mutex start_mutex_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  int wake_fd_ = -1;
+
+  // Owned by the watchdog thread.
+  bool probe_enabled_ = true;
+  int64_t next_probe_ms_ = 0;
+  int64_t cost_ns_ = 0;  // moving average of one tick's CPU time
+  int previous_dumpable_ = -1;
+  int stalls_ = 0;  // unreported stalls since stall_window_start_ns_
+  int64_t stall_window_start_ns_ = 0;
+  int64_t longest_stall_ns_ = 0;
+
+  std::atomic<pid_t> tracer_pid_{0};
+  std::atomic<bool> hidden_tracer_{false};
+  std::atomic<uint64_t> ticks_{0};
+  std::atomic<uint64_t> probes_{0};
+  std::atomic<int64_t> interval_ms_{0};
+  std::atomic<int64_t> cpu_us_{0};
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_DEBUG_WATCHDOG_H_
@@ -0,0 +1,261 @@
+#include "emulator_detector.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <queue>
+#include <string_view>
+#include <vector>
+
+#include "filesystem_root.h"
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr double kCpuidVendorConfidence = 0.99;
+constexpr double kCpuidHypervisorConfidence = 0.9;
+constexpr double kDmiConfidence = 0.8;
+constexpr double kCpuInfoConfidence = 0.7;
+constexpr double kCpuInfoFullScanConfidence = 0.5;
+
+// Aho-Corasick automaton flattened into a full DFA, so matching is one
+// table lookup per input byte regardless of how many patterns there are.
+class MultiPatternMatcher {
+ public:
+  MultiPatternMatcher(std::initializer_list<const char*> patterns)
+      : patterns_(patterns) {
+    next_.emplace_back();
+    next_[0].fill(-1);
+    output_.push_back(-1);
+
+    for (size_t index = 0; index < patterns_.size(); ++index) {
+      int state = 0;
+      for (const char* c = patterns_[index]; *c != '\0'; ++c) {
+        const auto byte = static_cast<unsigned char>(*c);
+        if (next_[state][byte] < 0) {
+          next_[state][byte] = static_cast<int16_t>(next_.size());
+          next_.emplace_back();
+          next_.back().fill(-1);
+          output_.push_back(-1);
+        }
+        state = next_[state][byte];
+      }
+      output_[state] = static_cast<int>(index);
+    }
+
+    // Breadth-first pass: fill missing transitions from the failure link
+    // and inherit the failure state's match.
+    std::vector<int> failure(next_.size(), 0);
+    std::queue<int> pending;
+    for (auto& target : next_[0]) {
+      if (target < 0) {
+        target = 0;
+      } else {
+        pending.push(target);
+      }
+    }
+    while (!pending.empty()) {
+      const int state = pending.front();
+      pending.pop();
+      if (output_[state] < 0) {
+        output_[state] = output_[failure[state]];
+      }
+      for (int byte = 0; byte < 256; ++byte) {
+        const int target = next_[state][byte];
+        if (target < 0) {
+          next_[state][byte] = next_[failure[state]][byte];
+        } else {
+          failure[target] = next_[failure[state]][byte];
+          pending.push(target);
+        }
+      }
+    }
+  }
+
+  // Returns the pattern that occurs first in `text`, or nullptr.
+  const char* Find(std::string_view text) const {
+    int state = 0;
+    for (const char c : text) {
+      state = next_[state][static_cast<unsigned char>(c)];
+      if (output_[state] >= 0) {
+        return patterns_[output_[state]];
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  std::vector<const char*> patterns_;
+  std::vector<std::array<int16_t, 256>> next_;
+  std::vector<int> output_;
+};
+
+const MultiPatternMatcher& CpuInfoMatcher() {
+  static const MultiPatternMatcher matcher = {
+      "VMware", "VirtualBox", "QEMU", "Xen", "KVM", "hypervisor"};
+  return matcher;
+}
+
+const MultiPatternMatcher& DmiMatcher() {
+  static const MultiPatternMatcher matcher = {
+      "VMware",        "VirtualBox", "innotek",         "QEMU",
+      "Xen",           "KVM",        "Bochs",           "Parallels",
+      "Virtual Machine", "Amazon EC2", "Google Compute Engine", "OpenStack"};
+  return matcher;
+}
+
+EmulatorDetection Detected(EmulatorSource source, double confidence,
+                           std::string vendor) {
+  EmulatorDetection detection;
+  detection.detected = true;
+  detection.confidence = confidence;
+  detection.source = source;
+  detection.vendor = std::move(vendor);
+  return detection;
+}
+
+bool DetectFromCpuid(EmulatorDetection* detection) {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & (1u << 31)) == 0) {
+    return false;
+  }
+
+  // Hypervisors publish a 12-byte signature in EBX:ECX:EDX of leaf
+  // 0x40000000, outside the range __get_cpuid() validates.
+  __cpuid(0x40000000, eax, ebx, ecx, edx);
+  char signature[13] = {0};
+  memcpy(signature + 0, &ebx, 4);
+  memcpy(signature + 4, &ecx, 4);
+  memcpy(signature + 8, &edx, 4);
+
+  static const struct {
+    const char* signature;
+    const char* vendor;
+  } kVendors[] = {
+      {"KVMKVMKVM", "KVM"},          {"VMwareVMware", "VMware"},
+      {"Microsoft Hv", "Hyper-V"},   {"XenVMMXenVMM", "Xen"},
+      {"VBoxVBoxVBox", "VirtualBox"}, {"TCGTCGTCGTCG", "QEMU"},
+      {"prl hyperv  ", "Parallels"}, {"ACRNACRNACRN", "ACRN"},
+      {"bhyve bhyve ", "bhyve"},     {"QNXQVMBSQG", "QNX"},
+  };
+  for (const auto& known : kVendors) {
+    if (strncmp(signature, known.signature, 12) == 0) {
+      *detection = Detected(EmulatorSource::kCpuidVendor,
+                            kCpuidVendorConfidence, known.vendor);
+      return true;
+    }
+  }
+  *detection = Detected(EmulatorSource::kCpuidHypervisor,
+                        kCpuidHypervisorConfidence, signature);
+  return true;
+#else
+  (void)detection;
+  return false;
+#endif
+}
+
+bool DetectFromDmi(EmulatorDetection* detection) {
+  for (const char* path : {"/sys/class/dmi/id/sys_vendor",
+                           "/sys/class/dmi/id/product_name"}) {
+    char buffer[256];
+    const std::string_view value =
+        ReadFile(RootedPath(path).c_str(), buffer, sizeof(buffer));
+    if (const char* match = DmiMatcher().Find(value)) {
+      *detection = Detected(EmulatorSource::kDmi, kDmiConfidence, match);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns false if /proc/cpuinfo had no processor block to bound the scan.
+bool DetectFromCpuInfo(EmulatorDetection* detection) {
+  const MultiPatternMatcher& matcher = CpuInfoMatcher();
+  const char* match = nullptr;
+  bool in_block = false;
+  bool block_complete = false;
+
+  const RootedPath cpuinfo("/proc/cpuinfo");
+  ScanLines(cpuinfo.c_str(), [&](std::string_view line) {
+    if (line.substr(0, 9) == "processor") {
+      in_block = true;
+    } else if (line.empty() && in_block) {
+      // Every processor repeats the same vendor fields; one block is
+      // enough.
+      block_complete = true;
+      return false;
+    }
+    match = matcher.Find(line);
+    return match == nullptr;
+  });
+
+  if (match != nullptr) {
+    *detection = Detected(EmulatorSource::kCpuInfo, kCpuInfoConfidence, match);
+  }
+  return match != nullptr || block_complete;
+}
+
+}  // namespace
+
+const char* EmulatorSourceName(EmulatorSource source) {
+  switch (source) {
+    case EmulatorSource::kNone:
+      return "none";
+    case EmulatorSource::kCpuidVendor:
+      return "cpuidVendor";
+    case EmulatorSource::kCpuidHypervisor:
+      return "cpuidHypervisor";
+    case EmulatorSource::kDmi:
+      return "dmi";
+    case EmulatorSource::kCpuInfo:
+      return "cpuinfo";
+    case EmulatorSource::kCpuInfoFullScan:
+      return "cpuinfoFullScan";
+  }
+  return "unknown";
+}
+
+EmulatorDetection DetectEmulator() {
+  EmulatorDetection detection;
+  if (DetectFromCpuid(&detection)) {
+    return detection;
+  }
+  return DetectEmulatorFromFiles();
+}
+
+EmulatorDetection DetectEmulatorFromFiles() {
+  EmulatorDetection detection;
+  if (DetectFromDmi(&detection) || DetectFromCpuInfo(&detection)) {
+    return detection;
+  }
+  return ScanCpuInfoLegacy();
+}
+
+EmulatorDetection ScanCpuInfoLegacy() {
+  static constexpr std::string_view vm_indicators[] = {
+      "VMware", "VirtualBox", "QEMU", "Xen", "KVM"};
+
+  EmulatorDetection detection;
+  const RootedPath cpuinfo("/proc/cpuinfo");
+  ScanLines(cpuinfo.c_str(), [&detection](std::string_view line) {
+    for (const auto& indicator : vm_indicators) {
+      if (line.find(indicator) != std::string_view::npos) {
+        detection = Detected(EmulatorSource::kCpuInfoFullScan,
+                             kCpuInfoFullScanConfidence,
+                             std::string(indicator));
+        return false;
+      }
+    }
+    return true;
+  });
+  return detection;
+}
+
+}  // namespace ultra_secure_flutter_kit
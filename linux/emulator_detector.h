@@ -0,0 +1,49 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_EMULATOR_DETECTOR_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_EMULATOR_DETECTOR_H_
+
+#include <string>
+
+namespace ultra_secure_flutter_kit {
+
+// Where a virtual-machine verdict came from, cheapest and most reliable
+// first.
+enum class EmulatorSource {
+  kNone,
+  kCpuidVendor,      // CPUID leaf 0x40000000 names a known hypervisor
+  kCpuidHypervisor,  // CPUID.1:ECX[31] set, vendor unknown
+  kDmi,              // /sys/class/dmi/id/{sys_vendor,product_name}
+  kCpuInfo,          // first processor block of /proc/cpuinfo
+  kCpuInfoFullScan,  // legacy scan of every /proc/cpuinfo line
+};
+
+const char* EmulatorSourceName(EmulatorSource source);
+
+struct EmulatorDetection {
+  bool detected = false;
+  // 0.0 when nothing was found, otherwise how strongly `source` implies a
+  // virtual machine.
+  double confidence = 0.0;
+  EmulatorSource source = EmulatorSource::kNone;
+  // The matched hypervisor or vendor string, if any.
+  std::string vendor;
+};
+
+// Runs the tiers in order and stops at the first one that answers:
+//   1. CPUID hypervisor bit and vendor signature (x86 only, no syscalls)
+//   2. DMI vendor/product strings (two small sysfs reads)
+//   3. A single-pass multi-pattern scan of /proc/cpuinfo that stops after
+//      the first processor block
+// If /proc/cpuinfo has no processor block to stop at, the original
+// substring scan over the whole file is used instead.
+EmulatorDetection DetectEmulator();
+
+// Tiers 2 and 3 and the fallback only, for hosts (and benchmarks) where
+// CPUID has nothing to say.
+EmulatorDetection DetectEmulatorFromFiles();
+
+// The original IsEmulator() scan, kept as the last-resort tier.
+EmulatorDetection ScanCpuInfoLegacy();
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_EMULATOR_DETECTOR_H_
@@ -0,0 +1,37 @@
+#include "filesystem_root.h"
+
+#include <cstring>
+#include <string>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+std::string& Root() {
+  static std::string* root = new std::string();
+  return *root;
+}
+
+}  // namespace
+
+void SetFilesystemRoot(std::string_view root) {
+  while (!root.empty() && root.back() == '/') {
+    root.remove_suffix(1);
+  }
+  Root().assign(root.data(), root.size());
+}
+
+std::string_view FilesystemRoot() { return Root(); }
+
+RootedPath::RootedPath(std::string_view absolute_path) {
+  const std::string_view root = FilesystemRoot();
+  if (root.size() + absolute_path.size() >= sizeof(path_)) {
+    path_[0] = '\0';
+    return;
+  }
+  memcpy(path_, root.data(), root.size());
+  memcpy(path_ + root.size(), absolute_path.data(), absolute_path.size());
+  path_[root.size() + absolute_path.size()] = '\0';
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,38 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_FILESYSTEM_ROOT_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_FILESYSTEM_ROOT_H_
+
+#include <limits.h>
+
+#include <string_view>
+
+namespace ultra_secure_flutter_kit {
+
+// Directory prepended to the system paths the checks inspect (/proc/cpuinfo,
+// /sys/..., /etc/..., /usr/bin/...), so they can be run against a fixture
+// tree. Empty, meaning the real root, unless a benchmark or test changes
+// it; it is deliberately not configurable from the environment. Must be
+// set before the first check runs, since readers do not synchronise with
+// the change. Paths about the calling process (/proc/self/...) are never
+// redirected.
+void SetFilesystemRoot(std::string_view root);
+std::string_view FilesystemRoot();
+
+// An absolute system path resolved under FilesystemRoot(), built in place
+// so a probe costs no allocation. Yields "" if the result would not fit in
+// PATH_MAX, which makes the lookup fail like a missing file.
+class RootedPath {
+ public:
+  explicit RootedPath(std::string_view absolute_path);
+
+  RootedPath(const RootedPath&) = delete;
+  RootedPath& operator=(const RootedPath&) = delete;
+
+  const char* c_str() const { return path_; }
+
+ private:
+  char path_[PATH_MAX];
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_FILESYSTEM_ROOT_H_
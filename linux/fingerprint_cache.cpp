@@ -0,0 +1,167 @@
+#include "fingerprint_cache.h"
+
+#include <openssl/evp.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "filesystem_root.h"
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+const char* const kOsReleasePath = "/etc/os-release";
+const char* const kMachineIdPath = "/etc/machine-id";
+const char* const kCpuInfoPath = "/proc/cpuinfo";
+const char* const kBootIdPath = "/proc/sys/kernel/random/boot_id";
+
+SecureString Sha256Hex(std::string_view data) {
+  unsigned char hash[EVP_MAX_MD_SIZE];
+  unsigned int hash_length = 0;
+  EVP_Digest(data.data(), data.size(), hash, &hash_length, EVP_sha256(),
+             nullptr);
+
+  SecureString result;
+  result.reserve(hash_length * 2);
+  for (unsigned int i = 0; i < hash_length; i++) {
+    result += "0123456789ABCDEF"[hash[i] / 16];
+    result += "0123456789ABCDEF"[hash[i] % 16];
+  }
+  SecureZero(hash, sizeof(hash));
+  return result;
+}
+
+std::string ReadFirstLine(const char* path) {
+  char buffer[kProcBufferSize];
+  const std::string_view content =
+      ReadFile(RootedPath(path).c_str(), buffer, sizeof(buffer));
+  return std::string(content.substr(0, content.find('\n')));
+}
+
+std::string ReadHostname() {
+  char hostname[256];
+  if (gethostname(hostname, sizeof(hostname)) == 0) {
+    hostname[sizeof(hostname) - 1] = '\0';
+    return hostname;
+  }
+  return std::string();
+}
+
+std::string ReadLinuxVersion() {
+  char buffer[kProcBufferSize];
+  const std::string_view content =
+      ReadFile(RootedPath(kOsReleasePath).c_str(), buffer, sizeof(buffer));
+  if (FindLine(content, "PRETTY_NAME=").empty()) {
+    return "Unknown";
+  }
+  return std::string(FindField(content, "PRETTY_NAME", '='));
+}
+
+std::string ReadFirstProcessorLine() {
+  std::string processor;
+  const RootedPath cpuinfo(kCpuInfoPath);
+  ScanLines(cpuinfo.c_str(), [&processor](std::string_view line) {
+    if (line.substr(0, 9) == "processor") {
+      processor.assign(line.data(), line.size());
+      return false;
+    }
+    return true;
+  });
+  return processor;
+}
+
+}  // namespace
+
+FingerprintCache& FingerprintCache::Instance() {
+  static FingerprintCache* instance = new FingerprintCache();
+  return *instance;
+}
+
+const DeviceIdentity& FingerprintCache::Get() {
+  const Entry* entry = current_.load(std::memory_order_acquire);
+  if (entry == nullptr) {
+    Refresh();
+    entry = current_.load(std::memory_order_acquire);
+  }
+  return entry->identity;
+}
+
+bool FingerprintCache::Refresh(bool force) {
+  std::lock_guard<std::mutex> lock(write_mutex_);
+
+  CacheKey key = ReadKey();
+  const Entry* current = current_.load(std::memory_order_relaxed);
+  if (!force && current != nullptr && key_ == key) {
+    return false;
+  }
+
+  auto entry = std::make_unique<Entry>();
+  entry->identity = Compute();
+  key_ = std::move(key);
+
+  const bool changed =
+      current == nullptr ||
+      current->identity.device_fingerprint !=
+          entry->identity.device_fingerprint ||
+      current->identity.linux_version != entry->identity.linux_version;
+  if (!changed) {
+    return false;
+  }
+
+  current_.store(entry.get(), std::memory_order_release);
+  entries_.push_back(std::move(entry));
+  while (entries_.size() > kRetiredEntries + 1) {
+    entries_.pop_front();
+  }
+  return true;
+}
+
+FingerprintCache::CacheKey FingerprintCache::ReadKey() {
+  CacheKey key;
+  key.boot_id = ReadFirstLine(kBootIdPath);
+  key.hostname = ReadHostname();
+
+  // /proc/cpuinfo is synthesised by the kernel, so boot_id covers it.
+  for (const char* path : {kOsReleasePath, kMachineIdPath}) {
+    FileKey file;
+    struct stat info;
+    if (stat(RootedPath(path).c_str(), &info) == 0) {
+      file.device = info.st_dev;
+      file.inode = info.st_ino;
+      file.mtime_ns = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 +
+                      info.st_mtim.tv_nsec;
+    }
+    key.files.push_back(file);
+  }
+  return key;
+}
+
+DeviceIdentity FingerprintCache::Compute() {
+  DeviceIdentity identity;
+  identity.linux_version = ReadLinuxVersion();
+
+  // The pre-image identifies the machine as well as the hash does, so it
+  // never touches the ordinary heap either.
+  SecureString fingerprint;
+  fingerprint += ReadHostname();
+  fingerprint += "|";
+  std::string machine_id = ReadFirstLine(kMachineIdPath);
+  fingerprint += machine_id;
+  SecureZero(machine_id.data(), machine_id.size());
+  fingerprint += "|";
+  const std::string processor = ReadFirstProcessorLine();
+  if (!processor.empty()) {
+    fingerprint += processor;
+    fingerprint += "|";
+  }
+  identity.device_fingerprint = Sha256Hex(fingerprint);
+
+  SecureString signature_input(identity.linux_version.begin(),
+                               identity.linux_version.end());
+  signature_input += identity.device_fingerprint;
+  identity.app_signature = Sha256Hex(signature_input);
+  return identity;
+}
+
+}  // namespace ultra_secure_flutter_kit
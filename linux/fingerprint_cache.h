@@ -0,0 +1,91 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_FINGERPRINT_CACHE_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_FINGERPRINT_CACHE_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "secure_memory.h"
+
+namespace ultra_secure_flutter_kit {
+
+// Values derived from the host that stay constant for the life of a boot.
+struct DeviceIdentity {
+  std::string linux_version;       // PRETTY_NAME from /etc/os-release
+  // Both held in SecureArena memory.
+  SecureString device_fingerprint;  // hex SHA-256 of hostname|machine-id|cpu
+  SecureString app_signature;       // hex SHA-256 of version + fingerprint
+};
+
+// Process-wide cache of DeviceIdentity.
+//
+// The identity is computed once and published through an atomic pointer,
+// so Get() is a single acquire load with no locking. It is keyed on the
+// kernel boot_id, the hostname and the inode/mtime of every file it was
+// derived from; Refresh() re-reads only that key and recomputes the hashes
+// when any part of it differs.
+class FingerprintCache {
+ public:
+  static FingerprintCache& Instance();
+
+  // The reference stays valid until the identity has changed twice more.
+  const DeviceIdentity& Get();
+
+  // Recomputes the identity if its key changed, or unconditionally when
+  // `force` is set. Returns true if the published identity changed.
+  bool Refresh(bool force = false);
+
+ private:
+  struct FileKey {
+    dev_t device = 0;
+    ino_t inode = 0;
+    int64_t mtime_ns = 0;
+
+    bool operator==(const FileKey& other) const {
+      return device == other.device && inode == other.inode &&
+             mtime_ns == other.mtime_ns;
+    }
+  };
+
+  struct CacheKey {
+    std::string boot_id;
+    std::string hostname;
+    std::vector<FileKey> files;
+
+    bool operator==(const CacheKey& other) const {
+      return boot_id == other.boot_id && hostname == other.hostname &&
+             files == other.files;
+    }
+  };
+
+  struct Entry {
+    DeviceIdentity identity;
+  };
+
+  // Superseded entries kept for readers still holding a reference.
+  static constexpr size_t kRetiredEntries = 2;
+
+  FingerprintCache() = default;
+
+  static CacheKey ReadKey();
+  static DeviceIdentity Compute();
+
+  std::atomic<const Entry*> current_{nullptr};
+  // Serialises writers, and guards everything below.
+  std::mutex write_mutex_;
+  CacheKey key_;
+  // The current entry last, after at most kRetiredEntries older ones. A
+  // recompute that yields the same identity only updates key_, so forced
+  // refreshes do not add entries.
+  std::deque<std::unique_ptr<Entry>> entries_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_FINGERPRINT_CACHE_H_
@@ -0,0 +1,366 @@
+#include "logger.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr size_t kRingCapacity = 128;  // power of two
+constexpr size_t kMaxRateEntries = 256;
+constexpr int64_t kRateWindowNs = 1000000000;
+constexpr char kLogFileVariable[] = "ULTRA_SECURE_FLUTTER_KIT_LOG_FILE";
+
+int64_t NowNanos() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t HashMessage(std::string_view text) {
+  uint64_t hash = 14695981039346656037ull;
+  for (const char c : text) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+char LevelLetter(LogLevel level) {
+  switch (level) {
+    case LogLevel::kDebug:
+      return 'D';
+    case LogLevel::kInfo:
+      return 'I';
+    case LogLevel::kWarning:
+      return 'W';
+    default:
+      return 'E';
+  }
+}
+
+void AppendLine(std::string* output, int64_t timestamp_ns, LogLevel level,
+                std::string_view text) {
+  const time_t seconds = static_cast<time_t>(timestamp_ns / 1000000000);
+  tm local{};
+  localtime_r(&seconds, &local);
+  char prefix[32];
+  const int length = snprintf(
+      prefix, sizeof(prefix), "%c %02d:%02d:%02d.%03d ", LevelLetter(level),
+      local.tm_hour, local.tm_min, local.tm_sec,
+      static_cast<int>(timestamp_ns / 1000000 % 1000));
+  output->append(prefix, static_cast<size_t>(length));
+  output->append(text);
+  output->push_back('\n');
+}
+
+// Set once this thread's RingOwner is destroyed. Trivially destructible,
+// so still readable from thread_local destructors that run after it.
+thread_local bool thread_ring_released = false;
+
+void WriteAll(int fd, const std::string& output) {
+  size_t written = 0;
+  while (written < output.size()) {
+    const ssize_t count =
+        write(fd, output.data() + written, output.size() - written);
+    if (count <= 0) {
+      return;
+    }
+    written += static_cast<size_t>(count);
+  }
+}
+
+}  // namespace
+
+bool ParseLogLevel(std::string_view name, LogLevel* level) {
+  static constexpr std::pair<std::string_view, LogLevel> kNames[] = {
+      {"debug", LogLevel::kDebug},     {"info", LogLevel::kInfo},
+      {"warning", LogLevel::kWarning}, {"error", LogLevel::kError},
+      {"off", LogLevel::kOff},
+  };
+  for (const auto& [candidate, value] : kNames) {
+    if (candidate == name) {
+      *level = value;
+      return true;
+    }
+  }
+  return false;
+}
+
+struct Logger::Record {
+  int64_t timestamp_ns;
+  LogLevel level;
+  uint16_t length;
+  char text[kMaxLogMessage];
+};
+
+// Single-producer, single-consumer: the owning thread advances `tail`,
+// the drain thread advances `head`.
+struct Logger::Ring {
+  std::atomic<size_t> head{0};
+  std::atomic<size_t> tail{0};
+  // Set when the owning thread exits; the drain thread frees the ring once
+  // it is empty.
+  std::atomic<bool> orphaned{false};
+  Record records[kRingCapacity];
+};
+
+class Logger::RingOwner {
+ public:
+  ~RingOwner() {
+    // The drain thread may free the ring from here on.
+    thread_ring_released = true;
+    if (ring != nullptr) {
+      ring->orphaned.store(true);
+      ring = nullptr;
+    }
+  }
+
+  Ring* ring = nullptr;
+};
+
+struct Logger::RateEntry {
+  uint64_t hash;
+  int64_t window_start_ns;
+  uint32_t count;
+  uint32_t suppressed;
+  LogLevel level;
+  std::string text;
+};
+
+Logger& Logger::Instance() {
+  // Never destroyed: threads may log while static destructors run.
+  static Logger* logger = [] {
+    auto* instance = new Logger();
+    std::atexit([] { Instance().Flush(); });
+    return instance;
+  }();
+  return *logger;
+}
+
+Logger::Logger() : level_(LogLevel::kInfo), fd_(STDERR_FILENO) {
+  if (const char* path = getenv(kLogFileVariable)) {
+    const int fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (fd >= 0) {
+      fd_ = fd;
+    }
+  }
+  thread_ = std::thread(&Logger::Run, this);
+}
+
+Logger::~Logger() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+  if (fd_ != STDERR_FILENO) {
+    close(fd_);
+  }
+}
+
+Logger::Ring* Logger::ThreadRing() {
+  if (thread_ring_released) {
+    return nullptr;
+  }
+  thread_local RingOwner owner;
+  if (owner.ring == nullptr) {
+    auto ring = std::make_unique<Ring>();
+    owner.ring = ring.get();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(std::move(ring));
+  }
+  return owner.ring;
+}
+
+void Logger::Write(LogLevel level, std::string_view message) {
+  Ring* ring = ThreadRing();
+  if (ring == nullptr) {
+    // Logged by a thread_local destructor after the ring was handed to the
+    // drain thread; rare enough to write directly.
+    std::string output;
+    AppendLine(&output, NowNanos(), level, message.substr(0, kMaxLogMessage));
+    WriteAll(fd_, output);
+    return;
+  }
+  const size_t tail = ring->tail.load(std::memory_order_relaxed);
+  if (tail - ring->head.load(std::memory_order_acquire) == kRingCapacity) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    Wake();
+    return;
+  }
+  Record& record = ring->records[tail & (kRingCapacity - 1)];
+  record.timestamp_ns = NowNanos();
+  record.level = level;
+  record.length =
+      static_cast<uint16_t>(std::min(message.size(), kMaxLogMessage));
+  memcpy(record.text, message.data(), record.length);
+  ring->tail.store(tail + 1, std::memory_order_release);
+  Wake();
+}
+
+void Logger::Wake() {
+  // Only the producer that finds the drain thread idle takes the lock.
+  if (!pending_.exchange(true)) {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    wake_.notify_one();
+  }
+}
+
+void Logger::Flush() {
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  // A pass already under way may have read the rings before our messages
+  // landed, so wait for one that starts after this point.
+  const uint64_t target = drain_passes_ + (draining_ ? 2 : 1);
+  pending_.store(true);
+  wake_.notify_one();
+  drained_.wait(lock, [&] { return drain_passes_ >= target; });
+}
+
+void Logger::Run() {
+  std::string output;
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  for (;;) {
+    const auto ready = [this] { return stopping_ || pending_.load(); };
+    // Suppressed repeats are reported once their window closes, even if
+    // nothing else is logged.
+    if (rate_entries_.empty()) {
+      wake_.wait(lock, ready);
+    } else {
+      wake_.wait_for(lock, std::chrono::nanoseconds(kRateWindowNs), ready);
+    }
+    const bool stopping = stopping_;
+    draining_ = true;
+    lock.unlock();
+
+    // Pairs with the producers' exchange so their records are visible.
+    pending_.exchange(false);
+    output.clear();
+    Drain(&output);
+    WriteAll(fd_, output);
+
+    lock.lock();
+    draining_ = false;
+    ++drain_passes_;
+    drained_.notify_all();
+    if (stopping) {
+      return;
+    }
+  }
+}
+
+void Logger::Drain(std::string* output) {
+  std::vector<const Record*> batch;
+  std::vector<std::pair<Ring*, size_t>> consumed;
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (const auto& ring : rings_) {
+      const size_t head = ring->head.load(std::memory_order_relaxed);
+      const size_t tail = ring->tail.load(std::memory_order_acquire);
+      for (size_t i = head; i != tail; ++i) {
+        batch.push_back(&ring->records[i & (kRingCapacity - 1)]);
+      }
+      consumed.emplace_back(ring.get(), tail);
+    }
+  }
+
+  std::stable_sort(batch.begin(), batch.end(),
+                   [](const Record* a, const Record* b) {
+                     return a->timestamp_ns < b->timestamp_ns;
+                   });
+
+  const int64_t now = NowNanos();
+  for (auto it = rate_entries_.begin(); it != rate_entries_.end();) {
+    if (now - it->window_start_ns < kRateWindowNs) {
+      ++it;
+      continue;
+    }
+    if (it->suppressed > 0) {
+      AppendLine(output, now, it->level,
+                 "(suppressed " + std::to_string(it->suppressed) +
+                     " repeats of: " + it->text + ")");
+    }
+    it = rate_entries_.erase(it);
+  }
+
+  for (const Record* record : batch) {
+    const std::string_view text(record->text, record->length);
+    const uint64_t hash = HashMessage(text);
+    auto entry = std::find_if(
+        rate_entries_.begin(), rate_entries_.end(),
+        [hash](const RateEntry& candidate) { return candidate.hash == hash; });
+    if (entry == rate_entries_.end()) {
+      if (rate_entries_.size() < kMaxRateEntries) {
+        rate_entries_.push_back(RateEntry{hash, record->timestamp_ns, 1, 0,
+                                          record->level, std::string(text)});
+      }
+    } else if (++entry->count > kRateLimitBurst) {
+      ++entry->suppressed;
+      continue;
+    }
+    AppendLine(output, record->timestamp_ns, record->level, text);
+  }
+
+  const uint64_t dropped = dropped_.exchange(0);
+  if (dropped > 0) {
+    AppendLine(output, now, LogLevel::kWarning,
+               "(dropped " + std::to_string(dropped) +
+                   " messages: log buffer full)");
+  }
+
+  std::lock_guard<std::mutex> lock(rings_mutex_);
+  for (const auto& [ring, tail] : consumed) {
+    ring->head.store(tail, std::memory_order_release);
+  }
+  rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                              [](const std::unique_ptr<Ring>& ring) {
+                                return ring->orphaned.load() &&
+                                       ring->head.load() == ring->tail.load();
+                              }),
+               rings_.end());
+}
+
+LogMessage& LogMessage::operator<<(std::string_view text) {
+  const size_t count = std::min(text.size(), kMaxLogMessage - length_);
+  memcpy(buffer_ + length_, text.data(), count);
+  length_ += count;
+  return *this;
+}
+
+LogMessage& LogMessage::operator<<(double value) {
+  char digits[32];
+  const int length = snprintf(digits, sizeof(digits), "%g", value);
+  return *this << std::string_view(digits, static_cast<size_t>(length));
+}
+
+LogMessage& LogMessage::operator<<(Hex value) {
+  char digits[24];
+  const auto result =
+      std::to_chars(digits, digits + sizeof(digits), value.value, 16);
+  return *this << std::string_view(digits, result.ptr - digits);
+}
+
+LogMessage& LogMessage::AppendSigned(long long value) {
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  return *this << std::string_view(digits, result.ptr - digits);
+}
+
+LogMessage& LogMessage::AppendUnsigned(unsigned long long value) {
+  char digits[24];
+  const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+  return *this << std::string_view(digits, result.ptr - digits);
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,173 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_LOGGER_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_LOGGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+enum class LogLevel : uint8_t {
+  kDebug,
+  kInfo,
+  kWarning,
+  kError,
+  kOff,
+};
+
+// Parses "debug", "info", "warning", "error" or "off".
+bool ParseLogLevel(std::string_view name, LogLevel* level);
+
+// Debug messages exist only in builds without NDEBUG; Flutter defines it
+// for profile and release builds.
+#ifdef NDEBUG
+inline constexpr bool kDebugLogsCompiled = false;
+#else
+inline constexpr bool kDebugLogsCompiled = true;
+#endif
+
+// Longest message kept; longer ones are truncated.
+constexpr size_t kMaxLogMessage = 240;
+
+// Asynchronous log sink.
+//
+// Each logging thread owns a single-producer ring of fixed-size records,
+// so writing a message is a copy and two atomic operations; no lock, no
+// allocation and no syscall. One drain thread collects the rings, orders
+// the batch by timestamp and writes it to stderr (or the file named by
+// ULTRA_SECURE_FLUTTER_KIT_LOG_FILE) with a single write(). It sleeps
+// until a producer finds it idle. A message repeated more than
+// kRateLimitBurst times within a second is suppressed, and the number
+// suppressed is reported once the second is over. When a ring is full
+// the message is dropped and counted rather than blocking the caller.
+class Logger {
+ public:
+  static constexpr size_t kRateLimitBurst = 5;
+
+  static Logger& Instance();
+
+  void SetLevel(LogLevel level) { level_.store(level); }
+  LogLevel level() const { return level_.load(std::memory_order_relaxed); }
+
+  bool IsEnabled(LogLevel level) const {
+    return level >= this->level() && level != LogLevel::kOff;
+  }
+
+  void Write(LogLevel level, std::string_view message);
+
+  // Blocks until every message written before the call has been output.
+  void Flush();
+
+  uint64_t dropped() const { return dropped_.load(); }
+
+ private:
+  struct Record;
+  struct Ring;
+  class RingOwner;
+
+  Logger();
+  ~Logger();
+
+  // The calling thread's ring; null once the thread is exiting and its
+  // ring has been handed to the drain thread.
+  Ring* ThreadRing();
+  void Run();
+  void Drain(std::string* output);
+  void Wake();
+
+  std::atomic<LogLevel> level_;
+  std::atomic<uint64_t> dropped_{0};
+  int fd_;
+
+  std::mutex rings_mutex_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+
+  std::atomic<bool> pending_{false};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable drained_;
+  uint64_t drain_passes_ = 0;
+  bool draining_ = false;
+  bool stopping_ = false;
+
+  struct RateEntry;
+  std::vector<RateEntry> rate_entries_;
+
+  std::thread thread_;
+};
+
+// Streams an integer in lowercase hexadecimal, without a prefix.
+struct Hex {
+  uint64_t value;
+};
+
+// Formats one message into a fixed buffer and hands it to the Logger when
+// it goes out of scope. Used through USFK_LOG.
+class LogMessage {
+ public:
+  explicit LogMessage(LogLevel level) : level_(level) {}
+  ~LogMessage() {
+    Logger::Instance().Write(level_, std::string_view(buffer_, length_));
+  }
+
+  LogMessage(const LogMessage&) = delete;
+  LogMessage& operator=(const LogMessage&) = delete;
+
+  LogMessage& operator<<(std::string_view text);
+  LogMessage& operator<<(const char* text) {
+    return *this << std::string_view(text ? text : "(null)");
+  }
+  LogMessage& operator<<(const std::string& text) {
+    return *this << std::string_view(text);
+  }
+  LogMessage& operator<<(char c) { return *this << std::string_view(&c, 1); }
+  LogMessage& operator<<(bool value) { return *this << (value ? "1" : "0"); }
+  LogMessage& operator<<(double value);
+  LogMessage& operator<<(Hex value);
+
+  template <typename T,
+            typename = std::enable_if_t<std::is_integral_v<T> &&
+                                        !std::is_same_v<T, bool> &&
+                                        !std::is_same_v<T, char>>>
+  LogMessage& operator<<(T value) {
+    if constexpr (std::is_signed_v<T>) {
+      return AppendSigned(static_cast<long long>(value));
+    } else {
+      return AppendUnsigned(static_cast<unsigned long long>(value));
+    }
+  }
+
+ private:
+  LogMessage& AppendSigned(long long value);
+  LogMessage& AppendUnsigned(unsigned long long value);
+
+  const LogLevel level_;
+  size_t length_ = 0;
+  char buffer_[kMaxLogMessage];
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+// USFK_LOG(kWarning) << "Security: ..." << value;
+//
+// Operands are only evaluated when the level is enabled, and kDebug
+// statements compile to nothing when kDebugLogsCompiled is false.
+#define USFK_LOG(severity)                                                 \
+  if (!((::ultra_secure_flutter_kit::LogLevel::severity !=                 \
+             ::ultra_secure_flutter_kit::LogLevel::kDebug ||               \
+         ::ultra_secure_flutter_kit::kDebugLogsCompiled) &&                \
+        ::ultra_secure_flutter_kit::Logger::Instance().IsEnabled(          \
+            ::ultra_secure_flutter_kit::LogLevel::severity))) {            \
+  } else                                                                   \
+    ::ultra_secure_flutter_kit::LogMessage(                                \
+        ::ultra_secure_flutter_kit::LogLevel::severity)
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_LOGGER_H_
@@ -0,0 +1,275 @@
+#include "method_stats.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr char kStatsFileVariable[] = "ULTRA_SECURE_FLUTTER_KIT_STATS_FILE";
+constexpr char kStatsIntervalVariable[] =
+    "ULTRA_SECURE_FLUTTER_KIT_STATS_INTERVAL";
+constexpr long kDefaultDumpIntervalSeconds = 60;
+
+// Values below this are their own bucket.
+constexpr uint64_t kLinearLimit = uint64_t{2}
+                                  << LatencyHistogram::kSubBucketBits;
+
+int MostSignificantBit(uint64_t value) { return 63 - __builtin_clzll(value); }
+
+uint64_t Percentile(const std::array<uint64_t, LatencyHistogram::kBucketCount>&
+                        buckets,
+                    uint64_t total, double fraction, uint64_t max_ns) {
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(LatencyHistogram::BucketUpperBound(i), max_ns);
+    }
+  }
+  return max_ns;
+}
+
+// Set once the thread's ThreadStatsOwner is destroyed; trivially
+// destructible, so still readable from later thread-exit destructors.
+thread_local bool thread_stats_retired = false;
+
+void AppendMicros(std::string* out, const char* key, uint64_t ns) {
+  char field[64];
+  snprintf(field, sizeof(field), ",\"%s\":%.3f", key,
+           static_cast<double>(ns) / 1000.0);
+  out->append(field);
+}
+
+}  // namespace
+
+size_t LatencyHistogram::BucketFor(uint64_t value_ns) {
+  if (value_ns < kLinearLimit) {
+    return static_cast<size_t>(value_ns);
+  }
+  const int msb = MostSignificantBit(value_ns);
+  if (msb >= kMaxValueBits) {
+    return kBucketCount - 1;
+  }
+  const int shift = msb - kSubBucketBits;
+  return (static_cast<size_t>(shift) << kSubBucketBits) +
+         static_cast<size_t>(value_ns >> shift);
+}
+
+uint64_t LatencyHistogram::BucketUpperBound(size_t bucket) {
+  if (bucket < kLinearLimit) {
+    return bucket;
+  }
+  const size_t shift = (bucket >> kSubBucketBits) - 1;
+  const uint64_t mantissa = bucket - (shift << kSubBucketBits);
+  return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t value_ns, bool error) {
+  // Single writer: plain load/store pairs instead of read-modify-writes.
+  auto bump = [](std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  };
+  bump(buckets[BucketFor(value_ns)], 1);
+  bump(count, 1);
+  bump(sum_ns, value_ns);
+  if (error) {
+    bump(errors, 1);
+  }
+  if (value_ns > max_ns.load(std::memory_order_relaxed)) {
+    max_ns.store(value_ns, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  auto add = [](std::atomic<uint64_t>& counter,
+                const std::atomic<uint64_t>& amount) {
+    counter.store(counter.load(std::memory_order_relaxed) +
+                      amount.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+  };
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    add(buckets[i], other.buckets[i]);
+  }
+  add(count, other.count);
+  add(errors, other.errors);
+  add(sum_ns, other.sum_ns);
+  const uint64_t other_max = other.max_ns.load(std::memory_order_relaxed);
+  if (other_max > max_ns.load(std::memory_order_relaxed)) {
+    max_ns.store(other_max, std::memory_order_relaxed);
+  }
+}
+
+MethodStats& MethodStats::Instance() {
+  // Never destroyed: pool workers may still record during static teardown.
+  static MethodStats* stats = new MethodStats();
+  return *stats;
+}
+
+MethodStats::MethodStats() {
+  const char* path = getenv(kStatsFileVariable);
+  if (path == nullptr || *path == '\0') {
+    return;
+  }
+  long interval = kDefaultDumpIntervalSeconds;
+  if (const char* value = getenv(kStatsIntervalVariable)) {
+    interval = std::max(1L, strtol(value, nullptr, 10));
+  }
+  std::thread(&MethodStats::RunDump, this, std::string(path),
+              std::chrono::seconds(interval))
+      .detach();
+}
+
+MethodStats::ThreadStatsOwner::~ThreadStatsOwner() {
+  thread_stats_retired = true;
+  if (stats != nullptr) {
+    MethodStats::Instance().Retire(stats);
+  }
+}
+
+MethodStats::ThreadStats* MethodStats::ThreadLocalStats() {
+  if (thread_stats_retired) {
+    return nullptr;
+  }
+  thread_local ThreadStatsOwner owner;
+  if (owner.stats == nullptr) {
+    owner.stats = new ThreadStats();
+    std::lock_guard<std::mutex> lock(mutex_);
+    threads_.push_back(owner.stats);
+  }
+  return owner.stats;
+}
+
+void MethodStats::Retire(ThreadStats* stats) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  threads_.erase(std::find(threads_.begin(), threads_.end(), stats));
+  for (size_t method = 0; method < kMethodCount; ++method) {
+    LatencyHistogram* histogram =
+        stats->methods[method].load(std::memory_order_relaxed);
+    if (histogram == nullptr) {
+      continue;
+    }
+    if (!retired_[method]) {
+      retired_[method] = std::make_unique<LatencyHistogram>();
+    }
+    retired_[method]->Merge(*histogram);
+    delete histogram;
+  }
+  delete stats;
+}
+
+void MethodStats::Record(Method id, uint64_t duration_ns, bool error) {
+  ThreadStats* stats = ThreadLocalStats();
+  if (stats == nullptr) {
+    // A destructor running after this thread's stats were retired.
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& retired = retired_[static_cast<size_t>(id)];
+    if (!retired) {
+      retired = std::make_unique<LatencyHistogram>();
+    }
+    retired->Record(duration_ns, error);
+    return;
+  }
+  auto& slot = stats->methods[static_cast<size_t>(id)];
+  LatencyHistogram* histogram = slot.load(std::memory_order_relaxed);
+  if (histogram == nullptr) {
+    histogram = new LatencyHistogram();
+    slot.store(histogram, std::memory_order_release);
+  }
+  histogram->Record(duration_ns, error);
+}
+
+std::vector<MethodLatency> MethodStats::Collect() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<MethodLatency> result;
+  for (size_t method = 0; method < kMethodCount; ++method) {
+    std::array<uint64_t, LatencyHistogram::kBucketCount> buckets{};
+    MethodLatency latency;
+    latency.id = static_cast<Method>(method);
+    uint64_t sum_ns = 0;
+    uint64_t total = 0;
+    std::vector<const LatencyHistogram*> histograms;
+    for (const ThreadStats* thread : threads_) {
+      histograms.push_back(
+          thread->methods[method].load(std::memory_order_acquire));
+    }
+    histograms.push_back(retired_[method].get());
+    for (const LatencyHistogram* histogram : histograms) {
+      if (histogram == nullptr) {
+        continue;
+      }
+      latency.count += histogram->count.load(std::memory_order_relaxed);
+      latency.errors += histogram->errors.load(std::memory_order_relaxed);
+      sum_ns += histogram->sum_ns.load(std::memory_order_relaxed);
+      latency.max_ns = std::max(
+          latency.max_ns, histogram->max_ns.load(std::memory_order_relaxed));
+      for (size_t i = 0; i < buckets.size(); ++i) {
+        const uint64_t hits =
+            histogram->buckets[i].load(std::memory_order_relaxed);
+        buckets[i] += hits;
+        total += hits;
+      }
+    }
+    if (total == 0) {
+      continue;
+    }
+    latency.mean_ns = latency.count ? sum_ns / latency.count : 0;
+    latency.p50_ns = Percentile(buckets, total, 0.50, latency.max_ns);
+    latency.p90_ns = Percentile(buckets, total, 0.90, latency.max_ns);
+    latency.p99_ns = Percentile(buckets, total, 0.99, latency.max_ns);
+    result.push_back(latency);
+  }
+  return result;
+}
+
+std::string MethodStats::ToJsonLine() const {
+  const auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch())
+                       .count();
+  std::string line = "{\"timestamp\":" + std::to_string(now) + ",\"methods\":{";
+  bool first = true;
+  for (const auto& latency : Collect()) {
+    line += first ? "\"" : ",\"";
+    first = false;
+    line.append(GetMethodInfo(latency.id).name);
+    line += "\":{\"count\":" + std::to_string(latency.count) +
+            ",\"errors\":" + std::to_string(latency.errors);
+    AppendMicros(&line, "meanMicros", latency.mean_ns);
+    AppendMicros(&line, "p50Micros", latency.p50_ns);
+    AppendMicros(&line, "p90Micros", latency.p90_ns);
+    AppendMicros(&line, "p99Micros", latency.p99_ns);
+    AppendMicros(&line, "maxMicros", latency.max_ns);
+    line += "}";
+  }
+  line += "}}\n";
+  return line;
+}
+
+void MethodStats::RunDump(std::string path,
+                          std::chrono::seconds interval) const {
+  for (;;) {
+    std::this_thread::sleep_for(interval);
+    const int fd =
+        open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (fd < 0) {
+      continue;
+    }
+    const std::string line = ToJsonLine();
+    // O_APPEND keeps each line whole even if several processes share the
+    // file. A failed write is retried with fresh numbers next interval.
+    const ssize_t written = write(fd, line.data(), line.size());
+    (void)written;
+    close(fd);
+  }
+}
+
+}  // namespace ultra_secure_flutter_kit
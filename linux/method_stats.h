@@ -0,0 +1,134 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_METHOD_STATS_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_METHOD_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "check_registry.h"
+
+namespace ultra_secure_flutter_kit {
+
+// Latency histogram with logarithmic buckets split into eight linear
+// sub-buckets each (HDR-style), so any recorded value is reported within
+// 12.5% of itself from 1 ns up to ~69 s; longer calls land in the last
+// bucket. A histogram has exactly one writing thread, which updates it with
+// relaxed stores; any thread may read it concurrently.
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 3;
+  static constexpr int kMaxValueBits = 36;
+  static constexpr size_t kBucketCount =
+      (kMaxValueBits - kSubBucketBits + 1) << kSubBucketBits;
+
+  static size_t BucketFor(uint64_t value_ns);
+  // Largest value that falls into `bucket`.
+  static uint64_t BucketUpperBound(size_t bucket);
+
+  void Record(uint64_t value_ns, bool error);
+  // Adds `other` into this histogram. Same single-writer rule as Record().
+  void Merge(const LatencyHistogram& other);
+
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> sum_ns{0};
+  std::atomic<uint64_t> max_ns{0};
+  std::array<std::atomic<uint64_t>, kBucketCount> buckets{};
+};
+
+struct MethodLatency {
+  Method id;
+  uint64_t count = 0;
+  uint64_t errors = 0;
+  uint64_t mean_ns = 0;
+  uint64_t p50_ns = 0;
+  uint64_t p90_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t max_ns = 0;
+};
+
+// Process-wide call statistics for the method-channel handlers.
+//
+// Every thread records into its own set of histograms, allocated on its
+// first call to a given method, so the recording path is a handful of
+// relaxed stores with no shared cache line. Collect() merges the buckets
+// of every live thread. A thread that exits folds its histograms into one
+// shared set per method and frees them, so short-lived threads keep their
+// calls counted without growing memory.
+//
+// When ULTRA_SECURE_FLUTTER_KIT_STATS_FILE is set, a JSON line with the
+// current statistics is appended to that file every
+// ULTRA_SECURE_FLUTTER_KIT_STATS_INTERVAL seconds (default 60).
+class MethodStats {
+ public:
+  static MethodStats& Instance();
+
+  void Record(Method id, uint64_t duration_ns, bool error);
+
+  // Statistics of every method called at least once, in registry order.
+  std::vector<MethodLatency> Collect() const;
+
+  // One JSON object per line, as written to the stats file.
+  std::string ToJsonLine() const;
+
+ private:
+  struct ThreadStats {
+    std::array<std::atomic<LatencyHistogram*>, kMethodCount> methods{};
+  };
+  // Retires the calling thread's ThreadStats when the thread exits.
+  struct ThreadStatsOwner {
+    ThreadStats* stats = nullptr;
+    ~ThreadStatsOwner();
+  };
+
+  MethodStats();
+
+  // Null once the calling thread's ThreadStats has been retired.
+  ThreadStats* ThreadLocalStats();
+  void Retire(ThreadStats* stats);
+  void RunDump(std::string path, std::chrono::seconds interval) const;
+
+  mutable std::mutex mutex_;
+  std::vector<ThreadStats*> threads_;  // live threads, under mutex_
+  // Calls of exited threads, under mutex_.
+  std::array<std::unique_ptr<LatencyHistogram>, kMethodCount> retired_;
+};
+
+// Records the lifetime of a scope as one call of `id`; leaving it by an
+// exception counts as an error.
+class MethodTimer {
+ public:
+  explicit MethodTimer(Method id)
+      : id_(id),
+        start_(std::chrono::steady_clock::now()),
+        exceptions_(std::uncaught_exceptions()) {}
+
+  ~MethodTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    MethodStats::Instance().Record(
+        id_,
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()),
+        std::uncaught_exceptions() > exceptions_);
+  }
+
+  MethodTimer(const MethodTimer&) = delete;
+  MethodTimer& operator=(const MethodTimer&) = delete;
+
+ private:
+  const Method id_;
+  const std::chrono::steady_clock::time_point start_;
+  const int exceptions_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_METHOD_STATS_H_
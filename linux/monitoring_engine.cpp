@@ -0,0 +1,424 @@
+#include "monitoring_engine.h"
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr size_t kReceiveBufferSize = 16 * 1024;
+constexpr int kSeedTimeoutMs = 1000;
+
+int64_t NowMillis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void CloseFd(int* fd) {
+  if (*fd >= 0) {
+    close(*fd);
+    *fd = -1;
+  }
+}
+
+void CloseFd(std::atomic<int>* fd) {
+  const int value = fd->exchange(-1);
+  if (value >= 0) {
+    close(value);
+  }
+}
+
+}  // namespace
+
+std::string UeventValue(const char* data, size_t length, const char* key) {
+  const size_t key_length = strlen(key);
+  size_t offset = 0;
+  while (offset < length) {
+    const char* entry = data + offset;
+    const size_t entry_length = strnlen(entry, length - offset);
+    if (entry_length > key_length && entry[key_length] == '=' &&
+        memcmp(entry, key, key_length) == 0) {
+      return std::string(entry + key_length + 1, entry_length - key_length - 1);
+    }
+    offset += entry_length + 1;
+  }
+  return std::string();
+}
+
+const char* MonitoringEventTypeName(MonitoringEventType type) {
+  switch (type) {
+    case MonitoringEventType::kLinkAdded:
+      return "linkAdded";
+    case MonitoringEventType::kLinkChanged:
+      return "linkChanged";
+    case MonitoringEventType::kLinkRemoved:
+      return "linkRemoved";
+    case MonitoringEventType::kAddressAdded:
+      return "addressAdded";
+    case MonitoringEventType::kAddressRemoved:
+      return "addressRemoved";
+    case MonitoringEventType::kUsbDeviceAdded:
+      return "usbDeviceAdded";
+    case MonitoringEventType::kUsbDeviceRemoved:
+      return "usbDeviceRemoved";
+  }
+  return "unknown";
+}
+
+MonitoringEngine::MonitoringEngine(EventCallback callback)
+    : callback_(std::move(callback)) {}
+
+MonitoringEngine::~MonitoringEngine() { Stop(); }
+
+bool MonitoringEngine::Start(bool watch_network, bool watch_usb) {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+
+  if (epoll_fd_ < 0) {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+      CloseFd(&epoll_fd_);
+      CloseFd(&wake_fd_);
+      return false;
+    }
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+  }
+
+  if (watch_network && route_fd_ < 0 && OpenRouteSocket()) {
+    // Learn the current links before listening so that only real changes
+    // are reported afterwards.
+    SeedRouteState();
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = route_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event.data.fd, &event);
+  }
+
+  if (watch_usb && uevent_fd_ < 0 && OpenUeventSocket()) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = uevent_fd_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event.data.fd, &event);
+  }
+
+  if (route_fd_ < 0 && uevent_fd_ < 0) {
+    return false;
+  }
+
+  if (!running_.exchange(true)) {
+    thread_ = std::thread(&MonitoringEngine::Run, this);
+  }
+  return true;
+}
+
+void MonitoringEngine::Stop() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+
+  if (running_.exchange(false)) {
+    const uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) {
+      // The thread also re-checks running_ after every wakeup.
+    }
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  CloseFd(&route_fd_);
+  CloseFd(&uevent_fd_);
+  CloseFd(&wake_fd_);
+  CloseFd(&epoll_fd_);
+  links_.clear();
+  addresses_.clear();
+}
+
+bool MonitoringEngine::OpenRouteSocket() {
+  int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                  NETLINK_ROUTE);
+  if (fd < 0) {
+    return false;
+  }
+  sockaddr_nl address{};
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    CloseFd(&fd);
+    return false;
+  }
+  route_fd_ = fd;
+  return true;
+}
+
+bool MonitoringEngine::OpenUeventSocket() {
+  int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                  NETLINK_KOBJECT_UEVENT);
+  if (fd < 0) {
+    return false;
+  }
+  sockaddr_nl address{};
+  address.nl_family = AF_NETLINK;
+  // Group 1 carries the raw kernel uevents, independent of udev.
+  address.nl_groups = 1;
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    CloseFd(&fd);
+    return false;
+  }
+  uevent_fd_ = fd;
+  return true;
+}
+
+void MonitoringEngine::SeedRouteState() {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  // Links first, so addresses find their interface names. Without the
+  // addresses, the first lifetime refresh of each existing one would be
+  // reported as added.
+  if (DumpRouteTable(RTM_GETLINK, 1)) {
+    DumpRouteTable(RTM_GETADDR, 2);
+  }
+}
+
+bool MonitoringEngine::DumpRouteTable(uint16_t type, uint32_t sequence) {
+  const int route_fd = route_fd_;
+  struct {
+    nlmsghdr header;
+    union {
+      ifinfomsg link;
+      ifaddrmsg address;
+    } body;
+  } request{};
+  request.header.nlmsg_len = NLMSG_LENGTH(
+      type == RTM_GETLINK ? sizeof(ifinfomsg) : sizeof(ifaddrmsg));
+  request.header.nlmsg_type = type;
+  request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  request.header.nlmsg_seq = sequence;
+  // The family is the first byte of either body; zero is AF_UNSPEC.
+  if (send(route_fd, &request, request.header.nlmsg_len, 0) < 0) {
+    return false;
+  }
+
+  alignas(nlmsghdr) char buffer[kReceiveBufferSize];
+  pollfd poll_fd{route_fd, POLLIN, 0};
+  while (poll(&poll_fd, 1, kSeedTimeoutMs) > 0) {
+    const ssize_t length = recv(route_fd, buffer, sizeof(buffer), 0);
+    if (length <= 0) {
+      return false;
+    }
+    int remaining = static_cast<int>(length);
+    for (auto* header = reinterpret_cast<nlmsghdr*>(buffer);
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      // Notifications arriving meanwhile are applied silently too.
+      switch (header->nlmsg_type) {
+        case NLMSG_DONE:
+          return true;
+        case NLMSG_ERROR:
+          return false;
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+          HandleLinkMessage(header, false);
+          break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+          HandleAddressMessage(header, false);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+  return false;
+}
+
+void MonitoringEngine::Run() {
+  epoll_event events[4];
+  while (running_.load()) {
+    const int count = epoll_wait(epoll_fd_, events, 4, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (int i = 0; i < count; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == wake_fd_) {
+        uint64_t value;
+        while (read(wake_fd_, &value, sizeof(value)) > 0) {
+        }
+      } else if (fd == route_fd_) {
+        DrainRouteSocket(true);
+      } else if (fd == uevent_fd_) {
+        DrainUeventSocket();
+      }
+    }
+  }
+}
+
+void MonitoringEngine::DrainRouteSocket(bool emit) {
+  std::lock_guard<std::mutex> lock(state_mutex_);
+  const int route_fd = route_fd_;
+  alignas(nlmsghdr) char buffer[kReceiveBufferSize];
+  for (;;) {
+    const ssize_t length = recv(route_fd, buffer, sizeof(buffer), 0);
+    if (length <= 0) {
+      // EAGAIN once drained. ENOBUFS means notifications were dropped; the
+      // next change still brings the affected link up to date.
+      return;
+    }
+    int remaining = static_cast<int>(length);
+    for (auto* header = reinterpret_cast<nlmsghdr*>(buffer);
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      switch (header->nlmsg_type) {
+        case RTM_NEWLINK:
+        case RTM_DELLINK:
+          HandleLinkMessage(header, emit);
+          break;
+        case RTM_NEWADDR:
+        case RTM_DELADDR:
+          HandleAddressMessage(header, emit);
+          break;
+        default:
+          break;
+      }
+    }
+  }
+}
+
+void MonitoringEngine::HandleLinkMessage(const void* message, bool emit) {
+  const auto* header = static_cast<const nlmsghdr*>(message);
+  const auto* info = static_cast<const ifinfomsg*>(NLMSG_DATA(header));
+  const int index = info->ifi_index;
+
+  if (header->nlmsg_type == RTM_DELLINK) {
+    auto it = links_.find(index);
+    if (it != links_.end()) {
+      const std::string name = it->second.name;
+      links_.erase(it);
+      if (emit) {
+        Emit(MonitoringEventType::kLinkRemoved, name, false);
+      }
+    }
+    return;
+  }
+
+  LinkState state;
+  state.is_up = (info->ifi_flags & IFF_UP) != 0;
+  int attribute_length = static_cast<int>(IFLA_PAYLOAD(header));
+  for (auto* attribute = IFLA_RTA(info); RTA_OK(attribute, attribute_length);
+       attribute = RTA_NEXT(attribute, attribute_length)) {
+    if (attribute->rta_type == IFLA_IFNAME) {
+      state.name = static_cast<const char*>(RTA_DATA(attribute));
+    }
+  }
+
+  auto it = links_.find(index);
+  if (it == links_.end()) {
+    links_.emplace(index, state);
+    if (emit) {
+      Emit(MonitoringEventType::kLinkAdded, state.name, state.is_up);
+    }
+  } else if (it->second.name != state.name ||
+             it->second.is_up != state.is_up) {
+    it->second = state;
+    if (emit) {
+      Emit(MonitoringEventType::kLinkChanged, state.name, state.is_up);
+    }
+  }
+}
+
+void MonitoringEngine::HandleAddressMessage(const void* message,
+                                            bool emit) {
+  const auto* header = static_cast<const nlmsghdr*>(message);
+  const auto* info = static_cast<const ifaddrmsg*>(NLMSG_DATA(header));
+
+  std::string address;
+  int attribute_length = static_cast<int>(IFA_PAYLOAD(header));
+  for (auto* attribute = IFA_RTA(info); RTA_OK(attribute, attribute_length);
+       attribute = RTA_NEXT(attribute, attribute_length)) {
+    if (attribute->rta_type == IFA_ADDRESS) {
+      address.assign(static_cast<const char*>(RTA_DATA(attribute)),
+                     RTA_PAYLOAD(attribute));
+    }
+  }
+
+  const auto key = std::make_tuple(static_cast<int>(info->ifa_index),
+                                   static_cast<int>(info->ifa_family), address);
+  const bool added = header->nlmsg_type == RTM_NEWADDR;
+  // Lifetime refreshes re-send RTM_NEWADDR for addresses we already know.
+  if (added ? !addresses_.insert(key).second : addresses_.erase(key) == 0) {
+    return;
+  }
+  if (!emit) {
+    return;
+  }
+
+  std::string name;
+  auto link = links_.find(static_cast<int>(info->ifa_index));
+  if (link != links_.end()) {
+    name = link->second.name;
+  } else {
+    char buffer[IF_NAMESIZE] = {0};
+    if (if_indextoname(info->ifa_index, buffer) != nullptr) {
+      name = buffer;
+    }
+  }
+  Emit(added ? MonitoringEventType::kAddressAdded
+             : MonitoringEventType::kAddressRemoved,
+       name, added);
+}
+
+void MonitoringEngine::DrainUeventSocket() {
+  const int uevent_fd = uevent_fd_;
+  char buffer[kReceiveBufferSize];
+  for (;;) {
+    const ssize_t length = recv(uevent_fd, buffer, sizeof(buffer) - 1, 0);
+    if (length <= 0) {
+      return;
+    }
+    buffer[length] = '\0';
+    const size_t size = static_cast<size_t>(length);
+
+    // Each USB device also produces one uevent per interface; only the
+    // usb_device itself is interesting.
+    if (UeventValue(buffer, size, "SUBSYSTEM") != "usb" ||
+        UeventValue(buffer, size, "DEVTYPE") != "usb_device") {
+      continue;
+    }
+    const std::string action = UeventValue(buffer, size, "ACTION");
+    const std::string path = UeventValue(buffer, size, "DEVPATH");
+    if (action == "add") {
+      Emit(MonitoringEventType::kUsbDeviceAdded, path, false);
+    } else if (action == "remove") {
+      Emit(MonitoringEventType::kUsbDeviceRemoved, path, false);
+    }
+  }
+}
+
+void MonitoringEngine::Emit(MonitoringEventType type, const std::string& name,
+                            bool is_up) {
+  if (!callback_) {
+    return;
+  }
+  MonitoringEvent event;
+  event.type = type;
+  event.name = name;
+  event.is_up = is_up;
+  event.timestamp_ms = NowMillis();
+  callback_(event);
+}
+
+}  // namespace ultra_secure_flutter_kit
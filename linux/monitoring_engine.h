@@ -0,0 +1,114 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_MONITORING_ENGINE_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_MONITORING_ENGINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace ultra_secure_flutter_kit {
+
+enum class MonitoringEventType {
+  kLinkAdded,
+  kLinkChanged,
+  kLinkRemoved,
+  kAddressAdded,
+  kAddressRemoved,
+  kUsbDeviceAdded,
+  kUsbDeviceRemoved,
+};
+
+// Stable name used for the event's "type" field on the Dart side.
+const char* MonitoringEventTypeName(MonitoringEventType type);
+
+// Returns the value of `key` ("ACTION", "DEVTYPE", ...) in a kernel uevent
+// payload of NUL-separated KEY=VALUE pairs.
+std::string UeventValue(const char* data, size_t length, const char* key);
+
+struct MonitoringEvent {
+  MonitoringEventType type;
+  // Interface name for network events, sysfs device path for USB events.
+  std::string name;
+  // Administrative state of the interface; only meaningful for link events.
+  bool is_up = false;
+  int64_t timestamp_ms = 0;
+};
+
+// Watches the kernel for network and USB changes on one background thread.
+//
+// The thread sleeps in epoll_wait() over an rtnetlink socket subscribed to
+// RTNLGRP_LINK/RTNLGRP_IPV4_IFADDR/RTNLGRP_IPV6_IFADDR and a
+// NETLINK_KOBJECT_UEVENT socket, so it costs no wakeups while nothing
+// changes. Kernel notifications that do not change the observable state
+// (statistics updates, repeated address lifetimes, USB interface uevents)
+// are filtered out before the callback runs.
+//
+// The callback is invoked on the engine thread; callers that talk to
+// Flutter must hop back to the platform thread themselves.
+class MonitoringEngine {
+ public:
+  using EventCallback = std::function<void(const MonitoringEvent&)>;
+
+  explicit MonitoringEngine(EventCallback callback);
+  ~MonitoringEngine();
+
+  MonitoringEngine(const MonitoringEngine&) = delete;
+  MonitoringEngine& operator=(const MonitoringEngine&) = delete;
+
+  // Starts the engine or adds sources to a running one. Returns false when
+  // none of the requested sources could be opened (e.g. inside a sandbox
+  // without netlink access).
+  bool Start(bool watch_network, bool watch_usb);
+  void Stop();
+
+  bool IsRunning() const { return running_.load(); }
+  bool IsWatchingNetwork() const { return route_fd_ >= 0; }
+  bool IsWatchingUsb() const { return uevent_fd_ >= 0; }
+
+ private:
+  bool OpenRouteSocket();
+  bool OpenUeventSocket();
+  // Loads the current links and addresses, so only later changes are
+  // reported.
+  void SeedRouteState();
+  // Dumps one rtnetlink table into the state without emitting events;
+  // needs state_mutex_. False if the dump failed or timed out.
+  bool DumpRouteTable(uint16_t type, uint32_t sequence);
+  void Run();
+  void DrainRouteSocket(bool emit);
+  void DrainUeventSocket();
+  void HandleLinkMessage(const void* header, bool emit);
+  void HandleAddressMessage(const void* header, bool emit);
+  void Emit(MonitoringEventType type, const std::string& name, bool is_up);
+
+  struct LinkState {
+    std::string name;
+    bool is_up = false;
+  };
+
+  EventCallback callback_;
+  std::mutex start_mutex_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  int epoll_fd_ = -1;
+  int wake_fd_ = -1;
+  // Atomic because Start() may add a source while the engine thread runs.
+  std::atomic<int> route_fd_{-1};
+  std::atomic<int> uevent_fd_{-1};
+
+  // Held by the engine thread while handling route messages, and by
+  // Start() while it seeds the links and addresses of a source added to a
+  // running engine.
+  std::mutex state_mutex_;
+  std::unordered_map<int, LinkState> links_;
+  std::set<std::tuple<int, int, std::string>> addresses_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_MONITORING_ENGINE_H_
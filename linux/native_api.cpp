@@ -0,0 +1,110 @@
+#include "native_api.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+
+#include "check_registry.h"
+#include "method_stats.h"
+#include "native_checks.h"
+
+namespace {
+
+using ultra_secure_flutter_kit::Method;
+
+// The first published layout; later versions only append to it.
+constexpr size_t kSnapshotV1Size = 32;
+
+static_assert(sizeof(usfk_snapshot_t) == kSnapshotV1Size,
+              "usfk_snapshot_t is ABI; append fields and bump the version");
+static_assert(offsetof(usfk_snapshot_t, timestamp_ms) == 16);
+static_assert(offsetof(usfk_snapshot_t, duration_us) == 24);
+
+// Exceptions must not cross the C boundary; a check that throws reports
+// false, as it does in a snapshot taken over the channel.
+int32_t Check(Method id) {
+  try {
+    ultra_secure_flutter_kit::MethodTimer timer(id);
+    return ultra_secure_flutter_kit::RunCheck(id) ? 1 : 0;
+  } catch (const std::exception&) {
+    return 0;
+  }
+}
+
+}  // namespace
+
+extern "C" {
+
+uint32_t usfk_api_version(void) { return USFK_API_VERSION; }
+
+int32_t usfk_snapshot(usfk_snapshot_t* snapshot) {
+  if (snapshot == nullptr || snapshot->size < kSnapshotV1Size) {
+    return -1;
+  }
+
+  usfk_snapshot_t result = {};
+  result.timestamp_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  const auto start = std::chrono::steady_clock::now();
+
+  result.is_rooted = Check(Method::kIsRooted);
+  result.is_jailbroken = Check(Method::kIsJailbroken);
+  result.is_emulator = Check(Method::kIsEmulator);
+  result.is_debugger_attached = Check(Method::kIsDebuggerAttached);
+  result.is_screen_capture_blocked = Check(Method::kIsScreenCaptureBlocked);
+  result.is_usb_cable_attached = Check(Method::kIsUsbCableAttached);
+  result.has_proxy_settings = Check(Method::kHasProxySettings);
+  result.has_vpn_connection = Check(Method::kHasVPNConnection);
+  result.is_developer_mode_enabled = Check(Method::kIsDeveloperModeEnabled);
+
+  result.duration_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+
+  // A caller built against a newer header keeps its extra fields zeroed;
+  // an older one gets only the fields it has.
+  const uint32_t caller_size = snapshot->size;
+  memcpy(snapshot, &result, std::min<size_t>(caller_size, sizeof(result)));
+  if (caller_size > sizeof(result)) {
+    memset(reinterpret_cast<char*>(snapshot) + sizeof(result), 0,
+           caller_size - sizeof(result));
+  }
+  snapshot->size = caller_size;
+  return 0;
+}
+
+int32_t usfk_is_rooted(void) { return Check(Method::kIsRooted); }
+
+int32_t usfk_is_jailbroken(void) { return Check(Method::kIsJailbroken); }
+
+int32_t usfk_is_emulator(void) { return Check(Method::kIsEmulator); }
+
+int32_t usfk_is_debugger_attached(void) {
+  return Check(Method::kIsDebuggerAttached);
+}
+
+int32_t usfk_is_screen_capture_blocked(void) {
+  return Check(Method::kIsScreenCaptureBlocked);
+}
+
+int32_t usfk_is_usb_cable_attached(void) {
+  return Check(Method::kIsUsbCableAttached);
+}
+
+int32_t usfk_has_proxy_settings(void) {
+  return Check(Method::kHasProxySettings);
+}
+
+int32_t usfk_has_vpn_connection(void) {
+  return Check(Method::kHasVPNConnection);
+}
+
+int32_t usfk_is_developer_mode_enabled(void) {
+  return Check(Method::kIsDeveloperModeEnabled);
+}
+
+}  // extern "C"
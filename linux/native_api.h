@@ -0,0 +1,68 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_NATIVE_API_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_NATIVE_API_H_
+
+// Stable C API of the plugin library, for synchronous calls through
+// dart:ffi without a method-channel round trip.
+//
+// Every function is thread-safe, may be called from any isolate or thread
+// and answers from the same tables as the method channel. Calls are
+// counted in getPerformanceStats under the matching method name. Nothing
+// here hashes files or goes to the network; verifyAppIntegrity stays on
+// the channel. Most calls still probe paths, rescan USB devices or dump
+// links over rtnetlink, and can block on slow I/O, so bind them as
+// ordinary rather than leaf calls. Only the debugger, screen capture and
+// proxy checks never block.
+//
+// Functions and struct fields are only ever added. A caller sets
+// usfk_snapshot_t.size to the size of the struct it was built against and
+// gets back every field it knows about.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define USFK_EXPORT __attribute__((visibility("default")))
+
+#define USFK_API_VERSION 1
+
+typedef struct usfk_snapshot_t {
+  uint32_t size;  // in: sizeof(usfk_snapshot_t) as the caller sees it
+  uint8_t is_rooted;
+  uint8_t is_jailbroken;
+  uint8_t is_emulator;
+  uint8_t is_debugger_attached;
+  uint8_t is_screen_capture_blocked;
+  uint8_t is_usb_cable_attached;
+  uint8_t has_proxy_settings;
+  uint8_t has_vpn_connection;
+  uint8_t is_developer_mode_enabled;
+  uint8_t reserved[3];
+  int64_t timestamp_ms;  // wall clock when the checks started
+  int64_t duration_us;
+} usfk_snapshot_t;
+
+USFK_EXPORT uint32_t usfk_api_version(void);
+
+// Fills `snapshot`, running its checks one after another on the calling
+// thread. Returns 0, or -1 if `snapshot` is null or its size is smaller
+// than the first version of the struct.
+USFK_EXPORT int32_t usfk_snapshot(usfk_snapshot_t* snapshot);
+
+// 1 or 0.
+USFK_EXPORT int32_t usfk_is_rooted(void);
+USFK_EXPORT int32_t usfk_is_jailbroken(void);
+USFK_EXPORT int32_t usfk_is_emulator(void);
+USFK_EXPORT int32_t usfk_is_debugger_attached(void);
+USFK_EXPORT int32_t usfk_is_screen_capture_blocked(void);
+USFK_EXPORT int32_t usfk_is_usb_cable_attached(void);
+USFK_EXPORT int32_t usfk_has_proxy_settings(void);
+USFK_EXPORT int32_t usfk_has_vpn_connection(void);
+USFK_EXPORT int32_t usfk_is_developer_mode_enabled(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_NATIVE_API_H_
@@ -0,0 +1,163 @@
+#include "native_checks.h"
+
+#include "app_integrity.h"
+#include "asset_manifest_key.h"
+#include "debug_watchdog.h"
+#include "emulator_detector.h"
+#include "logger.h"
+#include "network_interfaces.h"
+#include "proc_reader.h"
+#include "system_checks.h"
+#include "usb_device_table.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+bool IsRooted() {
+  // Privilege escalation tools, then the effective user
+  if (const char* path = FindRootTool()) {
+    USFK_LOG(kWarning) << "Security: Root access detected via: " << path;
+    return true;
+  }
+  if (IsRunningAsRoot()) {
+    USFK_LOG(kWarning) << "Security: Running as root user";
+    return true;
+  }
+  return false;
+}
+
+bool IsJailbroken() {
+  // Linux has no jailbreak as such; look for security bypasses instead
+  if (const char* path = FindPackageManagerTrace()) {
+    USFK_LOG(kWarning) << "Security: Suspicious modification detected: "
+                       << path;
+    return true;
+  }
+  return false;
+}
+
+bool IsEmulator() {
+  // CPUID, then DMI, then the first /proc/cpuinfo block
+  const EmulatorDetection detection = DetectEmulator();
+  if (detection.detected) {
+    USFK_LOG(kWarning) << "Security: Virtual machine detected: "
+                       << detection.vendor << " ("
+                       << EmulatorSourceName(detection.source) << ")";
+  }
+  return detection.detected;
+}
+
+bool IsDebuggerAttached() {
+  // The watchdog's view once preventReverseEngineering started it, which
+  // also covers tracers hidden from the status file
+  const DebugWatchdog& watchdog = DebugWatchdog::Instance();
+  if (watchdog.IsRunning()) {
+    if (watchdog.IsTraced()) {
+      USFK_LOG(kWarning) << "Security: Debugger attached (PID: "
+                         << watchdog.TracerPid() << ")";
+      return true;
+    }
+    return false;
+  }
+  // Otherwise TracerPid from a kept-open /proc/self/status, re-read with
+  // pread
+  long tracer_pid = 0;
+  if (ReadSelfStatusField("TracerPid", &tracer_pid) && tracer_pid != 0) {
+    USFK_LOG(kWarning) << "Security: Debugger attached (PID: " << tracer_pid
+                       << ")";
+    return true;
+  }
+  return false;
+}
+
+bool VerifyAppIntegrity() {
+  // The executable and bundled libraries against the manifest generated
+  // and signed at install time
+  AppIntegrityVerifier& verifier = AppIntegrityVerifier::Instance();
+  verifier.SetPublicKey(kAssetManifestPublicKey);
+  const IntegrityReport report = verifier.Verify();
+  if (!report.manifest_found) {
+#ifdef NDEBUG
+    // Profile and release bundles are always installed with one
+    USFK_LOG(kWarning) << "Security: Integrity manifest missing";
+    return false;
+#else
+    USFK_LOG(kInfo) << "Security: No integrity manifest, skipping verification";
+    return true;
+#endif
+  }
+  if (!report.signature_valid) {
+    USFK_LOG(kWarning) << "Security: Integrity manifest signature invalid";
+    return false;
+  }
+  for (const auto& name : report.mismatched) {
+    USFK_LOG(kWarning) << "Security: Integrity mismatch: " << name;
+  }
+  for (const auto& name : report.missing) {
+    USFK_LOG(kWarning) << "Security: Integrity file missing: " << name;
+  }
+  return report.verified;
+}
+
+bool HasProxySettings() {
+  const char* value = nullptr;
+  if (const char* variable = FindProxyVariable(&value)) {
+    USFK_LOG(kWarning) << "Security: Proxy detected: " << variable << "="
+                       << value;
+    return true;
+  }
+  return false;
+}
+
+bool HasVpnConnection() {
+  // Tunnel interfaces by link kind, or a default route through one;
+  // cached until the kernel reports a link or route change
+  const auto network = NetworkInterfaceTable::Instance().Get();
+  if (network->has_vpn) {
+    USFK_LOG(kWarning) << "Security: VPN interface detected: "
+                       << network->vpn_interface;
+    return true;
+  }
+  return false;
+}
+
+bool IsDeveloperModeEnabled() {
+  if (const char* path = FindDeveloperTool()) {
+    USFK_LOG(kWarning) << "Security: Developer tools detected: " << path;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+bool RunCheck(Method id) {
+  switch (id) {
+    case Method::kIsRooted:
+      return IsRooted();
+    case Method::kIsJailbroken:
+      return IsJailbroken();
+    case Method::kIsEmulator:
+      return IsEmulator();
+    case Method::kIsDebuggerAttached:
+      return IsDebuggerAttached();
+    case Method::kIsScreenCaptureBlocked:
+      return IsScreenCaptureFlagSet();
+    case Method::kIsUsbCableAttached:
+      // Answered from the device table; no sysfs walk per call.
+      return UsbDeviceTable::Instance().HasDevices();
+    case Method::kVerifyAppIntegrity:
+      return VerifyAppIntegrity();
+    case Method::kHasProxySettings:
+      return HasProxySettings();
+    case Method::kHasVPNConnection:
+      return HasVpnConnection();
+    case Method::kIsDeveloperModeEnabled:
+      return IsDeveloperModeEnabled();
+    default:
+      return false;
+  }
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,16 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_NATIVE_CHECKS_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_NATIVE_CHECKS_H_
+
+#include "check_registry.h"
+
+namespace ultra_secure_flutter_kit {
+
+// Answers the argument-free yes/no checks, i.e. the methods for which
+// MethodInfo::IsSnapshotCheck() holds, and logs what each one found.
+// Shared by the method channel and the C API so both answer from the same
+// USB and network tables. False for any other method.
+bool RunCheck(Method id);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_NATIVE_CHECKS_H_
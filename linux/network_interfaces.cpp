@@ -0,0 +1,361 @@
+#include "network_interfaces.h"
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <string_view>
+
+// Missing from glibc's <net/if_arp.h>; <linux/if_arp.h> clashes with <net/if.h>.
+#ifndef ARPHRD_IP6GRE
+#define ARPHRD_IP6GRE 823
+#endif
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+// Netlink never sends a dump datagram larger than this.
+constexpr size_t kDumpBufferSize = 32 * 1024;
+constexpr int kDumpTimeoutSeconds = 1;
+
+constexpr std::string_view kTunnelKinds[] = {
+    "tun",    "wireguard", "ipip",  "sit",       "gre",  "gretap",
+    "ip6gre", "ip6gretap", "vti",   "vti6",      "xfrm", "ip6tnl",
+    "l2tp",   "ovpn",
+};
+
+constexpr std::string_view kVirtualKinds[] = {
+    "bridge", "veth",   "vlan",   "macvlan", "macvtap", "ipvlan", "bond",
+    "team",   "dummy",  "vxlan",  "geneve",  "vrf",     "ifb",    "nlmon",
+};
+
+template <size_t N>
+bool Contains(const std::string_view (&kinds)[N], std::string_view kind) {
+  return std::find(std::begin(kinds), std::end(kinds), kind) !=
+         std::end(kinds);
+}
+
+InterfaceClass Classify(std::string_view kind, uint16_t hardware_type,
+                        bool has_master) {
+  if (hardware_type == ARPHRD_LOOPBACK) {
+    return InterfaceClass::kLoopback;
+  }
+  if (kind == "ppp" || hardware_type == ARPHRD_PPP) {
+    return InterfaceClass::kPpp;
+  }
+  // A tap enslaved to a bridge is a virtual machine's NIC (libvirt vnetN),
+  // not a VPN endpoint.
+  if (kind == "tun" && hardware_type == ARPHRD_ETHER && has_master) {
+    return InterfaceClass::kVirtual;
+  }
+  if (Contains(kTunnelKinds, kind)) {
+    return InterfaceClass::kTunnel;
+  }
+  if (Contains(kVirtualKinds, kind)) {
+    return InterfaceClass::kVirtual;
+  }
+  switch (hardware_type) {
+    case ARPHRD_NONE:  // raw L3 devices: tun, WireGuard
+    case ARPHRD_TUNNEL:
+    case ARPHRD_TUNNEL6:
+    case ARPHRD_IPGRE:
+    case ARPHRD_IP6GRE:
+    case ARPHRD_SIT:
+      return InterfaceClass::kTunnel;
+    case ARPHRD_ETHER:
+      return kind.empty() ? InterfaceClass::kEthernet : InterfaceClass::kOther;
+    default:
+      return InterfaceClass::kOther;
+  }
+}
+
+NetworkInterface ParseLink(const nlmsghdr* header) {
+  const auto* info = static_cast<const ifinfomsg*>(NLMSG_DATA(header));
+  NetworkInterface link;
+  link.index = info->ifi_index;
+  link.hardware_type = info->ifi_type;
+  link.is_up = (info->ifi_flags & IFF_UP) != 0;
+
+  bool has_master = false;
+  int length = static_cast<int>(IFLA_PAYLOAD(header));
+  for (auto* attribute = IFLA_RTA(info); RTA_OK(attribute, length);
+       attribute = RTA_NEXT(attribute, length)) {
+    switch (attribute->rta_type) {
+      case IFLA_IFNAME:
+        link.name = static_cast<const char*>(RTA_DATA(attribute));
+        break;
+      case IFLA_MASTER:
+        has_master = true;
+        break;
+      case IFLA_LINKINFO: {
+        int info_length = static_cast<int>(RTA_PAYLOAD(attribute));
+        for (auto* nested = static_cast<const rtattr*>(RTA_DATA(attribute));
+             RTA_OK(nested, info_length);
+             nested = RTA_NEXT(nested, info_length)) {
+          if (nested->rta_type == IFLA_INFO_KIND) {
+            link.kind = static_cast<const char*>(RTA_DATA(nested));
+          }
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  link.type = Classify(link.kind, link.hardware_type, has_master);
+  return link;
+}
+
+// Appends the output interfaces of a default route (or of either half of
+// a 0/1 + 128/1 pair) to `indexes`.
+void ParseRoute(const nlmsghdr* header, std::vector<int>* indexes) {
+  const auto* route = static_cast<const rtmsg*>(NLMSG_DATA(header));
+  if (route->rtm_type != RTN_UNICAST || route->rtm_dst_len > 1) {
+    return;
+  }
+  uint32_t table = route->rtm_table;
+  int output = 0;
+  const rtattr* multipath = nullptr;
+  int length = static_cast<int>(RTM_PAYLOAD(header));
+  for (auto* attribute = RTM_RTA(route); RTA_OK(attribute, length);
+       attribute = RTA_NEXT(attribute, length)) {
+    switch (attribute->rta_type) {
+      case RTA_TABLE:
+        table = *static_cast<const uint32_t*>(RTA_DATA(attribute));
+        break;
+      case RTA_OIF:
+        output = *static_cast<const int*>(RTA_DATA(attribute));
+        break;
+      case RTA_MULTIPATH:
+        multipath = attribute;
+        break;
+      default:
+        break;
+    }
+  }
+  if (table == RT_TABLE_LOCAL) {
+    return;
+  }
+  if (output != 0) {
+    indexes->push_back(output);
+  }
+  if (multipath != nullptr) {
+    int remaining = static_cast<int>(RTA_PAYLOAD(multipath));
+    for (auto* hop = static_cast<const rtnexthop*>(RTA_DATA(multipath));
+         remaining >= static_cast<int>(sizeof(rtnexthop)) &&
+         hop->rtnh_len >= sizeof(rtnexthop) && hop->rtnh_len <= remaining;
+         remaining -= RTNH_ALIGN(hop->rtnh_len), hop = RTNH_NEXT(hop)) {
+      indexes->push_back(hop->rtnh_ifindex);
+    }
+  }
+}
+
+// Sends a dump request and calls `handler` for each reply until
+// NLMSG_DONE. Returns false on error or timeout.
+template <typename Handler>
+bool RunDump(int fd, nlmsghdr* request, std::vector<char>* buffer,
+             Handler&& handler) {
+  if (send(fd, request, request->nlmsg_len, 0) < 0) {
+    return false;
+  }
+  for (;;) {
+    const ssize_t length = recv(fd, buffer->data(), buffer->size(), 0);
+    if (length <= 0) {
+      return false;
+    }
+    int remaining = static_cast<int>(length);
+    for (auto* header = reinterpret_cast<const nlmsghdr*>(buffer->data());
+         NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+      if (header->nlmsg_seq != request->nlmsg_seq) {
+        continue;  // left over from a dump that timed out
+      }
+      if (header->nlmsg_type == NLMSG_DONE) {
+        return true;
+      }
+      if (header->nlmsg_type == NLMSG_ERROR) {
+        return false;
+      }
+      handler(header);
+    }
+  }
+}
+
+}  // namespace
+
+const char* InterfaceClassName(InterfaceClass type) {
+  switch (type) {
+    case InterfaceClass::kLoopback:
+      return "loopback";
+    case InterfaceClass::kEthernet:
+      return "ethernet";
+    case InterfaceClass::kTunnel:
+      return "tunnel";
+    case InterfaceClass::kPpp:
+      return "ppp";
+    case InterfaceClass::kVirtual:
+      return "virtual";
+    case InterfaceClass::kOther:
+      return "other";
+  }
+  return "other";
+}
+
+NetworkInterfaceTable& NetworkInterfaceTable::Instance() {
+  static NetworkInterfaceTable* instance = new NetworkInterfaceTable();
+  return *instance;
+}
+
+NetworkInterfaceTable::NetworkInterfaceTable() : buffer_(kDumpBufferSize) {
+  notify_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                      NETLINK_ROUTE);
+  if (notify_fd_ >= 0) {
+    sockaddr_nl address{};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_ROUTE | RTMGRP_IPV6_ROUTE;
+    if (bind(notify_fd_, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) < 0) {
+      close(notify_fd_);
+      notify_fd_ = -1;
+    }
+  }
+
+  request_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (request_fd_ >= 0) {
+    timeval timeout{kDumpTimeoutSeconds, 0};
+    setsockopt(request_fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout,
+               sizeof(timeout));
+  }
+}
+
+NetworkInterfaceTable::~NetworkInterfaceTable() {
+  if (notify_fd_ >= 0) {
+    close(notify_fd_);
+  }
+  if (request_fd_ >= 0) {
+    close(request_fd_);
+  }
+}
+
+std::shared_ptr<const NetworkClassification> NetworkInterfaceTable::Get() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Subscribed before the first dump, so nothing between the two is lost.
+  if (DrainNotifications() || notify_fd_ < 0) {
+    dirty_ = true;
+  }
+  if (dirty_) {
+    if (auto dumped = Dump()) {
+      current_ = std::move(dumped);
+      dirty_ = false;
+    } else if (!current_) {
+      current_ = std::make_shared<const NetworkClassification>();
+    }
+  }
+  return current_;
+}
+
+bool NetworkInterfaceTable::DrainNotifications() {
+  if (notify_fd_ < 0) {
+    return false;
+  }
+  // Only whether anything arrived matters; MSG_TRUNC discards the payload.
+  bool changed = false;
+  char byte;
+  for (;;) {
+    const ssize_t length = recv(notify_fd_, &byte, 1, MSG_TRUNC);
+    if (length > 0 || (length < 0 && errno == ENOBUFS)) {
+      changed = true;
+      continue;
+    }
+    return changed;
+  }
+}
+
+std::shared_ptr<const NetworkClassification> NetworkInterfaceTable::Dump() {
+  if (request_fd_ < 0) {
+    return nullptr;
+  }
+  auto result = std::make_shared<NetworkClassification>();
+
+  struct {
+    nlmsghdr header;
+    ifinfomsg body;
+    rtattr mask_attribute;
+    uint32_t mask;
+  } link_request{};
+  link_request.header.nlmsg_len = sizeof(link_request);
+  link_request.header.nlmsg_type = RTM_GETLINK;
+  link_request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  link_request.header.nlmsg_seq = ++sequence_;
+  link_request.body.ifi_family = AF_UNSPEC;
+  // Leave out the per-link statistics, most of each reply's size.
+  link_request.mask_attribute.rta_type = IFLA_EXT_MASK;
+  link_request.mask_attribute.rta_len = RTA_LENGTH(sizeof(uint32_t));
+  link_request.mask = RTEXT_FILTER_SKIP_STATS;
+  const bool links_ok =
+      RunDump(request_fd_, &link_request.header, &buffer_,
+              [&](const nlmsghdr* header) {
+                if (header->nlmsg_type == RTM_NEWLINK) {
+                  result->interfaces.push_back(ParseLink(header));
+                }
+              });
+  if (!links_ok) {
+    return nullptr;
+  }
+
+  struct {
+    nlmsghdr header;
+    rtmsg body;
+  } route_request{};
+  route_request.header.nlmsg_len = sizeof(route_request);
+  route_request.header.nlmsg_type = RTM_GETROUTE;
+  route_request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+  route_request.header.nlmsg_seq = ++sequence_;
+  route_request.body.rtm_family = AF_UNSPEC;
+  std::vector<int> default_routes;
+  const bool routes_ok =
+      RunDump(request_fd_, &route_request.header, &buffer_,
+              [&](const nlmsghdr* header) {
+                if (header->nlmsg_type == RTM_NEWROUTE) {
+                  ParseRoute(header, &default_routes);
+                }
+              });
+  if (!routes_ok) {
+    return nullptr;
+  }
+
+  auto& interfaces = result->interfaces;
+  std::sort(interfaces.begin(), interfaces.end(),
+            [](const NetworkInterface& a, const NetworkInterface& b) {
+              return a.index < b.index;
+            });
+  for (const NetworkInterface& link : interfaces) {
+    if (std::find(default_routes.begin(), default_routes.end(), link.index) ==
+        default_routes.end()) {
+      continue;
+    }
+    result->default_route_interfaces.push_back(link.name);
+    if (link.IsTunnel() && !result->default_route_via_tunnel) {
+      result->default_route_via_tunnel = true;
+      result->vpn_interface = link.name;
+    }
+  }
+  if (result->vpn_interface.empty()) {
+    for (const NetworkInterface& link : interfaces) {
+      if (link.IsTunnel() && link.is_up) {
+        result->vpn_interface = link.name;
+        break;
+      }
+    }
+  }
+  result->has_vpn = !result->vpn_interface.empty();
+  return result;
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,91 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_NETWORK_INTERFACES_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_NETWORK_INTERFACES_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+enum class InterfaceClass {
+  kLoopback,
+  kEthernet,
+  kTunnel,   // tun/tap, WireGuard, IPsec (xfrm/vti), GRE, IP-in-IP, ...
+  kPpp,      // PPP links, which carry L2TP and PPTP VPNs
+  kVirtual,  // bridges, veth pairs, VLANs, container overlays
+  kOther,
+};
+
+// Stable name used on the Dart side.
+const char* InterfaceClassName(InterfaceClass type);
+
+struct NetworkInterface {
+  int index = 0;
+  std::string name;
+  std::string kind;            // IFLA_INFO_KIND ("wireguard", "tun"), if any
+  uint16_t hardware_type = 0;  // ARPHRD_*
+  InterfaceClass type = InterfaceClass::kOther;
+  bool is_up = false;
+
+  bool IsTunnel() const {
+    return type == InterfaceClass::kTunnel || type == InterfaceClass::kPpp;
+  }
+};
+
+struct NetworkClassification {
+  std::vector<NetworkInterface> interfaces;  // ordered by index
+  // Interfaces carrying a default route (0/0, or the 0/1 + 128/1 pair
+  // OpenVPN installs) in any routing table, so VPNs that route through a
+  // policy table (wg-quick, Tailscale exit nodes) count too.
+  std::vector<std::string> default_route_interfaces;
+  bool default_route_via_tunnel = false;
+  // A tunnel carries a default route or is up.
+  bool has_vpn = false;
+  // The tunnel behind has_vpn, preferring one that carries a default route.
+  std::string vpn_interface;
+};
+
+// Classifies network interfaces by link kind and hardware type rather
+// than by name, from one RTM_GETLINK and one RTM_GETROUTE dump.
+//
+// The constructor subscribes to link and route notifications; every query
+// drains them without blocking (one recv() when nothing changed) and only
+// dumps again if something arrived, so calling it at high frequency costs
+// next to nothing. Without the subscription (no netlink in a sandbox),
+// every query dumps.
+class NetworkInterfaceTable {
+ public:
+  // The table the plugin and the C API answer from.
+  static NetworkInterfaceTable& Instance();
+
+  NetworkInterfaceTable();
+  ~NetworkInterfaceTable();
+
+  NetworkInterfaceTable(const NetworkInterfaceTable&) = delete;
+  NetworkInterfaceTable& operator=(const NetworkInterfaceTable&) = delete;
+
+  // Current classification; the returned snapshot is never modified.
+  std::shared_ptr<const NetworkClassification> Get();
+
+  bool HasVpn() { return Get()->has_vpn; }
+
+  bool IsWatching() const { return notify_fd_ >= 0; }
+
+ private:
+  bool DrainNotifications();
+  std::shared_ptr<const NetworkClassification> Dump();
+
+  int notify_fd_ = -1;
+  int request_fd_ = -1;
+  std::mutex mutex_;
+  uint32_t sequence_ = 0;
+  bool dirty_ = true;
+  std::vector<char> buffer_;
+  std::shared_ptr<const NetworkClassification> current_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_NETWORK_INTERFACES_H_
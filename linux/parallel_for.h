@@ -0,0 +1,52 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_PARALLEL_FOR_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+// Calls `body(i)` for every i in [0, count) on up to `max_workers` threads,
+// the calling thread included. Workers claim indices from a shared counter,
+// so uneven items balance themselves. `body` may return false to stop
+// further items from being claimed (items already running finish).
+template <typename Body>
+void ParallelFor(size_t count, size_t max_workers, Body&& body) {
+  const size_t worker_count = std::min(count, std::max<size_t>(1, max_workers));
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> stopped{false};
+  auto worker = [&]() {
+    while (!stopped.load(std::memory_order_relaxed)) {
+      const size_t i = next.fetch_add(1);
+      if (i >= count) {
+        return;
+      }
+      if (!body(i)) {
+        stopped.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(worker_count > 0 ? worker_count - 1 : 0);
+  for (size_t i = 1; i < worker_count; ++i) {
+    workers.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : workers) {
+    thread.join();
+  }
+}
+
+// Worker count for CPU-bound work.
+inline size_t HardwareWorkers() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_PARALLEL_FOR_H_
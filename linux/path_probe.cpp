@@ -0,0 +1,216 @@
+#include "path_probe.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/magic.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <sys/vfs.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "filesystem_root.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+// Directories modified more recently than this are not cached: on
+// filesystems with coarse timestamps a second change in the same tick
+// would leave the mtime unchanged.
+constexpr int64_t kRacyWindowNs = 2'000'000'000;
+
+// Most batches touch a handful of directories.
+constexpr size_t kMaxBatchDirectories = 16;
+
+std::atomic<bool> statx_unsupported{false};
+
+// Identity and mtime of `path` relative to `dirfd` (AT_EMPTY_PATH for the
+// descriptor itself). Uses statx() so only the needed fields are fetched,
+// falling back to fstatat() on kernels older than 4.11.
+bool StatDirectory(int dirfd, const char* path, int flags, dev_t* device,
+                   ino_t* inode, int64_t* mtime_ns) {
+  if (!statx_unsupported.load(std::memory_order_relaxed)) {
+    struct statx status;
+    if (statx(dirfd, path, flags, STATX_TYPE | STATX_INO | STATX_MTIME,
+              &status) == 0) {
+      if (!S_ISDIR(status.stx_mode)) {
+        return false;
+      }
+      *device = makedev(status.stx_dev_major, status.stx_dev_minor);
+      *inode = status.stx_ino;
+      *mtime_ns = status.stx_mtime.tv_sec * 1'000'000'000LL +
+                  status.stx_mtime.tv_nsec;
+      return true;
+    }
+    if (errno != ENOSYS) {
+      return false;
+    }
+    statx_unsupported.store(true, std::memory_order_relaxed);
+  }
+
+  struct stat status;
+  if (fstatat(dirfd, path, &status, flags) != 0 || !S_ISDIR(status.st_mode)) {
+    return false;
+  }
+  *device = status.st_dev;
+  *inode = status.st_ino;
+  *mtime_ns = status.st_mtim.tv_sec * 1'000'000'000LL + status.st_mtim.tv_nsec;
+  return true;
+}
+
+// Pseudo filesystems generate their entries on lookup and leave directory
+// mtimes untouched when entries come and go.
+bool HasReliableMtime(int fd) {
+  struct statfs filesystem;
+  if (fstatfs(fd, &filesystem) != 0) {
+    return false;
+  }
+  switch (filesystem.f_type) {
+    case PROC_SUPER_MAGIC:
+    case SYSFS_MAGIC:
+    case DEBUGFS_MAGIC:
+    case CGROUP_SUPER_MAGIC:
+    case CGROUP2_SUPER_MAGIC:
+      return false;
+    default:
+      return true;
+  }
+}
+
+int64_t NowNs() {
+  struct timespec now;
+  clock_gettime(CLOCK_REALTIME, &now);
+  return now.tv_sec * 1'000'000'000LL + now.tv_nsec;
+}
+
+}  // namespace
+
+PathProbe& PathProbe::Instance() {
+  static PathProbe* instance = new PathProbe();
+  return *instance;
+}
+
+void PathProbe::Probe(const char* const* paths, size_t count, bool* results) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::string_view parents[kMaxBatchDirectories];
+  Directory* directories[kMaxBatchDirectories];
+  size_t validated = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const std::string_view path = paths[i];
+    const size_t slash = path.rfind('/');
+    const std::string_view parent = path.substr(0, slash == 0 ? 1 : slash);
+    const std::string_view name = path.substr(slash + 1);
+
+    Directory* directory = nullptr;
+    for (size_t j = 0; j < validated; ++j) {
+      if (parents[j] == parent) {
+        directory = directories[j];
+        break;
+      }
+    }
+    if (directory == nullptr) {
+      const RootedPath rooted(parent);
+      auto it = directories_.find(std::string_view(rooted.c_str()));
+      if (it == directories_.end()) {
+        it = directories_.emplace(rooted.c_str(), Directory()).first;
+      }
+      directory = &it->second;
+      Validate(rooted.c_str(), directory);
+      if (validated < kMaxBatchDirectories) {
+        parents[validated] = parent;
+        directories[validated] = directory;
+        ++validated;
+      }
+    }
+    results[i] = Lookup(directory, name);
+  }
+}
+
+int PathProbe::FindFirst(const char* const* paths, size_t count) {
+  bool results[64];
+  for (size_t start = 0; start < count; start += 64) {
+    const size_t batch = std::min<size_t>(count - start, 64);
+    Probe(paths + start, batch, results);
+    for (size_t i = 0; i < batch; ++i) {
+      if (results[i]) {
+        return static_cast<int>(start + i);
+      }
+    }
+  }
+  return -1;
+}
+
+void PathProbe::Validate(const char* path, Directory* directory) {
+  DirectoryKey current;
+  if (!StatDirectory(AT_FDCWD, path, 0, &current.device, &current.inode,
+                     &current.mtime_ns)) {
+    // Gone, or never was a directory: every child is missing.
+    if (directory->fd >= 0) {
+      close(directory->fd);
+      directory->fd = -1;
+    }
+    directory->children.clear();
+    return;
+  }
+
+  if (directory->fd < 0 || current.device != directory->key.device ||
+      current.inode != directory->key.inode) {
+    // First use, or the directory was replaced since it was opened.
+    if (directory->fd >= 0) {
+      close(directory->fd);
+    }
+    directory->children.clear();
+    directory->fd = open(path, O_PATH | O_DIRECTORY | O_CLOEXEC);
+    if (directory->fd < 0) {
+      return;
+    }
+    // Key the cache on what was opened, which may differ from `current`
+    // if the path was swapped in between.
+    if (!StatDirectory(directory->fd, "", AT_EMPTY_PATH, &current.device,
+                       &current.inode, &current.mtime_ns)) {
+      close(directory->fd);
+      directory->fd = -1;
+      return;
+    }
+    directory->cacheable = HasReliableMtime(directory->fd);
+  } else if (current.mtime_ns != directory->key.mtime_ns) {
+    directory->children.clear();
+  }
+  directory->key = current;
+}
+
+bool PathProbe::Lookup(Directory* directory, std::string_view name) {
+  if (directory->fd < 0) {
+    return false;
+  }
+  for (const auto& [child, exists] : directory->children) {
+    if (child == name) {
+      return exists;
+    }
+  }
+
+  char child_name[NAME_MAX + 1];
+  if (name.empty() || name.size() > NAME_MAX) {
+    return false;
+  }
+  name.copy(child_name, name.size());
+  child_name[name.size()] = '\0';
+  const bool exists = faccessat(directory->fd, child_name, F_OK, 0) == 0;
+
+  // Answers are kept only once the directory has been quiet for a while;
+  // until then every batch looks the child up again.
+  if (directory->cacheable &&
+      NowNs() - directory->key.mtime_ns >= kRacyWindowNs) {
+    directory->children.emplace_back(std::string(name), exists);
+  }
+  return exists;
+}
+
+}  // namespace ultra_secure_flutter_kit
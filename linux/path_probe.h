@@ -0,0 +1,69 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_PATH_PROBE_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_PATH_PROBE_H_
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+// Answers "does this path exist" for batches of absolute paths, resolved
+// under FilesystemRoot().
+//
+// Probes are grouped by parent directory. Each parent is held open as an
+// O_PATH descriptor and revalidated once per batch with a single statx();
+// children are then looked up with faccessat() relative to it. Answers are
+// cached per directory until its device, inode or mtime changes, so a
+// batch whose directories are unchanged costs one statx() per directory
+// and no lookups at all. Directories whose mtime does not track their
+// entries (procfs, sysfs) are never cached, and neither are directories
+// modified within the last couple of seconds, where a coarse timestamp
+// could hide a second change.
+class PathProbe {
+ public:
+  static PathProbe& Instance();
+
+  PathProbe(const PathProbe&) = delete;
+  PathProbe& operator=(const PathProbe&) = delete;
+
+  // Sets results[i] to whether paths[i] exists. Paths must be absolute
+  // and name a file inside a directory (not "/").
+  void Probe(const char* const* paths, size_t count, bool* results);
+
+  // Index of the first of `paths` that exists, or -1.
+  int FindFirst(const char* const* paths, size_t count);
+
+ private:
+  struct DirectoryKey {
+    dev_t device = 0;
+    ino_t inode = 0;
+    int64_t mtime_ns = 0;
+  };
+
+  struct Directory {
+    int fd = -1;
+    DirectoryKey key;
+    // Whether cached answers may be used; see the class comment.
+    bool cacheable = false;
+    std::vector<std::pair<std::string, bool>> children;
+  };
+
+  PathProbe() = default;
+
+  void Validate(const char* path, Directory* directory);
+  bool Lookup(Directory* directory, std::string_view name);
+
+  std::mutex mutex_;
+  std::map<std::string, Directory, std::less<>> directories_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_PATH_PROBE_H_
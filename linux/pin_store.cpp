@@ -0,0 +1,143 @@
+#include "pin_store.h"
+
+#include <openssl/evp.h>
+
+#include <cstring>
+#include <thread>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr std::string_view kPinPrefix = "sha256/";
+
+// base64 of 32 bytes: 43 characters plus one '=' of padding.
+constexpr size_t kEncodedDigestLength = 44;
+
+SecureVector<Sha256> DecodePins(const std::vector<std::string>& pins,
+                                size_t* rejected) {
+  SecureVector<Sha256> digests;
+  digests.reserve(pins.size());
+  Sha256 digest;
+  for (const auto& pin : pins) {
+    if (DecodePin(pin, &digest)) {
+      digests.push_back(digest);
+    } else {
+      ++*rejected;
+    }
+  }
+  SecureZero(digest.data(), digest.size());
+  return digests;
+}
+
+}  // namespace
+
+bool DecodePin(std::string_view pin, Sha256* digest) {
+  if (pin.substr(0, kPinPrefix.size()) == kPinPrefix) {
+    pin.remove_prefix(kPinPrefix.size());
+  }
+  if (pin.size() != kEncodedDigestLength || pin[42] == '=' ||
+      pin[43] != '=') {
+    return false;
+  }
+  // EVP_DecodeBlock counts the padding as a decoded zero byte.
+  unsigned char decoded[sizeof(Sha256) + 1];
+  const bool valid =
+      EVP_DecodeBlock(decoded,
+                      reinterpret_cast<const unsigned char*>(pin.data()),
+                      static_cast<int>(pin.size())) ==
+      static_cast<int>(sizeof(decoded));
+  if (valid) {
+    memcpy(digest->data(), decoded, digest->size());
+  }
+  SecureZero(decoded, sizeof(decoded));
+  return valid;
+}
+
+DigestSet::DigestSet(const SecureVector<Sha256>& digests) {
+  // Load factor of at most one half keeps probe sequences short.
+  size_t capacity = 8;
+  while (capacity < digests.size() * 2) {
+    capacity *= 2;
+  }
+  slots_.resize(capacity);
+  used_.assign(capacity, false);
+  mask_ = capacity - 1;
+
+  for (const auto& digest : digests) {
+    const size_t slot = SlotFor(digest);
+    if (!used_[slot]) {
+      slots_[slot] = digest;
+      used_[slot] = true;
+      ++size_;
+    }
+  }
+}
+
+size_t DigestSet::SlotFor(const Sha256& digest) const {
+  uint64_t hash;
+  memcpy(&hash, digest.data(), sizeof(hash));
+  size_t slot = static_cast<size_t>(hash) & mask_;
+  while (used_[slot] && slots_[slot] != digest) {
+    slot = (slot + 1) & mask_;
+  }
+  return slot;
+}
+
+bool DigestSet::Contains(const Sha256& digest) const {
+  return size_ != 0 && used_[SlotFor(digest)];
+}
+
+PinStore::Reader::Reader(const PinStore& store) : store_(store) {
+  // Registering under an epoch that flipped before the increment became
+  // visible would not be waited for, so re-check and retry.
+  for (;;) {
+    epoch_ = store_.epoch_.load();
+    store_.readers_[epoch_].fetch_add(1);
+    if (store_.epoch_.load() == epoch_) {
+      break;
+    }
+    store_.readers_[epoch_].fetch_sub(1);
+  }
+  pins_ = store_.current_.load();
+}
+
+PinStore::Reader::~Reader() { store_.readers_[epoch_].fetch_sub(1); }
+
+PinStore::PinStore() : current_(new PinSet()) {}
+
+PinStore::~PinStore() { delete current_.load(); }
+
+size_t PinStore::Update(const std::vector<std::string>& certificate_pins,
+                        const std::vector<std::string>& public_key_pins) {
+  size_t rejected = 0;
+  auto* pins = new PinSet();
+  pins->certificates = DigestSet(DecodePins(certificate_pins, &rejected));
+  pins->public_keys = DigestSet(DecodePins(public_key_pins, &rejected));
+
+  std::lock_guard<std::mutex> lock(update_mutex_);
+  pins->generation = current_.load()->generation + 1;
+  const PinSet* previous = current_.exchange(pins);
+  // Grace period: a reader that could still see `previous` registered
+  // under the epoch that is current now.
+  const unsigned epoch = epoch_.load();
+  epoch_.store(epoch ^ 1);
+  while (readers_[epoch].load() != 0) {
+    std::this_thread::yield();
+  }
+  delete previous;
+  return rejected;
+}
+
+bool PinStore::empty() const {
+  Reader reader(*this);
+  return reader.pins().public_keys.empty() &&
+         reader.pins().certificates.empty();
+}
+
+uint64_t PinStore::generation() const {
+  Reader reader(*this);
+  return reader.pins().generation;
+}
+
+}  // namespace ultra_secure_flutter_kit
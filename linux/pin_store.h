@@ -0,0 +1,99 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_PIN_STORE_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_PIN_STORE_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "secure_memory.h"
+
+namespace ultra_secure_flutter_kit {
+
+using Sha256 = std::array<uint8_t, 32>;
+
+// Decodes "sha256/<base64>" (or bare base64) into a digest.
+bool DecodePin(std::string_view pin, Sha256* digest);
+
+// Open-addressing set of SHA-256 digests with linear probing. Built once
+// and never modified, so lookups need no synchronisation. The digests are
+// uniformly distributed already, so their first eight bytes are the hash.
+// The table lives in SecureArena memory.
+class DigestSet {
+ public:
+  DigestSet() = default;
+  explicit DigestSet(const SecureVector<Sha256>& digests);
+
+  bool Contains(const Sha256& digest) const;
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  size_t SlotFor(const Sha256& digest) const;
+
+  SecureVector<Sha256> slots_;
+  std::vector<bool> used_;
+  size_t mask_ = 0;
+  size_t size_ = 0;
+};
+
+struct PinSet {
+  DigestSet public_keys;   // SHA-256 of DER SubjectPublicKeyInfo
+  DigestSet certificates;  // SHA-256 of DER certificate
+  uint64_t generation = 0;
+};
+
+// Holds the active pin set and swaps it without blocking readers.
+//
+// Readers register in one of two counters selected by the current epoch,
+// load the current pointer and use the set in place. Update() publishes a
+// new set with one atomic exchange, flips the epoch so new readers use the
+// other counter, and frees the old set once the counter of the previous
+// epoch drains. Only readers that started before the flip are waited for,
+// so a steady stream of lookups cannot starve a rotation, and an in-flight
+// verification always sees one whole set, old or new.
+class PinStore {
+ public:
+  class Reader {
+   public:
+    explicit Reader(const PinStore& store);
+    ~Reader();
+
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    const PinSet& pins() const { return *pins_; }
+
+   private:
+    const PinStore& store_;
+    unsigned epoch_;
+    const PinSet* pins_;
+  };
+
+  PinStore();
+  ~PinStore();
+
+  PinStore(const PinStore&) = delete;
+  PinStore& operator=(const PinStore&) = delete;
+
+  // Decodes and publishes a new pin set. Returns the number of pins that
+  // were not valid base64 SHA-256 digests and were skipped.
+  size_t Update(const std::vector<std::string>& certificate_pins,
+                const std::vector<std::string>& public_key_pins);
+
+  bool empty() const;
+  uint64_t generation() const;
+
+ private:
+  std::atomic<const PinSet*> current_;
+  std::atomic<unsigned> epoch_{0};
+  mutable std::atomic<uint64_t> readers_[2] = {};
+  std::mutex update_mutex_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_PIN_STORE_H_
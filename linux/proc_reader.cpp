@@ -0,0 +1,143 @@
+#include "proc_reader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <charconv>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+bool IsTrimmed(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '"';
+}
+
+std::string_view Trim(std::string_view text) {
+  while (!text.empty() && IsTrimmed(text.front())) {
+    text.remove_prefix(1);
+  }
+  while (!text.empty() && IsTrimmed(text.back())) {
+    text.remove_suffix(1);
+  }
+  return text;
+}
+
+long PreadFully(int fd, char* buffer, size_t capacity, long offset) {
+  size_t total = 0;
+  while (total < capacity) {
+    const ssize_t count =
+        pread(fd, buffer + total, capacity - total, offset + total);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return total > 0 ? static_cast<long>(total) : -1;
+    }
+    if (count == 0) {
+      break;
+    }
+    total += static_cast<size_t>(count);
+  }
+  return static_cast<long>(total);
+}
+
+}  // namespace
+
+namespace internal {
+
+int OpenReadOnly(const char* path) {
+  return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+long ReadChunk(int fd, char* buffer, size_t capacity, long offset) {
+  return PreadFully(fd, buffer, capacity, offset);
+}
+
+void CloseFd(int fd) { close(fd); }
+
+}  // namespace internal
+
+std::string_view ReadFile(const char* path, char* buffer, size_t capacity) {
+  const int fd = internal::OpenReadOnly(path);
+  if (fd < 0) {
+    return std::string_view();
+  }
+  const long count = PreadFully(fd, buffer, capacity, 0);
+  close(fd);
+  return count > 0 ? std::string_view(buffer, static_cast<size_t>(count))
+                   : std::string_view();
+}
+
+CachedProcFile::CachedProcFile(const char* path)
+    : fd_(internal::OpenReadOnly(path)) {}
+
+CachedProcFile::~CachedProcFile() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+std::string_view CachedProcFile::Read(char* buffer, size_t capacity) const {
+  if (fd_ < 0) {
+    return std::string_view();
+  }
+  const long count = PreadFully(fd_, buffer, capacity, 0);
+  return count > 0 ? std::string_view(buffer, static_cast<size_t>(count))
+                   : std::string_view();
+}
+
+std::string_view FindLine(std::string_view content, std::string_view prefix) {
+  size_t start = 0;
+  while (start < content.size()) {
+    size_t end = content.find('\n', start);
+    if (end == std::string_view::npos) {
+      end = content.size();
+    }
+    const std::string_view line = content.substr(start, end - start);
+    if (line.substr(0, prefix.size()) == prefix) {
+      return line;
+    }
+    start = end + 1;
+  }
+  return std::string_view();
+}
+
+std::string_view FindField(std::string_view content, std::string_view key,
+                           char separator) {
+  size_t start = 0;
+  while (start < content.size()) {
+    size_t end = content.find('\n', start);
+    if (end == std::string_view::npos) {
+      end = content.size();
+    }
+    const std::string_view line = content.substr(start, end - start);
+    if (line.size() > key.size() && line[key.size()] == separator &&
+        line.substr(0, key.size()) == key) {
+      return Trim(line.substr(key.size() + 1));
+    }
+    start = end + 1;
+  }
+  return std::string_view();
+}
+
+bool ParseInt(std::string_view text, long* value) {
+  text = Trim(text);
+  if (text.empty()) {
+    return false;
+  }
+  const auto result = std::from_chars(text.data(), text.data() + text.size(),
+                                      *value);
+  return result.ec == std::errc();
+}
+
+bool ReadSelfStatusField(std::string_view key, long* value) {
+  // Opened once; the kernel regenerates the contents on each pread.
+  static const CachedProcFile status("/proc/self/status");
+  char buffer[kProcBufferSize];
+  const std::string_view content = status.Read(buffer, sizeof(buffer));
+  return ParseInt(FindField(content, key, ':'), value);
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,124 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_PROC_READER_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_PROC_READER_H_
+
+#include <cstddef>
+#include <string_view>
+
+namespace ultra_secure_flutter_kit {
+
+// Allocation-free helpers for the small text files under /proc, /sys and
+// /etc that the security checks read. Contents are returned as views into
+// a caller-owned (usually stack) buffer and parsed in place.
+
+// Size that comfortably holds /proc/self/status, os-release and sysfs
+// attributes. Longer files are truncated by ReadFile(); use ScanLines().
+constexpr size_t kProcBufferSize = 4096;
+
+// Reads up to `capacity` bytes of `path` with open/pread/close. Returns an
+// empty view if the file cannot be read.
+std::string_view ReadFile(const char* path, char* buffer, size_t capacity);
+
+// A file descriptor that stays open across reads. Files generated on read
+// (like /proc/self/status) return fresh contents on every pread at offset
+// zero, so re-reading costs one syscall instead of three.
+class CachedProcFile {
+ public:
+  explicit CachedProcFile(const char* path);
+  ~CachedProcFile();
+
+  CachedProcFile(const CachedProcFile&) = delete;
+  CachedProcFile& operator=(const CachedProcFile&) = delete;
+
+  bool is_open() const { return fd_ >= 0; }
+  std::string_view Read(char* buffer, size_t capacity) const;
+
+ private:
+  int fd_;
+};
+
+// Returns the line in `content` that starts with `prefix`, without the
+// trailing newline, or an empty view.
+std::string_view FindLine(std::string_view content, std::string_view prefix);
+
+// Returns the value of "key<separator>value" in `content`, trimmed of
+// surrounding whitespace and double quotes. Works for /proc/self/status
+// ("TracerPid:\t0") and os-release ("PRETTY_NAME=\"...\"") layouts.
+std::string_view FindField(std::string_view content, std::string_view key,
+                           char separator);
+
+// Parses a decimal integer, ignoring surrounding whitespace.
+bool ParseInt(std::string_view text, long* value);
+
+// Calls `visitor(line)` for each line of `path` until it returns false,
+// reading in fixed-size chunks so arbitrarily large files (e.g.
+// /proc/cpuinfo on many-core hosts) never touch the heap. Lines longer
+// than the chunk are split. Returns false if the file could not be opened.
+template <typename Visitor>
+bool ScanLines(const char* path, Visitor&& visitor);
+
+// Reads an integer field of /proc/self/status through a process-wide
+// kept-open descriptor.
+bool ReadSelfStatusField(std::string_view key, long* value);
+
+namespace internal {
+int OpenReadOnly(const char* path);
+long ReadChunk(int fd, char* buffer, size_t capacity, long offset);
+void CloseFd(int fd);
+}  // namespace internal
+
+template <typename Visitor>
+bool ScanLines(const char* path, Visitor&& visitor) {
+  const int fd = internal::OpenReadOnly(path);
+  if (fd < 0) {
+    return false;
+  }
+
+  char buffer[kProcBufferSize];
+  size_t carried = 0;
+  long offset = 0;
+  for (;;) {
+    const long count =
+        internal::ReadChunk(fd, buffer + carried, sizeof(buffer) - carried,
+                            offset);
+    if (count <= 0) {
+      if (carried > 0) {
+        visitor(std::string_view(buffer, carried));
+      }
+      break;
+    }
+    offset += count;
+    const size_t filled = carried + static_cast<size_t>(count);
+
+    size_t start = 0;
+    bool keep_going = true;
+    for (size_t i = 0; i < filled && keep_going; ++i) {
+      if (buffer[i] == '\n') {
+        keep_going = visitor(std::string_view(buffer + start, i - start));
+        start = i + 1;
+      }
+    }
+    if (!keep_going) {
+      break;
+    }
+
+    carried = filled - start;
+    if (carried == sizeof(buffer)) {
+      // A single line filled the whole buffer; hand it over in pieces.
+      if (!visitor(std::string_view(buffer, carried))) {
+        break;
+      }
+      carried = 0;
+    } else if (start > 0 && carried > 0) {
+      for (size_t i = 0; i < carried; ++i) {
+        buffer[i] = buffer[start + i];
+      }
+    }
+  }
+
+  internal::CloseFd(fd);
+  return true;
+}
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_PROC_READER_H_
@@ -0,0 +1,433 @@
+#include "process_monitor.h"
+
+#include <dirent.h>
+#include <limits.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+#include "parallel_for.h"
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr size_t kReceiveBufferSize = 16 * 1024;
+constexpr int kSocketBufferSize = 1024 * 1024;
+constexpr int kAckTimeoutMs = 250;
+constexpr int64_t kRescanIntervalMs = 1000;
+// Processes read per scan worker; small hosts are scanned inline.
+constexpr size_t kProcessesPerWorker = 512;
+// TASK_COMM_LEN minus the terminator.
+constexpr size_t kCommLength = 15;
+
+int64_t NowMillis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void CloseFd(int* fd) {
+  if (*fd >= 0) {
+    close(*fd);
+    *fd = -1;
+  }
+}
+
+bool SendMulticastOp(int fd, proc_cn_mcast_op op) {
+  alignas(nlmsghdr) char buffer[NLMSG_SPACE(sizeof(cn_msg) + sizeof(op))] = {};
+  auto* header = reinterpret_cast<nlmsghdr*>(buffer);
+  header->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(op));
+  header->nlmsg_type = NLMSG_DONE;
+  auto* message = static_cast<cn_msg*>(NLMSG_DATA(header));
+  message->id.idx = CN_IDX_PROC;
+  message->id.val = CN_VAL_PROC;
+  message->len = sizeof(op);
+  memcpy(message->data, &op, sizeof(op));
+  return send(fd, header, header->nlmsg_len, 0) ==
+         static_cast<ssize_t>(header->nlmsg_len);
+}
+
+// Calls `handler(event)` for every proc connector event in a datagram.
+template <typename Handler>
+void ForEachProcEvent(const char* buffer, ssize_t length, Handler&& handler) {
+  int remaining = static_cast<int>(length);
+  for (auto* header = reinterpret_cast<const nlmsghdr*>(buffer);
+       NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+    if (header->nlmsg_type == NLMSG_ERROR ||
+        header->nlmsg_type == NLMSG_NOOP) {
+      continue;
+    }
+    const auto* message = static_cast<const cn_msg*>(NLMSG_DATA(header));
+    if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC ||
+        message->len < sizeof(proc_event)) {
+      continue;
+    }
+    handler(*reinterpret_cast<const proc_event*>(message->data));
+  }
+}
+
+// The kernel answers a LISTEN request with an ack carrying its error code,
+// EPERM without CAP_NET_ADMIN. Events from other listeners may arrive
+// first; they predate the scan and are dropped.
+bool WaitForListenAck(int fd) {
+  alignas(nlmsghdr) char buffer[kReceiveBufferSize];
+  const int64_t deadline = NowMillis() + kAckTimeoutMs;
+  for (;;) {
+    const int64_t remaining = deadline - NowMillis();
+    pollfd poll_fd{fd, POLLIN, 0};
+    if (remaining <= 0 || poll(&poll_fd, 1, static_cast<int>(remaining)) <= 0) {
+      return false;
+    }
+    const ssize_t length = recv(fd, buffer, sizeof(buffer), 0);
+    if (length <= 0) {
+      continue;
+    }
+    int error = -1;
+    ForEachProcEvent(buffer, length, [&](const proc_event& event) {
+      if (event.what == proc_event::PROC_EVENT_NONE) {
+        error = static_cast<int>(event.event_data.ack.err);
+      }
+    });
+    if (error >= 0) {
+      return error == 0;
+    }
+  }
+}
+
+std::string_view Basename(std::string_view path) {
+  const size_t slash = path.rfind('/');
+  return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+}  // namespace
+
+std::vector<std::string> DefaultProcessSignatures() {
+  return {
+      // Debuggers.
+      "gdb", "gdbserver", "gdb-multiarch", "lldb*", "edb", "ida", "ida64",
+      "r2", "radare2", "rr",
+      // Tracers and instrumentation.
+      "strace", "ltrace", "frida*", "valgrind", "bpftrace",
+  };
+}
+
+bool ReadProcessInfo(pid_t pid, ProcessInfo* process) {
+  char path[32];
+  char buffer[64];
+  snprintf(path, sizeof(path), "/proc/%d/comm", static_cast<int>(pid));
+  std::string_view name = ReadFile(path, buffer, sizeof(buffer));
+  if (name.empty()) {
+    return false;
+  }
+  name = name.substr(0, name.find('\n'));
+
+  // Unreadable for other users' processes without ptrace access, and
+  // absent for kernel threads; the name is still matched.
+  char target[PATH_MAX];
+  snprintf(path, sizeof(path), "/proc/%d/exe", static_cast<int>(pid));
+  const ssize_t length = readlink(path, target, sizeof(target));
+  std::string_view exe;
+  if (length > 0 && static_cast<size_t>(length) < sizeof(target)) {
+    exe = std::string_view(target, length);
+    constexpr std::string_view kDeleted = " (deleted)";
+    if (exe.size() > kDeleted.size() &&
+        exe.substr(exe.size() - kDeleted.size()) == kDeleted) {
+      exe.remove_suffix(kDeleted.size());
+    }
+  }
+
+  process->pid = pid;
+  process->name.assign(name.data(), name.size());
+  process->exe.assign(exe.data(), exe.size());
+  process->signature.clear();
+  return true;
+}
+
+ProcessMonitor::ProcessMonitor(std::vector<std::string> signatures)
+    : signatures_(std::move(signatures)) {}
+
+ProcessMonitor::~ProcessMonitor() { Stop(); }
+
+bool ProcessMonitor::Start() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+  if (started_) {
+    return IsEventDriven();
+  }
+  started_ = true;
+
+  if (OpenConnector()) {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (epoll_fd_ >= 0 && wake_fd_ >= 0) {
+      epoll_event event{};
+      event.events = EPOLLIN;
+      event.data.fd = wake_fd_;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event);
+      event.data.fd = connector_fd_;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, connector_fd_, &event);
+    } else {
+      CloseConnector();
+      CloseFd(&epoll_fd_);
+      CloseFd(&wake_fd_);
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> table_lock(mutex_);
+    RescanLocked();
+  }
+
+  if (IsEventDriven()) {
+    running_.store(true);
+    thread_ = std::thread(&ProcessMonitor::Run, this);
+  }
+  return IsEventDriven();
+}
+
+void ProcessMonitor::Stop() {
+  std::lock_guard<std::mutex> lock(start_mutex_);
+
+  if (running_.exchange(false)) {
+    const uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) {
+      // The thread also re-checks running_ after every wakeup.
+    }
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  CloseConnector();
+  CloseFd(&wake_fd_);
+  CloseFd(&epoll_fd_);
+  started_ = false;
+
+  std::lock_guard<std::mutex> table_lock(mutex_);
+  stale_ = true;
+}
+
+void ProcessMonitor::SetSignatures(std::vector<std::string> signatures) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  signatures_ = std::move(signatures);
+  stale_ = true;
+}
+
+std::vector<ProcessInfo> ProcessMonitor::Matches() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stale_ ||
+      (!IsEventDriven() && NowMillis() - scanned_at_ms_ >= kRescanIntervalMs)) {
+    RescanLocked();
+  }
+
+  std::vector<ProcessInfo> matches;
+  matches.reserve(matches_.size());
+  for (const auto& [pid, process] : matches_) {
+    matches.push_back(process);
+  }
+  return matches;
+}
+
+void ProcessMonitor::SetPtraceListener(
+    std::function<void(pid_t tracer)> listener) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ptrace_listener_ = std::move(listener);
+}
+
+std::optional<ProcessInfo> ProcessMonitor::Tracer() {
+  long tracer_pid = 0;
+  if (!ReadSelfStatusField("TracerPid", &tracer_pid) || tracer_pid == 0) {
+    return std::nullopt;
+  }
+
+  ProcessInfo tracer;
+  if (ReadProcessInfo(static_cast<pid_t>(tracer_pid), &tracer)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    MatchSignatureLocked(&tracer);
+  } else {
+    // Detached or exited since the status was read; still report it.
+    tracer.pid = static_cast<pid_t>(tracer_pid);
+  }
+  return tracer;
+}
+
+bool ProcessMonitor::OpenConnector() {
+  connector_fd_ = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                         NETLINK_CONNECTOR);
+  if (connector_fd_ < 0) {
+    return false;
+  }
+  sockaddr_nl address{};
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = CN_IDX_PROC;
+  if (bind(connector_fd_, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) < 0) {
+    CloseFd(&connector_fd_);
+    return false;
+  }
+  // Every exec on the host is reported; give bursts room before ENOBUFS.
+  setsockopt(connector_fd_, SOL_SOCKET, SO_RCVBUF, &kSocketBufferSize,
+             sizeof(kSocketBufferSize));
+
+  if (!SendMulticastOp(connector_fd_, PROC_CN_MCAST_LISTEN) ||
+      !WaitForListenAck(connector_fd_)) {
+    CloseFd(&connector_fd_);
+    return false;
+  }
+  return true;
+}
+
+void ProcessMonitor::CloseConnector() {
+  if (connector_fd_ >= 0) {
+    // The kernel counts listeners and stops generating events at zero.
+    SendMulticastOp(connector_fd_, PROC_CN_MCAST_IGNORE);
+    CloseFd(&connector_fd_);
+  }
+}
+
+void ProcessMonitor::RescanLocked() {
+  std::vector<pid_t> pids;
+  if (DIR* directory = opendir("/proc")) {
+    while (const dirent* entry = readdir(directory)) {
+      if (entry->d_name[0] >= '1' && entry->d_name[0] <= '9') {
+        pids.push_back(static_cast<pid_t>(atoi(entry->d_name)));
+      }
+    }
+    closedir(directory);
+  }
+
+  // Workers only read signatures_, which the held mutex_ keeps stable.
+  std::mutex found_mutex;
+  std::map<pid_t, ProcessInfo> found;
+  const size_t workers = std::min(
+      HardwareWorkers(), 1 + pids.size() / kProcessesPerWorker);
+  ParallelFor(pids.size(), workers, [&](size_t i) {
+    ProcessInfo process;
+    if (ReadProcessInfo(pids[i], &process) && MatchSignatureLocked(&process)) {
+      std::lock_guard<std::mutex> lock(found_mutex);
+      found.emplace(process.pid, std::move(process));
+    }
+    return true;
+  });
+
+  matches_ = std::move(found);
+  stale_ = false;
+  scanned_at_ms_ = NowMillis();
+}
+
+void ProcessMonitor::Run() {
+  epoll_event events[2];
+  while (running_.load()) {
+    const int count = epoll_wait(epoll_fd_, events, 2, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    for (int i = 0; i < count; ++i) {
+      if (events[i].data.fd == wake_fd_) {
+        uint64_t value;
+        while (read(wake_fd_, &value, sizeof(value)) > 0) {
+        }
+      } else {
+        DrainConnector();
+      }
+    }
+  }
+}
+
+void ProcessMonitor::DrainConnector() {
+  alignas(nlmsghdr) char buffer[kReceiveBufferSize];
+  for (;;) {
+    const ssize_t length = recv(connector_fd_, buffer, sizeof(buffer), 0);
+    if (length < 0 && errno == ENOBUFS) {
+      // Events were dropped; the next query rebuilds the table.
+      std::lock_guard<std::mutex> lock(mutex_);
+      stale_ = true;
+      continue;
+    }
+    if (length <= 0) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const pid_t self = getpid();
+    ForEachProcEvent(buffer, length, [this, self](const proc_event& event) {
+      switch (event.what) {
+        case proc_event::PROC_EVENT_EXEC:
+          UpdateLocked(event.event_data.exec.process_tgid);
+          break;
+        case proc_event::PROC_EVENT_COMM:
+          UpdateLocked(event.event_data.comm.process_tgid);
+          break;
+        case proc_event::PROC_EVENT_EXIT:
+          // Threads exit individually; only the leader ends the process.
+          if (event.event_data.exit.process_pid ==
+              event.event_data.exit.process_tgid) {
+            matches_.erase(event.event_data.exit.process_tgid);
+          }
+          break;
+        case proc_event::PROC_EVENT_PTRACE:
+          if (event.event_data.ptrace.process_tgid == self &&
+              ptrace_listener_) {
+            ptrace_listener_(event.event_data.ptrace.tracer_tgid);
+          }
+          break;
+        default:
+          break;
+      }
+    });
+  }
+}
+
+void ProcessMonitor::UpdateLocked(pid_t pid) {
+  if (stale_) {
+    return;
+  }
+  ProcessInfo process;
+  if (ReadProcessInfo(pid, &process) && MatchSignatureLocked(&process)) {
+    matches_[pid] = std::move(process);
+  } else {
+    matches_.erase(pid);
+  }
+}
+
+bool ProcessMonitor::MatchSignatureLocked(ProcessInfo* process) const {
+  const std::string_view name = process->name;
+  const std::string_view exe = Basename(process->exe);
+  for (const std::string& signature : signatures_) {
+    std::string_view pattern = signature;
+    bool matched;
+    if (!pattern.empty() && pattern.back() == '*') {
+      pattern.remove_suffix(1);
+      matched = name.substr(0, pattern.size()) == pattern.substr(0, kCommLength) ||
+                (!exe.empty() && exe.substr(0, pattern.size()) == pattern);
+    } else {
+      // comm is truncated, so a long signature matches its first 15 bytes.
+      matched = (!pattern.empty() && name == pattern.substr(0, kCommLength)) ||
+                (!exe.empty() && exe == pattern);
+    }
+    if (matched) {
+      process->signature = signature;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,104 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_PROCESS_MONITOR_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_PROCESS_MONITOR_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+struct ProcessInfo {
+  pid_t pid = 0;
+  std::string name;       // /proc/<pid>/comm
+  std::string exe;        // /proc/<pid>/exe target, empty if unreadable
+  std::string signature;  // the signature that matched, if any
+};
+
+// Process names of debuggers, tracers and instrumentation frameworks.
+// An entry ending in '*' matches by prefix.
+std::vector<std::string> DefaultProcessSignatures();
+
+// Tracks the running processes whose name or executable matches a
+// signature set.
+//
+// Start() subscribes to the netlink proc connector, then reads
+// /proc/*/comm and /proc/*/exe for every process in parallel; subscribing
+// first means a process exec'd during the scan is not missed. From then
+// on a background thread sleeping in epoll_wait() applies EXEC, COMM and
+// EXIT events, looking at a single process per event, so the table stays
+// current without rescanning /proc and costs nothing while no process
+// starts. Older kernels only accept the subscription with CAP_NET_ADMIN
+// in the initial namespaces; when it is refused, Matches() rescans /proc
+// at most once per second instead. A table that missed events because
+// the socket overflowed is rebuilt on the next query.
+class ProcessMonitor {
+ public:
+  explicit ProcessMonitor(
+      std::vector<std::string> signatures = DefaultProcessSignatures());
+  ~ProcessMonitor();
+
+  ProcessMonitor(const ProcessMonitor&) = delete;
+  ProcessMonitor& operator=(const ProcessMonitor&) = delete;
+
+  // Idempotent; returns whether the table is event-driven.
+  bool Start();
+  void Stop();
+
+  // Replaces the signature set; the next Matches() rescans /proc.
+  void SetSignatures(std::vector<std::string> signatures);
+
+  // Matching processes, ordered by pid.
+  std::vector<ProcessInfo> Matches();
+
+  // The process ptrace-attached to this one, if any, whether or not it
+  // matches a signature.
+  std::optional<ProcessInfo> Tracer();
+
+  // Called from the monitor thread, with the table locked, whenever a
+  // process attaches to or detaches from this one with ptrace; `tracer` is
+  // 0 on detach. Only delivered while the table is event-driven.
+  void SetPtraceListener(std::function<void(pid_t tracer)> listener);
+
+  bool IsEventDriven() const { return connector_fd_ >= 0; }
+
+ private:
+  bool OpenConnector();
+  void CloseConnector();
+  void RescanLocked();
+  void Run();
+  void DrainConnector();
+  void UpdateLocked(pid_t pid);
+  bool MatchSignatureLocked(ProcessInfo* process) const;
+
+  std::mutex start_mutex_;
+  bool started_ = false;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  int epoll_fd_ = -1;
+  int wake_fd_ = -1;
+  int connector_fd_ = -1;
+
+  // Guards everything below; held by the monitor thread per event batch.
+  std::mutex mutex_;
+  std::vector<std::string> signatures_;
+  std::map<pid_t, ProcessInfo> matches_;
+  bool stale_ = true;
+  int64_t scanned_at_ms_ = 0;
+  std::function<void(pid_t)> ptrace_listener_;
+};
+
+// Reads the name and executable of `pid`. Returns false if the process
+// is gone.
+bool ReadProcessInfo(pid_t pid, ProcessInfo* process);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_PROCESS_MONITOR_H_
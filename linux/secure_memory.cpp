@@ -0,0 +1,168 @@
+#include "secure_memory.h"
+
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr size_t kSmallestBlock = 32;
+constexpr size_t kLargestBlock = 4096;
+// 32 KiB a class, 256 KiB in all: 1024 digests or 8 pages of key material.
+constexpr size_t kSlabBytes = 32 * 1024;
+
+size_t RoundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+void ProtectMapping(void* data, size_t length) {
+  madvise(data, length, MADV_DONTDUMP);
+#ifdef MADV_WIPEONFORK
+  // Forked helpers such as the debugger probe see zeros.
+  madvise(data, length, MADV_WIPEONFORK);
+#endif
+}
+
+}  // namespace
+
+void SecureZero(void* data, size_t size) noexcept {
+  // Empty buffers may have no storage at all.
+  if (size > 0) {
+    explicit_bzero(data, size);
+  }
+}
+
+SecureArena& SecureArena::Instance() {
+  static SecureArena* instance = new SecureArena();
+  return *instance;
+}
+
+SecureArena::SecureArena() {
+  page_size_ = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t slab = RoundUp(kSlabBytes, page_size_);
+  slab_stride_ = page_size_ + slab;
+
+  size_t class_count = 0;
+  for (size_t block = kSmallestBlock; block <= kLargestBlock; block *= 2) {
+    ++class_count;
+  }
+  // [guard][slab 0][guard][slab 1]...[slab n-1][guard]
+  length_ = class_count * slab_stride_ + page_size_;
+  void* mapping = mmap(nullptr, length_, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mapping == MAP_FAILED) {
+    // Every allocation falls back to a dedicated mapping.
+    length_ = 0;
+    return;
+  }
+  base_ = static_cast<uint8_t*>(mapping);
+  ProtectMapping(base_, length_);
+
+  bool locked = true;
+  size_t block = kSmallestBlock;
+  for (size_t i = 0; i < class_count; ++i, block *= 2) {
+    SizeClass size_class;
+    size_class.block_size = block;
+    size_class.begin = base_ + page_size_ + i * slab_stride_;
+    // A class that cannot be mapped stays, empty, so slab addresses keep
+    // mapping to class indices.
+    if (mprotect(size_class.begin, slab, PROT_READ | PROT_WRITE) == 0) {
+      locked = mlock(size_class.begin, slab) == 0 && locked;
+      // Thread the free list back to front so blocks go out in address
+      // order.
+      for (size_t offset = slab; offset >= block; offset -= block) {
+        void* free_block = size_class.begin + offset - block;
+        *static_cast<void**>(free_block) = size_class.free_list;
+        size_class.free_list = free_block;
+      }
+      stats_.capacity += slab;
+    }
+    classes_.push_back(size_class);
+  }
+  stats_.locked = locked;
+}
+
+int SecureArena::ClassFor(size_t size) const {
+  for (size_t i = 0; i < classes_.size(); ++i) {
+    if (size <= classes_[i].block_size) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void* SecureArena::Allocate(size_t size) {
+  size = std::max<size_t>(size, 1);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int index = ClassFor(size);
+    if (index >= 0 && classes_[index].free_list != nullptr) {
+      SizeClass& size_class = classes_[index];
+      void* block = size_class.free_list;
+      size_class.free_list = *static_cast<void**>(block);
+      *static_cast<void**>(block) = nullptr;
+      stats_.in_use += size_class.block_size;
+      stats_.peak = std::max(stats_.peak, stats_.in_use);
+      return block;
+    }
+    ++stats_.fallback_allocations;
+  }
+  return AllocateMapping(size);
+}
+
+void SecureArena::Deallocate(void* pointer, size_t size) noexcept {
+  if (pointer == nullptr) {
+    return;
+  }
+  size = std::max<size_t>(size, 1);
+  auto* address = static_cast<uint8_t*>(pointer);
+  if (address < base_ || address >= base_ + length_) {
+    FreeMapping(pointer, size);
+    return;
+  }
+
+  const size_t index =
+      static_cast<size_t>(address - base_ - page_size_) / slab_stride_;
+  std::lock_guard<std::mutex> lock(mutex_);
+  SizeClass& size_class = classes_[index];
+  SecureZero(pointer, size_class.block_size);
+  *static_cast<void**>(pointer) = size_class.free_list;
+  size_class.free_list = pointer;
+  stats_.in_use -= size_class.block_size;
+}
+
+void* SecureArena::AllocateMapping(size_t size) {
+  const size_t data = RoundUp(size, page_size_);
+  const size_t length = data + 2 * page_size_;
+  void* mapping = mmap(nullptr, length, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mapping == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  uint8_t* begin = static_cast<uint8_t*>(mapping) + page_size_;
+  if (mprotect(begin, data, PROT_READ | PROT_WRITE) != 0) {
+    munmap(mapping, length);
+    throw std::bad_alloc();
+  }
+  ProtectMapping(mapping, length);
+  mlock(begin, data);
+  return begin;
+}
+
+void SecureArena::FreeMapping(void* pointer, size_t size) noexcept {
+  const size_t data = RoundUp(size, page_size_);
+  SecureZero(pointer, data);
+  munlock(pointer, data);
+  munmap(static_cast<uint8_t*>(pointer) - page_size_, data + 2 * page_size_);
+}
+
+SecureArenaStats SecureArena::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stats_;
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,122 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURE_MEMORY_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURE_MEMORY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+struct SecureArenaStats {
+  size_t capacity = 0;  // bytes in preallocated slabs
+  size_t in_use = 0;    // bytes handed out, rounded up to block sizes
+  size_t peak = 0;
+  uint64_t fallback_allocations = 0;  // served by a dedicated mapping
+  bool locked = false;  // slabs are mlock()ed; false if RLIMIT_MEMLOCK said no
+};
+
+// Process-wide allocator for pins, keys and fingerprints.
+//
+// One mapping is reserved when the arena is first used and split into a
+// slab per power-of-two size class, 32 bytes to 4 KiB, each with an
+// inaccessible guard page on either side, so an overrun past the end of a
+// slab faults instead of running into another slab or the heap. Blocks
+// within a slab are adjacent with no guard between them: an overrun of
+// one block can read or clobber the next secret of its class. Only the
+// dedicated mappings below isolate a single allocation. The slabs are
+// mlock()ed so they never reach swap, excluded from core dumps and, where
+// the kernel supports it, wiped in forked children. Blocks are zeroed when
+// freed.
+//
+// Allocation pops a per-class free list under a mutex: no system call
+// after startup. Requests larger than 4 KiB, or made while their class is
+// exhausted, get a dedicated guarded and locked mapping instead.
+class SecureArena {
+ public:
+  // Preallocates the slabs on first call; the plugin calls it at
+  // registration.
+  static SecureArena& Instance();
+
+  SecureArena(const SecureArena&) = delete;
+  SecureArena& operator=(const SecureArena&) = delete;
+
+  // Throws std::bad_alloc.
+  void* Allocate(size_t size);
+  // `size` must be the size passed to Allocate().
+  void Deallocate(void* pointer, size_t size) noexcept;
+
+  SecureArenaStats GetStats() const;
+
+ private:
+  struct SizeClass {
+    size_t block_size = 0;
+    uint8_t* begin = nullptr;
+    void* free_list = nullptr;
+  };
+
+  SecureArena();
+
+  int ClassFor(size_t size) const;
+  void* AllocateMapping(size_t size);
+  void FreeMapping(void* pointer, size_t size) noexcept;
+
+  uint8_t* base_ = nullptr;
+  size_t length_ = 0;
+  size_t page_size_ = 0;
+  size_t slab_stride_ = 0;  // guard page plus slab
+
+  mutable std::mutex mutex_;
+  std::vector<SizeClass> classes_;
+  SecureArenaStats stats_;
+};
+
+// std::allocator replacement drawing from SecureArena::Instance().
+template <typename T>
+class SecureAllocator {
+ public:
+  using value_type = T;
+
+  SecureAllocator() noexcept = default;
+  template <typename U>
+  SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+  T* allocate(size_t count) {
+    if (count > std::numeric_limits<size_t>::max() / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(
+        SecureArena::Instance().Allocate(count * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, size_t count) noexcept {
+    SecureArena::Instance().Deallocate(pointer, count * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const SecureAllocator<U>&) const noexcept {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const SecureAllocator<U>&) const noexcept {
+    return false;
+  }
+};
+
+// Strings of up to 15 characters live inside the object (the small-string
+// buffer) and are not covered; digests and hex fingerprints are longer.
+using SecureString =
+    std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+
+template <typename T>
+using SecureVector = std::vector<T, SecureAllocator<T>>;
+
+// Zeroes `size` bytes in a way the compiler cannot drop as a dead store.
+void SecureZero(void* data, size_t size) noexcept;
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURE_MEMORY_H_
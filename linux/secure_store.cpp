@@ -0,0 +1,642 @@
+#include "secure_store.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <openssl/rand.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "data_key.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr char kMagic[8] = {'U', 'S', 'F', 'K', 'L', 'O', 'G', '1'};
+constexpr uint8_t kVersion = 2;
+constexpr size_t kSaltOffset = 16;
+constexpr size_t kKeyCheckOffset = 32;
+constexpr size_t kHeaderSize = 64;
+static_assert(kSaltOffset + RecordCipher::kSaltSize == kKeyCheckOffset);
+static_assert(kKeyCheckOffset + RecordCipher::kOverhead <= kHeaderSize);
+
+constexpr uint8_t kOpPut = 1;
+constexpr uint8_t kOpDelete = 2;
+// op | sequence | expiry | key size
+constexpr size_t kPlaintextPrefix = 1 + 8 + 8 + 4;
+constexpr size_t kSizePrefix = 4;
+constexpr size_t kMaxRecordSize = 64 << 20;
+
+// The read-only mapping grows in steps of this much.
+constexpr size_t kMappingStep = 1 << 20;
+// Compaction copies through a buffer of about this size.
+constexpr size_t kCopyBufferSize = 1 << 20;
+
+void PutUint32(uint8_t* out, uint32_t value) {
+  for (int i = 0; i < 4; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint32_t GetUint32(const uint8_t* data) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; ++i) {
+    value |= static_cast<uint32_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+void PutUint64(uint8_t* out, uint64_t value) {
+  for (int i = 0; i < 8; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint64_t GetUint64(const uint8_t* data) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; ++i) {
+    value |= static_cast<uint64_t>(data[i]) << (8 * i);
+  }
+  return value;
+}
+
+int64_t NowMillis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+bool WriteAll(int fd, const uint8_t* data, size_t size, uint64_t offset) {
+  while (size > 0) {
+    const ssize_t written = pwrite(fd, data, size, static_cast<off_t>(offset));
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+    offset += static_cast<uint64_t>(written);
+  }
+  return true;
+}
+
+bool ReadAll(int fd, uint8_t* data, size_t size, uint64_t offset) {
+  while (size > 0) {
+    const ssize_t count = pread(fd, data, size, static_cast<off_t>(offset));
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      return false;
+    }
+    data += count;
+    size -= static_cast<size_t>(count);
+    offset += static_cast<uint64_t>(count);
+  }
+  return true;
+}
+
+// Opens `path` for reading and writing and takes an exclusive lock on it,
+// so two processes never append to one log. -1 on failure.
+int OpenLocked(const std::string& path, int flags) {
+  const int fd =
+      open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW | flags,
+           0600);
+  if (fd < 0) {
+    return -1;
+  }
+  if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+void SyncDirectory(const std::string& path) {
+  const size_t slash = path.rfind('/');
+  const std::string directory =
+      slash == std::string::npos ? "." : path.substr(0, std::max<size_t>(
+                                                           slash, 1));
+  const int fd = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd >= 0) {
+    fsync(fd);
+    close(fd);
+  }
+}
+
+bool Expired(int64_t expires_at_ms, int64_t now_ms) {
+  return expires_at_ms != 0 && now_ms >= expires_at_ms;
+}
+
+}  // namespace
+
+SecureStore::SecureStore(KeySource root_key, SecureStoreOptions options)
+    : root_key_(root_key), options_(std::move(options)) {}
+
+SecureStore::~SecureStore() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  if (fd_ >= 0) {
+    fdatasync(fd_);
+    munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+    close(fd_);
+  }
+}
+
+void SecureStore::EnsureOpen() {
+  if (fd_ >= 0) {
+    return;
+  }
+  std::string path = options_.path;
+  if (path.empty()) {
+    const std::string directory = PluginDataDirectory();
+    if (directory.empty()) {
+      throw std::runtime_error("no data directory for the secure store");
+    }
+    path = directory + "/secure_store.log";
+  }
+  OpenLog(path);
+  if (!thread_.joinable()) {
+    thread_ = std::thread(&SecureStore::Run, this);
+  }
+}
+
+void SecureStore::OpenLog(const std::string& path) {
+  const int fd = OpenLocked(path, 0);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open " + path +
+                             " (in use by another process?)");
+  }
+  struct stat status;
+  if (fstat(fd, &status) != 0) {
+    close(fd);
+    throw std::runtime_error("cannot stat " + path);
+  }
+  fd_ = fd;
+  path_ = path;
+
+  const uint64_t size = static_cast<uint64_t>(status.st_size);
+  try {
+    if (size < kHeaderSize) {
+      WriteHeader();
+    } else {
+      if (!ReadAll(fd_, header_, kHeaderSize, 0) ||
+          memcmp(header_, kMagic, sizeof(kMagic)) != 0 ||
+          header_[8] != kVersion) {
+        throw std::runtime_error(path + " is not a secure store log");
+      }
+      cipher_ = std::make_unique<RecordCipher>(
+          root_key_(), header_ + kSaltOffset,
+          static_cast<AeadAlgorithm>(header_[9]));
+      // Without this, every record would look like a torn tail and the
+      // whole log would be cut off.
+      if (!cipher_->Open(header_ + kKeyCheckOffset, RecordCipher::kOverhead,
+                         header_, kKeyCheckOffset, nullptr)) {
+        throw std::runtime_error(path +
+                                 " was written under a different key");
+      }
+      end_ = size;
+    }
+    MapLog();
+  } catch (...) {
+    close(fd_);
+    fd_ = -1;
+    throw;
+  }
+
+  // Only what one interrupted append can leave behind is a torn tail: part
+  // of a size prefix, fewer bytes than the prefix declares, or a complete
+  // last record that does not authenticate. Anything else, in particular a
+  // damaged size prefix with more of the log after it, is corruption, and
+  // cutting it off would drop every later write.
+  uint64_t offset = kHeaderSize;
+  bool corrupt = false;
+  while (offset + kSizePrefix <= end_) {
+    const uint64_t remaining = end_ - offset;
+    const uint64_t sealed = GetUint32(mapping_ + offset);
+    if (kSizePrefix + sealed > remaining) {
+      corrupt = sealed > kMaxRecordSize ||
+                remaining > kSizePrefix + kMaxRecordSize;
+      break;
+    }
+    if (!ApplyRecord(mapping_ + offset,
+                     static_cast<uint32_t>(kSizePrefix + sealed), offset,
+                     &index_, &garbage_, &sequence_)) {
+      corrupt = kSizePrefix + sealed != remaining;
+      break;
+    }
+    offset += kSizePrefix + sealed;
+  }
+  if (corrupt) {
+    munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+    mapping_ = nullptr;
+    mapping_size_ = 0;
+    close(fd_);
+    fd_ = -1;
+    cipher_.reset();
+    index_.clear();
+    garbage_ = 0;
+    sequence_ = 0;
+    end_ = 0;
+    throw std::runtime_error(path + " has a corrupt record at offset " +
+                             std::to_string(offset));
+  }
+  if (offset < end_) {
+    stats_.truncated_bytes += end_ - offset;
+    if (ftruncate(fd_, static_cast<off_t>(offset)) == 0) {
+      fdatasync(fd_);
+    }
+    end_ = offset;
+  }
+}
+
+void SecureStore::WriteHeader() {
+  uint8_t header[kHeaderSize] = {};
+  memcpy(header, kMagic, sizeof(kMagic));
+  header[8] = kVersion;
+  header[9] = static_cast<uint8_t>(PreferredAeadAlgorithm());
+  if (RAND_bytes(header + kSaltOffset,
+                 static_cast<int>(RecordCipher::kSaltSize)) != 1) {
+    throw std::runtime_error("random number generator failed");
+  }
+  auto cipher = std::make_unique<RecordCipher>(
+      root_key_(), header + kSaltOffset, static_cast<AeadAlgorithm>(header[9]));
+  cipher->Seal(nullptr, 0, header, kKeyCheckOffset, header + kKeyCheckOffset);
+  if (ftruncate(fd_, 0) != 0 || !WriteAll(fd_, header, kHeaderSize, 0) ||
+      fdatasync(fd_) != 0) {
+    throw std::runtime_error("cannot write " + path_);
+  }
+  SyncDirectory(path_);
+  memcpy(header_, header, kHeaderSize);
+  cipher_ = std::move(cipher);
+  end_ = kHeaderSize;
+}
+
+void SecureStore::MapLog() {
+  const size_t size = (end_ + kMappingStep - 1) / kMappingStep * kMappingStep;
+  if (mapping_ != nullptr && size <= mapping_size_) {
+    return;
+  }
+  // The mapping runs past the end of the file; only bytes below end_ are
+  // ever read.
+  void* mapping =
+      mapping_ == nullptr
+          ? mmap(nullptr, size, PROT_READ, MAP_SHARED, fd_, 0)
+          : mremap(const_cast<uint8_t*>(mapping_), mapping_size_, size,
+                   MREMAP_MAYMOVE);
+  if (mapping == MAP_FAILED) {
+    throw std::runtime_error("cannot map " + path_);
+  }
+  mapping_ = static_cast<const uint8_t*>(mapping);
+  mapping_size_ = size;
+}
+
+bool SecureStore::ApplyRecord(const uint8_t* data, uint32_t size,
+                              uint64_t offset, Index* index,
+                              uint64_t* garbage, uint64_t* sequence) {
+  const size_t sealed = size - kSizePrefix;
+  if (sealed < RecordCipher::kOverhead + kPlaintextPrefix) {
+    return false;
+  }
+  SecureVector<uint8_t> plaintext(sealed - RecordCipher::kOverhead);
+  if (!cipher_->Open(data + kSizePrefix, sealed, data, kSizePrefix,
+                     plaintext.data())) {
+    return false;
+  }
+  const uint8_t op = plaintext[0];
+  // A record sealed earlier and appended again, to roll a key back or bring
+  // a deleted one back, goes backwards.
+  const uint64_t record_sequence = GetUint64(plaintext.data() + 1);
+  const uint32_t key_size = GetUint32(plaintext.data() + 17);
+  if (record_sequence <= *sequence ||
+      key_size > plaintext.size() - kPlaintextPrefix) {
+    return false;
+  }
+  std::string key(
+      reinterpret_cast<const char*>(plaintext.data() + kPlaintextPrefix),
+      key_size);
+
+  auto it = index->find(key);
+  if (it != index->end()) {
+    *garbage += it->second.size;
+  }
+  const int64_t expires_at_ms =
+      static_cast<int64_t>(GetUint64(plaintext.data() + 9));
+  if (op == kOpPut && !Expired(expires_at_ms, NowMillis())) {
+    Entry entry{offset, size, expires_at_ms};
+    if (it != index->end()) {
+      it->second = entry;
+    } else {
+      index->emplace(std::move(key), entry);
+    }
+  } else if (op == kOpPut || op == kOpDelete) {
+    if (it != index->end()) {
+      index->erase(it);
+    }
+    *garbage += size;
+  } else {
+    return false;
+  }
+  *sequence = record_sequence;
+  return true;
+}
+
+void SecureStore::Append(uint8_t op, std::string_view key,
+                         std::string_view value, int64_t expires_at_ms) {
+  const size_t plaintext_size = kPlaintextPrefix + key.size() + value.size();
+  const size_t sealed = plaintext_size + RecordCipher::kOverhead;
+  if (sealed > kMaxRecordSize) {
+    throw std::runtime_error("secure store record too large");
+  }
+  SecureVector<uint8_t> plaintext(plaintext_size);
+  plaintext[0] = op;
+  PutUint64(plaintext.data() + 1, sequence_ + 1);
+  PutUint64(plaintext.data() + 9, static_cast<uint64_t>(expires_at_ms));
+  PutUint32(plaintext.data() + 17, static_cast<uint32_t>(key.size()));
+  memcpy(plaintext.data() + kPlaintextPrefix, key.data(), key.size());
+  if (!value.empty()) {
+    // Deletes pass a default string_view, whose data() is null.
+    memcpy(plaintext.data() + kPlaintextPrefix + key.size(), value.data(),
+           value.size());
+  }
+
+  std::vector<uint8_t> record(kSizePrefix + sealed);
+  PutUint32(record.data(), static_cast<uint32_t>(sealed));
+  cipher_->Seal(plaintext.data(), plaintext.size(), record.data(),
+                kSizePrefix, record.data() + kSizePrefix);
+  // A short write leaves a tail that the next append overwrites, or that
+  // fails authentication and is cut off when the log is next opened.
+  if (!WriteAll(fd_, record.data(), record.size(), end_)) {
+    throw std::runtime_error("cannot write " + path_);
+  }
+
+  const Entry entry{end_, static_cast<uint32_t>(record.size()),
+                    expires_at_ms};
+  end_ += record.size();
+  ++sequence_;
+  MapLog();
+
+  std::string owned_key(key);
+  auto it = index_.find(owned_key);
+  if (it != index_.end()) {
+    garbage_ += it->second.size;
+  }
+  if (op == kOpPut) {
+    index_.insert_or_assign(std::move(owned_key), entry);
+  } else {
+    if (it != index_.end()) {
+      index_.erase(it);
+    }
+    garbage_ += entry.size;
+  }
+  MarkDirty();
+}
+
+void SecureStore::MarkDirty() {
+  if (!dirty_) {
+    dirty_ = true;
+    first_dirty_ = std::chrono::steady_clock::now();
+    wake_.notify_one();
+  } else if (NeedsCompaction()) {
+    wake_.notify_one();
+  }
+}
+
+void SecureStore::Put(std::string_view key, std::string_view value,
+                      int64_t expires_at_ms) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EnsureOpen();
+  Append(kOpPut, key, value, expires_at_ms);
+}
+
+bool SecureStore::Get(std::string_view key, SecureString* value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EnsureOpen();
+  auto it = index_.find(std::string(key));
+  if (it == index_.end()) {
+    return false;
+  }
+  const Entry entry = it->second;
+  if (Expired(entry.expires_at_ms, NowMillis())) {
+    // Dropped from the index only; compaction drops the record.
+    garbage_ += entry.size;
+    index_.erase(it);
+    return false;
+  }
+
+  const uint8_t* data = mapping_ + entry.offset;
+  const size_t sealed = entry.size - kSizePrefix;
+  SecureVector<uint8_t> plaintext(sealed - RecordCipher::kOverhead);
+  if (!cipher_->Open(data + kSizePrefix, sealed, data, kSizePrefix,
+                     plaintext.data())) {
+    throw std::runtime_error("secure store record failed authentication");
+  }
+  const size_t value_offset = kPlaintextPrefix + key.size();
+  value->assign(reinterpret_cast<const char*>(plaintext.data()) + value_offset,
+                plaintext.size() - value_offset);
+  return true;
+}
+
+bool SecureStore::Delete(std::string_view key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EnsureOpen();
+  if (index_.find(std::string(key)) == index_.end()) {
+    return false;
+  }
+  Append(kOpDelete, key, std::string_view(), 0);
+  return true;
+}
+
+void SecureStore::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  EnsureOpen();
+  ++generation_;
+  index_.clear();
+  garbage_ = 0;
+  dirty_ = false;
+  // A new salt, so records surviving on disk are under a key that no
+  // longer exists anywhere.
+  WriteHeader();
+}
+
+void SecureStore::Sync() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ >= 0 && dirty_) {
+    if (fdatasync(fd_) != 0) {
+      throw std::runtime_error("cannot sync " + path_);
+    }
+    dirty_ = false;
+  }
+}
+
+SecureStoreStats SecureStore::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  SecureStoreStats stats = stats_;
+  stats.open = fd_ >= 0;
+  stats.records = index_.size();
+  stats.log_bytes = end_;
+  stats.garbage_bytes = garbage_;
+  return stats;
+}
+
+bool SecureStore::NeedsCompaction() const {
+  if (fd_ < 0 || garbage_ < options_.compaction_threshold ||
+      garbage_ < compaction_floor_) {
+    return false;
+  }
+  return garbage_ > end_ - kHeaderSize - garbage_;
+}
+
+void SecureStore::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    wake_.wait(lock,
+               [this] { return stopping_ || dirty_ || NeedsCompaction(); });
+    if (stopping_) {
+      return;
+    }
+    if (dirty_) {
+      // Let the commit interval's writes gather, then sync them at once.
+      // The destructor syncs whatever is left when stopping.
+      if (wake_.wait_until(lock, first_dirty_ + options_.commit_interval,
+                           [this] { return stopping_; })) {
+        return;
+      }
+      if (dirty_) {
+        dirty_ = false;
+        // Only this thread replaces fd_, so it stays valid unlocked.
+        const int fd = fd_;
+        lock.unlock();
+        fdatasync(fd);
+        lock.lock();
+        ++stats_.commits;
+      }
+    }
+    if (NeedsCompaction()) {
+      Compact(lock);
+    }
+  }
+}
+
+void SecureStore::Compact(std::unique_lock<std::mutex>& lock) {
+  const uint64_t generation = generation_;
+  const uint64_t copied_end = end_;
+  const int old_fd = fd_;
+  const std::string path = path_;
+  uint8_t header[kHeaderSize];
+  memcpy(header, header_, kHeaderSize);
+  const int64_t now_ms = NowMillis();
+  std::vector<std::pair<std::string, Entry>> live;
+  live.reserve(index_.size());
+  for (const auto& [key, entry] : index_) {
+    if (!Expired(entry.expires_at_ms, now_ms)) {
+      live.emplace_back(key, entry);
+    }
+  }
+  lock.unlock();
+
+  // The new log keeps the salt, so sealed records are copied as they are.
+  const std::string temporary = path + ".compact";
+  const int fd = OpenLocked(temporary, O_TRUNC);
+  bool copied = fd >= 0 && WriteAll(fd, header, kHeaderSize, 0);
+  std::sort(live.begin(), live.end(), [](const auto& a, const auto& b) {
+    return a.second.offset < b.second.offset;
+  });
+  Index index;
+  index.reserve(live.size());
+  uint64_t end = kHeaderSize;
+  std::vector<uint8_t> buffer;
+  buffer.reserve(kCopyBufferSize);
+  for (size_t i = 0; copied && i < live.size(); ++i) {
+    Entry entry = live[i].second;
+    const size_t start = buffer.size();
+    buffer.resize(start + entry.size);
+    copied = ReadAll(old_fd, buffer.data() + start, entry.size, entry.offset);
+    entry.offset = end + start;
+    index.emplace(std::move(live[i].first), entry);
+    if (copied && (buffer.size() >= kCopyBufferSize || i + 1 == live.size())) {
+      copied = WriteAll(fd, buffer.data(), buffer.size(), end);
+      end += buffer.size();
+      buffer.clear();
+    }
+  }
+  copied = copied && fdatasync(fd) == 0;
+
+  lock.lock();
+  if (copied && generation == generation_ && !stopping_) {
+    // Bring over what was appended meanwhile and replay it onto the new
+    // index, then drop keys that expired out of index_ meanwhile.
+    // Copied records keep their order, so the tail's sequence numbers
+    // still run on from them.
+    uint64_t garbage = 0;
+    uint64_t sequence = 0;
+    const uint64_t tail = end_ - copied_end;
+    copied = WriteAll(fd, mapping_ + copied_end, tail, end);
+    for (uint64_t offset = copied_end; copied && offset < end_;) {
+      const uint32_t size =
+          static_cast<uint32_t>(kSizePrefix + GetUint32(mapping_ + offset));
+      ApplyRecord(mapping_ + offset, size, end + (offset - copied_end),
+                  &index, &garbage, &sequence);
+      offset += size;
+    }
+    for (auto it = index.begin(); copied && it != index.end();) {
+      if (index_.find(it->first) == index_.end()) {
+        garbage += it->second.size;
+        it = index.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    const uint64_t new_end = end + tail;
+    const size_t mapping_size =
+        (new_end + kMappingStep - 1) / kMappingStep * kMappingStep;
+    void* mapping = MAP_FAILED;
+    if (copied && fdatasync(fd) == 0) {
+      mapping = mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    if (mapping != MAP_FAILED &&
+        rename(temporary.c_str(), path.c_str()) != 0) {
+      munmap(mapping, mapping_size);
+      mapping = MAP_FAILED;
+    }
+    if (mapping != MAP_FAILED) {
+      SyncDirectory(path);
+      munmap(const_cast<uint8_t*>(mapping_), mapping_size_);
+      close(fd_);
+      fd_ = fd;
+      mapping_ = static_cast<const uint8_t*>(mapping);
+      mapping_size_ = mapping_size;
+      end_ = new_end;
+      index_ = std::move(index);
+      garbage_ = garbage;
+      dirty_ = false;
+      compaction_floor_ = 0;
+      ++stats_.compactions;
+      return;
+    }
+  }
+
+  if (fd >= 0) {
+    close(fd);
+    unlink(temporary.c_str());
+  }
+  // Wait for twice the garbage before trying again, so a full disk does
+  // not turn into a compaction loop.
+  compaction_floor_ = garbage_ * 2;
+}
+
+}  // namespace ultra_secure_flutter_kit
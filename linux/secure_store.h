@@ -0,0 +1,169 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURE_STORE_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURE_STORE_H_
+
+// Persistent encrypted key-value store behind secureStore, secureRetrieve,
+// secureDelete and clearAllSecureData.
+//
+// The store is one append-only log:
+//
+//   header:  magic "USFKLOG1" (8) | version (1) | algorithm (1) |
+//            reserved (6) | salt (16) | key check (28) | reserved (4)
+//   records: sealed size (4, little-endian) | RecordCipher record
+//
+// A record's plaintext is op (1) | sequence (8) | expiry, ms since the
+// epoch or 0 (8) | key size (4) | key | value, so key names are encrypted
+// too. The sealed size is the associated data. A put supersedes earlier
+// records for its key; a delete is a record without a value. Sequence
+// numbers rise strictly through the log, and a record that goes backwards
+// is rejected, so an old record copied to the end cannot roll a key back
+// or bring a deleted one back. Compaction copies records unchanged and in
+// order. The key check is an empty
+// record sealed over the first 32 header bytes, so a log opened under the
+// wrong key is refused rather than read as garbage.
+//
+// The log is opened, and the index rebuilt by decrypting every record, on
+// the first call. A last record that is incomplete or does not
+// authenticate is the torn tail of a write cut short by a crash, and is
+// cut off; so is a size prefix running past the end of the log, as long
+// as what follows it is shorter than the largest record. Anything else
+// that does not parse or authenticate is corruption: the log is refused
+// rather than truncated, so later writes are kept.
+// Lookups go through a hash map from key to record offset and read the
+// record from a read-only mapping of the log.
+//
+// Writes are appended with pwrite() and acknowledged once the kernel has
+// them, so they survive the app crashing. A background thread makes them
+// durable with one fdatasync() per commit interval, however many writes
+// arrived in it; a power loss can lose at most that interval. The same
+// thread compacts the log, copying live records to a new file and renaming
+// it into place, once superseded records outweigh live ones.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "aead_cipher.h"
+#include "secure_memory.h"
+
+namespace ultra_secure_flutter_kit {
+
+struct SecureStoreOptions {
+  // Empty means PluginDataDirectory()/secure_store.log.
+  std::string path;
+  // Longest an acknowledged write waits for fdatasync().
+  std::chrono::milliseconds commit_interval{20};
+  // Superseded bytes that must pile up before a compaction is considered.
+  size_t compaction_threshold = 1 << 20;
+};
+
+struct SecureStoreStats {
+  bool open = false;
+  uint64_t records = 0;      // live keys
+  uint64_t log_bytes = 0;
+  uint64_t garbage_bytes = 0;  // superseded, deleted or expired records
+  uint64_t commits = 0;        // fdatasync() calls by the commit thread
+  uint64_t compactions = 0;
+  uint64_t truncated_bytes = 0;  // torn tail cut off when opening
+};
+
+class SecureStore {
+ public:
+  // Where the store gets its root key; called when the log is opened.
+  using KeySource = const SecureVector<uint8_t>& (*)();
+
+  explicit SecureStore(KeySource root_key,
+                       SecureStoreOptions options = SecureStoreOptions());
+  // Stops the background thread and syncs outstanding writes.
+  ~SecureStore();
+
+  SecureStore(const SecureStore&) = delete;
+  SecureStore& operator=(const SecureStore&) = delete;
+
+  // All of these open the log on first use and throw std::runtime_error
+  // when it cannot be opened, read or written; a log in use by another
+  // process cannot be opened.
+  //
+  // `expires_at_ms` is milliseconds since the epoch, 0 for never.
+  void Put(std::string_view key, std::string_view value,
+           int64_t expires_at_ms = 0);
+  // False if the key is absent or expired.
+  bool Get(std::string_view key, SecureString* value);
+  // False if the key was absent.
+  bool Delete(std::string_view key);
+  // Drops every record and starts a new log under a fresh salt.
+  void Clear();
+  // Makes every acknowledged write durable now.
+  void Sync();
+
+  SecureStoreStats GetStats() const;
+
+ private:
+  struct Entry {
+    uint64_t offset = 0;  // of the size prefix
+    uint32_t size = 0;    // including the size prefix
+    int64_t expires_at_ms = 0;
+  };
+  using Index = std::unordered_map<std::string, Entry>;
+
+  // Everything below requires mutex_ to be held.
+  void EnsureOpen();
+  void OpenLog(const std::string& path);
+  void WriteHeader();
+  void MapLog();
+  // Decrypts the record at `data` and applies it to `index`, adding what
+  // it supersedes to `garbage` and advancing `sequence` to its sequence
+  // number. `offset` is where the record sits in the log that `index`
+  // describes. False if it does not authenticate or its sequence number is
+  // not above `sequence`.
+  bool ApplyRecord(const uint8_t* data, uint32_t size, uint64_t offset,
+                   Index* index, uint64_t* garbage, uint64_t* sequence);
+  void Append(uint8_t op, std::string_view key, std::string_view value,
+              int64_t expires_at_ms);
+  void MarkDirty();
+
+  void Run();
+  // Called on the background thread with `lock` held; drops it while
+  // copying.
+  void Compact(std::unique_lock<std::mutex>& lock);
+  bool NeedsCompaction() const;
+
+  const KeySource root_key_;
+  const SecureStoreOptions options_;
+
+  mutable std::mutex mutex_;
+  std::string path_;
+  int fd_ = -1;
+  uint8_t header_[64] = {};
+  std::unique_ptr<RecordCipher> cipher_;
+  const uint8_t* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  uint64_t end_ = 0;
+  Index index_;
+  uint64_t garbage_ = 0;
+  // Sequence number of the last record in the log.
+  uint64_t sequence_ = 0;
+  // Bumped by Clear() so a compaction running across it is dropped.
+  uint64_t generation_ = 0;
+  // Garbage needed before retrying a compaction that failed.
+  uint64_t compaction_floor_ = 0;
+  SecureStoreStats stats_;
+
+  // Commit thread state, also under mutex_.
+  std::thread thread_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  bool dirty_ = false;
+  std::chrono::steady_clock::time_point first_dirty_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURE_STORE_H_
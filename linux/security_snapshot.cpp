@@ -0,0 +1,109 @@
+#include "security_snapshot.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include "parallel_for.h"
+#include "work_pool.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+int64_t ElapsedMicros(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+void RunOne(const SecurityCheck& check, SecurityCheckResult* result) {
+  const auto start = std::chrono::steady_clock::now();
+  result->name = check.name;
+  try {
+    result->value = check.run ? check.run() : false;
+  } catch (const std::exception&) {
+    result->value = false;
+    result->failed = true;
+  }
+  result->duration_us = ElapsedMicros(start);
+}
+
+// Most checks block on the filesystem rather than the CPU, so allow more
+// workers than cores, the calling thread being one of them. Started once
+// rather than per snapshot, which runs every few seconds.
+size_t SnapshotHelpers() { return HardwareWorkers() * 2 - 1; }
+
+WorkPool& SnapshotPool() {
+  static WorkPool* pool =
+      new WorkPool(SnapshotHelpers(), SnapshotHelpers() * 4);
+  return *pool;
+}
+
+// Shared with the pool tasks, which may start after the snapshot has
+// returned; `checks` and `snapshot` are only touched for a claimed index,
+// and the caller waits for every claimed check to finish.
+struct SnapshotWork {
+  const SecurityCheck* checks = nullptr;
+  SecurityCheckResult* results = nullptr;
+  size_t count = 0;
+  std::atomic<size_t> next{0};
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t done = 0;  // under mutex
+
+  void RunAvailable() {
+    for (;;) {
+      const size_t i = next.fetch_add(1);
+      if (i >= count) {
+        return;
+      }
+      RunOne(checks[i], &results[i]);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (++done == count) {
+        finished.notify_all();
+      }
+    }
+  }
+};
+
+}  // namespace
+
+SecuritySnapshot RunSecuritySnapshot(const std::vector<SecurityCheck>& checks) {
+  SecuritySnapshot snapshot;
+  snapshot.results.resize(checks.size());
+  snapshot.timestamp_ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+
+  const auto start = std::chrono::steady_clock::now();
+
+  auto work = std::make_shared<SnapshotWork>();
+  work->checks = checks.data();
+  work->results = snapshot.results.data();
+  work->count = checks.size();
+  // Helpers beyond the caller itself; a full pool leaves more to the
+  // caller.
+  const size_t helpers =
+      std::min(checks.size() > 0 ? checks.size() - 1 : 0, SnapshotHelpers());
+  for (size_t i = 0; i < helpers; ++i) {
+    if (!SnapshotPool().Submit([work] { work->RunAvailable(); })) {
+      break;
+    }
+  }
+  work->RunAvailable();
+  {
+    std::unique_lock<std::mutex> lock(work->mutex);
+    work->finished.wait(lock, [&] { return work->done == work->count; });
+  }
+
+  snapshot.duration_us = ElapsedMicros(start);
+  return snapshot;
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,40 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURITY_SNAPSHOT_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURITY_SNAPSHOT_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+// A single boolean security check that can be run as part of a snapshot.
+// `name` is the method-channel name of the equivalent standalone call
+// (e.g. "isRooted") so Dart can read the snapshot with the same keys.
+struct SecurityCheck {
+  std::string name;
+  std::function<bool()> run;
+};
+
+struct SecurityCheckResult {
+  std::string name;
+  bool value = false;
+  // True when the check threw; `value` is then reported as false.
+  bool failed = false;
+  int64_t duration_us = 0;
+};
+
+struct SecuritySnapshot {
+  std::vector<SecurityCheckResult> results;
+  int64_t timestamp_ms = 0;
+  int64_t duration_us = 0;
+};
+
+// Runs every check concurrently on a process-wide pool of worker threads,
+// the calling thread included, and returns once all of them have
+// finished. Results keep the order of `checks`.
+SecuritySnapshot RunSecuritySnapshot(const std::vector<SecurityCheck>& checks);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_SECURITY_SNAPSHOT_H_
@@ -0,0 +1,65 @@
+#include "snapshot_record.h"
+
+#include <stdexcept>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+// Looks a field up by name at compile time, so the encoder cannot drift
+// from the table the Dart view is generated from.
+constexpr const RecordField& Field(std::string_view name) {
+  for (const auto& field : kSnapshotRecordFields) {
+    if (field.name == name) {
+      return field;
+    }
+  }
+  throw std::logic_error("unknown snapshot record field");
+}
+
+void Put(uint8_t* record, const RecordField& field, uint64_t value) {
+  const size_t width = record_internal::FieldWidth(field.type);
+  for (size_t i = 0; i < width; ++i) {
+    record[field.offset + i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+constexpr const RecordField& kMagic = Field("magic");
+constexpr const RecordField& kVersion = Field("version");
+constexpr const RecordField& kSize = Field("size");
+constexpr const RecordField& kCheckBits = Field("checkBits");
+constexpr const RecordField& kPresentBits = Field("presentBits");
+constexpr const RecordField& kFailedBits = Field("failedBits");
+constexpr const RecordField& kTimestamp = Field("timestamp");
+constexpr const RecordField& kDuration = Field("durationMicros");
+constexpr const RecordField& kQueueDepth = Field("queueDepth");
+constexpr const RecordField& kUsbDeviceCount = Field("usbDeviceCount");
+constexpr const RecordField& kPlatform = Field("platform");
+constexpr const RecordField& kUsbConnectionType = Field("usbConnectionType");
+constexpr const RecordField& kPowerSource = Field("powerSource");
+constexpr const RecordField& kUsbFlags = Field("usbFlags");
+
+}  // namespace
+
+std::vector<uint8_t> EncodeSnapshotRecord(const SnapshotRecord& record) {
+  std::vector<uint8_t> bytes(kSnapshotRecordSize, 0);
+  uint8_t* out = bytes.data();
+  Put(out, kMagic, kSnapshotRecordMagic);
+  Put(out, kVersion, kSnapshotRecordVersion);
+  Put(out, kSize, kSnapshotRecordSize);
+  Put(out, kCheckBits, record.checks);
+  Put(out, kPresentBits, record.present);
+  Put(out, kFailedBits, record.failed);
+  Put(out, kTimestamp, static_cast<uint64_t>(record.timestamp_ms));
+  Put(out, kDuration, static_cast<uint64_t>(record.duration_us));
+  Put(out, kQueueDepth, record.queue_depth);
+  Put(out, kUsbDeviceCount, record.usb_device_count);
+  Put(out, kPlatform, static_cast<uint8_t>(record.platform));
+  Put(out, kUsbConnectionType,
+      static_cast<uint8_t>(record.usb_connection_type));
+  Put(out, kPowerSource, static_cast<uint8_t>(record.power_source));
+  Put(out, kUsbFlags, record.usb_flags);
+  return bytes;
+}
+
+}  // namespace ultra_secure_flutter_kit
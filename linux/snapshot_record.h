@@ -0,0 +1,188 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_SNAPSHOT_RECORD_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_SNAPSHOT_RECORD_H_
+
+// Binary form of a security snapshot, for callers that poll it often or
+// forward it without decoding.
+//
+// A record is kSnapshotRecordSize bytes with every field little-endian at
+// a fixed offset. Check results are bitfields indexed by Method id, which
+// only ever grows at the end, and strings are interned as one-byte codes
+// into the name tables below. `version` changes only if an existing field
+// moves or changes meaning; fields added later go after the current end
+// and raise `size`, so a reader accepts any record of its version that is
+// at least as long as the layout it knows.
+//
+// lib/src/models/security_snapshot_view.dart is generated from this
+// header and the method registry by tools/snapshot_view_main.cpp.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "check_registry.h"
+
+namespace ultra_secure_flutter_kit {
+
+inline constexpr uint32_t kSnapshotRecordMagic = 0x4B465355;  // "USFK"
+inline constexpr uint16_t kSnapshotRecordVersion = 1;
+inline constexpr size_t kSnapshotRecordSize = 64;
+
+enum class RecordPlatform : uint8_t { kUnknown, kLinux, kWindows };
+
+inline constexpr std::string_view kRecordPlatformNames[] = {
+    "unknown", "linux", "windows"};
+
+// The `connectionType` strings of getUsbConnectionStatus, across platforms.
+enum class UsbConnectionType : uint8_t {
+  kNone,
+  kDataTransfer,
+  kUsbCharging,
+  kUsbDebugging,
+  kCharging,
+};
+
+inline constexpr std::string_view kUsbConnectionTypeNames[] = {
+    "none", "data_transfer", "usb_charging", "usb_debugging", "charging"};
+
+enum class PowerSource : uint8_t { kUnknown, kNone, kAc, kUsb, kWireless };
+
+inline constexpr std::string_view kPowerSourceNames[] = {
+    "unknown", "none", "ac", "usb", "wireless"};
+
+// Bits of the `usbFlags` byte, named after the getUsbConnectionStatus keys.
+inline constexpr std::string_view kUsbFlagNames[] = {
+    "isCharging", "isDataTransfer", "isUsbCharging", "isConnectedToComputer",
+    "isConnectedViaUsb"};
+
+enum UsbFlag : uint8_t {
+  kUsbFlagCharging = 1 << 0,
+  kUsbFlagDataTransfer = 1 << 1,
+  kUsbFlagUsbCharging = 1 << 2,
+  kUsbFlagConnectedToComputer = 1 << 3,
+  kUsbFlagConnectedViaUsb = 1 << 4,
+};
+
+struct SnapshotRecord {
+  // Bit n stands for Method n: `checks` holds the answers, `present` which
+  // checks ran and `failed` which of them threw.
+  uint64_t checks = 0;
+  uint64_t present = 0;
+  uint64_t failed = 0;
+  int64_t timestamp_ms = 0;
+  int64_t duration_us = 0;
+  uint32_t queue_depth = 0;
+  uint32_t usb_device_count = 0;
+  RecordPlatform platform = RecordPlatform::kUnknown;
+  UsbConnectionType usb_connection_type = UsbConnectionType::kNone;
+  PowerSource power_source = PowerSource::kUnknown;
+  uint8_t usb_flags = 0;
+
+  void SetCheck(Method id, bool value, bool check_failed) {
+    const uint64_t bit = uint64_t{1} << static_cast<unsigned>(id);
+    present |= bit;
+    if (value) {
+      checks |= bit;
+    }
+    if (check_failed) {
+      failed |= bit;
+    }
+  }
+};
+
+std::vector<uint8_t> EncodeSnapshotRecord(const SnapshotRecord& record);
+
+// Layout description the Dart view is generated from.
+
+enum class RecordFieldType : uint8_t {
+  kUint8,
+  kUint16,
+  kUint32,
+  kUint64,
+  kInt64,
+};
+
+enum class RecordFieldRole : uint8_t {
+  kNumber,
+  kEnum,       // a code into `names`
+  kFlags,      // bit n is `names[n]`
+  kCheckBits,  // bit n is Method n
+};
+
+struct RecordField {
+  std::string_view name;  // getter name on the Dart side
+  uint16_t offset;
+  RecordFieldType type;
+  RecordFieldRole role = RecordFieldRole::kNumber;
+  const std::string_view* names = nullptr;
+  size_t name_count = 0;
+};
+
+inline constexpr RecordField kSnapshotRecordFields[] = {
+    {"magic", 0, RecordFieldType::kUint32},
+    {"version", 4, RecordFieldType::kUint16},
+    {"size", 6, RecordFieldType::kUint16},
+    {"checkBits", 8, RecordFieldType::kUint64, RecordFieldRole::kCheckBits},
+    {"presentBits", 16, RecordFieldType::kUint64, RecordFieldRole::kCheckBits},
+    {"failedBits", 24, RecordFieldType::kUint64, RecordFieldRole::kCheckBits},
+    {"timestamp", 32, RecordFieldType::kInt64},
+    {"durationMicros", 40, RecordFieldType::kInt64},
+    {"queueDepth", 48, RecordFieldType::kUint32},
+    {"usbDeviceCount", 52, RecordFieldType::kUint32},
+    {"platform", 56, RecordFieldType::kUint8, RecordFieldRole::kEnum,
+     kRecordPlatformNames, std::size(kRecordPlatformNames)},
+    {"usbConnectionType", 57, RecordFieldType::kUint8, RecordFieldRole::kEnum,
+     kUsbConnectionTypeNames, std::size(kUsbConnectionTypeNames)},
+    {"powerSource", 58, RecordFieldType::kUint8, RecordFieldRole::kEnum,
+     kPowerSourceNames, std::size(kPowerSourceNames)},
+    {"usbFlags", 59, RecordFieldType::kUint8, RecordFieldRole::kFlags,
+     kUsbFlagNames, std::size(kUsbFlagNames)},
+    // 60..63 reserved, zero.
+};
+
+namespace record_internal {
+
+constexpr size_t FieldWidth(RecordFieldType type) {
+  switch (type) {
+    case RecordFieldType::kUint8:
+      return 1;
+    case RecordFieldType::kUint16:
+      return 2;
+    case RecordFieldType::kUint32:
+      return 4;
+    default:
+      return 8;
+  }
+}
+
+constexpr bool FieldsFit() {
+  size_t end = 0;
+  for (const auto& field : kSnapshotRecordFields) {
+    if (field.offset < end || field.offset % FieldWidth(field.type) != 0) {
+      return false;
+    }
+    end = field.offset + FieldWidth(field.type);
+  }
+  return end <= kSnapshotRecordSize;
+}
+
+constexpr bool ChecksFitBitfield() {
+  for (const auto& method : kMethods) {
+    if (method.IsSnapshotCheck() && static_cast<size_t>(method.id) >= 64) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace record_internal
+
+static_assert(record_internal::FieldsFit(),
+              "record fields must be ordered, aligned and inside the record");
+static_assert(record_internal::ChecksFitBitfield(),
+              "snapshot checks need a wider bitfield and a new version");
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_SNAPSHOT_RECORD_H_
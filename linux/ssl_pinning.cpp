@@ -0,0 +1,270 @@
+#include "ssl_pinning.h"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <openssl/evp.h>
+#include <openssl/ssl.h>
+#include <openssl/x509.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+Sha256 HashSpki(X509* certificate) {
+  Sha256 digest{};
+  unsigned char* der = nullptr;
+  const int length =
+      i2d_X509_PUBKEY(X509_get_X509_PUBKEY(certificate), &der);
+  if (length > 0) {
+    EVP_Digest(der, length, digest.data(), nullptr, EVP_sha256(), nullptr);
+  }
+  OPENSSL_free(der);
+  return digest;
+}
+
+Sha256 HashCertificate(X509* certificate) {
+  Sha256 digest{};
+  unsigned int length = 0;
+  X509_digest(certificate, EVP_sha256(), digest.data(), &length);
+  return digest;
+}
+
+// Non-blocking connect bounded by `timeout`, then switched back to blocking
+// with the same timeout on reads and writes for the handshake.
+int ConnectWithTimeout(const std::string& host, const std::string& port,
+                       std::chrono::milliseconds timeout, std::string* error) {
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* addresses = nullptr;
+  const int status =
+      getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses);
+  if (status != 0) {
+    *error = std::string("resolve failed: ") + gai_strerror(status);
+    return -1;
+  }
+
+  int fd = -1;
+  for (addrinfo* address = addresses; address != nullptr;
+       address = address->ai_next) {
+    fd = socket(address->ai_family,
+                address->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                address->ai_protocol);
+    if (fd < 0) {
+      continue;
+    }
+    if (connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+      break;
+    }
+    if (errno == EINPROGRESS) {
+      pollfd poll_fd{fd, POLLOUT, 0};
+      int socket_error = 0;
+      socklen_t length = sizeof(socket_error);
+      if (poll(&poll_fd, 1, static_cast<int>(timeout.count())) == 1 &&
+          getsockopt(fd, SOL_SOCKET, SO_ERROR, &socket_error, &length) == 0 &&
+          socket_error == 0) {
+        break;
+      }
+    }
+    close(fd);
+    fd = -1;
+  }
+  freeaddrinfo(addresses);
+
+  if (fd < 0) {
+    *error = "connect failed";
+    return -1;
+  }
+
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+  timeval io_timeout;
+  io_timeout.tv_sec = timeout.count() / 1000;
+  io_timeout.tv_usec = (timeout.count() % 1000) * 1000;
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &io_timeout, sizeof(io_timeout));
+  setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &io_timeout, sizeof(io_timeout));
+  return fd;
+}
+
+}  // namespace
+
+bool ParseHttpsUrl(const std::string& url, std::string* host,
+                   std::string* port) {
+  constexpr const char kScheme[] = "https://";
+  const size_t scheme_length = sizeof(kScheme) - 1;
+  if (url.compare(0, scheme_length, kScheme) != 0) {
+    return false;
+  }
+
+  const size_t authority_end = url.find_first_of("/?#", scheme_length);
+  std::string authority = url.substr(
+      scheme_length, authority_end == std::string::npos
+                         ? std::string::npos
+                         : authority_end - scheme_length);
+  const size_t at = authority.rfind('@');
+  if (at != std::string::npos) {
+    authority.erase(0, at + 1);
+  }
+
+  size_t port_separator;
+  if (!authority.empty() && authority[0] == '[') {
+    const size_t bracket = authority.find(']');
+    if (bracket == std::string::npos) {
+      return false;
+    }
+    *host = authority.substr(1, bracket - 1);
+    port_separator = authority.find(':', bracket);
+  } else {
+    port_separator = authority.find(':');
+    *host = authority.substr(0, port_separator);
+  }
+  *port = port_separator == std::string::npos
+              ? "443"
+              : authority.substr(port_separator + 1);
+  return !host->empty() && !port->empty();
+}
+
+SslPinVerifier::SslPinVerifier(PinningOptions options)
+    : options_(std::move(options)) {}
+
+size_t SslPinVerifier::Configure(
+    const std::vector<std::string>& certificate_pins,
+    const std::vector<std::string>& public_key_pins) {
+  const size_t rejected = pins_.Update(certificate_pins, public_key_pins);
+  // Entries are already unreachable through their generation; this only
+  // releases the memory.
+  std::lock_guard<std::mutex> lock(mutex_);
+  host_leaves_.clear();
+  verified_.clear();
+  return rejected;
+}
+
+bool SslPinVerifier::HasPins() const { return !pins_.empty(); }
+
+PinVerification SslPinVerifier::Verify(const std::string& url) {
+  PinVerification verification;
+  std::string host;
+  std::string port;
+  if (!ParseHttpsUrl(url, &host, &port)) {
+    verification.error = "not an https URL";
+    return verification;
+  }
+  const std::string host_key = host + ":" + port;
+
+  {
+    const uint64_t generation = pins_.generation();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto leaf = host_leaves_.find(host_key);
+    if (leaf != host_leaves_.end()) {
+      auto verified = verified_.find(leaf->second);
+      if (verified != verified_.end() &&
+          verified->second.generation == generation &&
+          verified->second.expires > Clock::now()) {
+        verification.matched = true;
+        verification.from_cache = true;
+        return verification;
+      }
+    }
+  }
+
+  Sha256 leaf{};
+  uint64_t generation = 0;
+  Clock::time_point not_after;
+  verification = Handshake(host, port, &leaf, &generation, &not_after);
+  if (!verification.matched) {
+    return verification;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  host_leaves_[host_key] = leaf;
+  VerifiedLeaf& entry = verified_[leaf];
+  entry.expires = std::min(Clock::now() + options_.cache_ttl, not_after);
+  entry.generation = generation;
+  return verification;
+}
+
+PinVerification SslPinVerifier::Handshake(
+    const std::string& host, const std::string& port, Sha256* leaf,
+    uint64_t* generation, Clock::time_point* not_after) {
+  PinVerification verification;
+
+  SSL_CTX* context = SSL_CTX_new(TLS_client_method());
+  if (context == nullptr) {
+    verification.error = "cannot create TLS context";
+    return verification;
+  }
+  SSL_CTX_set_min_proto_version(context, TLS1_2_VERSION);
+  SSL_CTX_set_verify(context, SSL_VERIFY_PEER, nullptr);
+  SSL_CTX_set_default_verify_paths(context);
+  if (!options_.ca_file.empty()) {
+    SSL_CTX_load_verify_locations(context, options_.ca_file.c_str(), nullptr);
+  }
+
+  const int fd = ConnectWithTimeout(host, port, options_.timeout,
+                                    &verification.error);
+  if (fd < 0) {
+    SSL_CTX_free(context);
+    return verification;
+  }
+
+  SSL* ssl = SSL_new(context);
+  SSL_set_fd(ssl, fd);
+  SSL_set_tlsext_host_name(ssl, host.c_str());
+  X509_VERIFY_PARAM* parameters = SSL_get0_param(ssl);
+  if (X509_VERIFY_PARAM_set1_ip_asc(parameters, host.c_str()) != 1) {
+    X509_VERIFY_PARAM_set1_host(parameters, host.c_str(), 0);
+  }
+
+  if (SSL_connect(ssl) != 1) {
+    const long result = SSL_get_verify_result(ssl);
+    verification.error =
+        result != X509_V_OK
+            ? std::string("chain rejected: ") +
+                  X509_verify_cert_error_string(result)
+            : std::string("handshake failed");
+  } else {
+    STACK_OF(X509)* chain = SSL_get0_verified_chain(ssl);
+    const int count = chain == nullptr ? 0 : sk_X509_num(chain);
+    {
+      // Held only for the lookups, so a concurrent Configure() waits for
+      // microseconds rather than for the network.
+      PinStore::Reader reader(pins_);
+      const PinSet& pins = reader.pins();
+      for (int i = 0; i < count && !verification.matched; ++i) {
+        X509* certificate = sk_X509_value(chain, i);
+        verification.matched =
+            pins.public_keys.Contains(HashSpki(certificate)) ||
+            pins.certificates.Contains(HashCertificate(certificate));
+      }
+      *generation = pins.generation;
+    }
+    if (count == 0) {
+      verification.error = "no verified chain";
+    } else if (!verification.matched) {
+      verification.error = "no pinned key in chain";
+    } else {
+      X509* certificate = sk_X509_value(chain, 0);
+      *leaf = HashCertificate(certificate);
+      int days = 0;
+      int seconds = 0;
+      ASN1_TIME_diff(&days, &seconds, nullptr,
+                     X509_get0_notAfter(certificate));
+      *not_after = Clock::now() + std::chrono::hours(24) * days +
+                   std::chrono::seconds(seconds);
+    }
+    SSL_shutdown(ssl);
+  }
+
+  SSL_free(ssl);
+  close(fd);
+  SSL_CTX_free(context);
+  return verification;
+}
+
+}  // namespace ultra_secure_flutter_kit
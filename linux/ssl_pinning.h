@@ -0,0 +1,88 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_SSL_PINNING_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_SSL_PINNING_H_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "pin_store.h"
+
+namespace ultra_secure_flutter_kit {
+
+struct PinningOptions {
+  // How long a successful verification of a leaf certificate is reused.
+  // Never extends past the certificate's notAfter.
+  std::chrono::seconds cache_ttl{300};
+  // Connect plus handshake deadline.
+  std::chrono::milliseconds timeout{5000};
+  // Extra PEM trust anchors, e.g. a private CA or a self-signed test
+  // certificate. The system store is always used as well.
+  std::string ca_file;
+};
+
+struct PinVerification {
+  bool matched = false;
+  bool from_cache = false;
+  std::string error;  // set when the connection or chain check failed
+};
+
+// Checks that the TLS chain served for a URL contains a pinned key.
+//
+// Pins use the HPKP form "sha256/<base64>". Public-key pins are the SHA-256
+// of a certificate's DER SubjectPublicKeyInfo; certificate pins are the
+// SHA-256 of the whole DER certificate. A URL passes when the chain
+// verifies against the trust store for its host name and any certificate
+// in the verified chain matches either kind of pin.
+//
+// Passing results are cached by the SHA-256 of the leaf certificate, and
+// the host's last-seen leaf is remembered, so a repeat call within the TTL
+// does no network I/O and no certificate parsing.
+class SslPinVerifier {
+ public:
+  explicit SslPinVerifier(PinningOptions options = PinningOptions());
+
+  // Publishes a new pin set; results cached under the old set are no
+  // longer served. Safe to call while verifications are in flight. Returns
+  // the number of malformed pins that were skipped.
+  size_t Configure(const std::vector<std::string>& certificate_pins,
+                   const std::vector<std::string>& public_key_pins);
+
+  bool HasPins() const;
+
+  PinVerification Verify(const std::string& url);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct VerifiedLeaf {
+    Clock::time_point expires;
+    uint64_t generation = 0;  // PinSet generation it was matched against
+  };
+
+  // Connects, verifies the chain and matches it against the pins. On
+  // success `leaf` and `not_after` describe the served leaf certificate.
+  PinVerification Handshake(const std::string& host, const std::string& port,
+                            Sha256* leaf, uint64_t* generation,
+                            Clock::time_point* not_after);
+
+  const PinningOptions options_;
+
+  PinStore pins_;
+
+  // Guards the result cache only; pin lookups go through `pins_`.
+  std::mutex mutex_;
+  std::map<std::string, Sha256> host_leaves_;  // "host:port" -> leaf hash
+  std::map<Sha256, VerifiedLeaf> verified_;
+};
+
+// Splits "https://host[:port][/path]" into host and port. Returns false for
+// any other scheme. IPv6 literals are accepted in brackets.
+bool ParseHttpsUrl(const std::string& url, std::string* host,
+                   std::string* port);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_SSL_PINNING_H_
@@ -0,0 +1,95 @@
+#include "system_checks.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iterator>
+
+#include "path_probe.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr const char* kRootTools[] = {
+    "/usr/bin/sudo",
+    "/usr/bin/su",
+    "/usr/local/bin/brew",
+};
+
+constexpr const char* kPackageManagerTraces[] = {
+    "/tmp/cydia",
+    "/var/lib/dpkg",
+    "/etc/apt",
+};
+
+constexpr const char* kDeveloperTools[] = {
+    "/usr/bin/gcc", "/usr/bin/make", "/usr/bin/git",
+    "/usr/bin/vim", "/usr/bin/emacs",
+};
+
+constexpr const char* kReverseEngineeringTools[] = {
+    "/usr/bin/gdb", "/usr/bin/lldb",   "/usr/bin/objdump", "/usr/bin/strings",
+    "/usr/bin/nm",  "/usr/bin/strace", "/usr/bin/ltrace",
+};
+
+constexpr const char* kProxyVariables[] = {
+    "http_proxy",
+    "https_proxy",
+    "HTTP_PROXY",
+    "HTTPS_PROXY",
+};
+
+template <size_t N>
+const char* FindFirstExisting(const char* const (&paths)[N]) {
+  const int index = PathProbe::Instance().FindFirst(paths, N);
+  return index < 0 ? nullptr : paths[index];
+}
+
+}  // namespace
+
+const char kScreenCaptureFlagPath[] = "/tmp/screenshot_blocking_enabled";
+
+const char* FindRootTool() { return FindFirstExisting(kRootTools); }
+
+bool IsRunningAsRoot() { return getuid() == 0; }
+
+const char* FindPackageManagerTrace() {
+  return FindFirstExisting(kPackageManagerTraces);
+}
+
+const char* FindDeveloperTool() { return FindFirstExisting(kDeveloperTools); }
+
+std::vector<const char*> FindReverseEngineeringTools() {
+  constexpr size_t kCount = std::size(kReverseEngineeringTools);
+  bool exists[kCount];
+  PathProbe::Instance().Probe(kReverseEngineeringTools, kCount, exists);
+
+  std::vector<const char*> found;
+  for (size_t i = 0; i < kCount; ++i) {
+    if (exists[i]) {
+      found.push_back(kReverseEngineeringTools[i]);
+    }
+  }
+  return found;
+}
+
+const char* FindProxyVariable(const char** value) {
+  for (const char* name : kProxyVariables) {
+    const char* setting = getenv(name);
+    if (setting != nullptr && *setting != '\0') {
+      if (value != nullptr) {
+        *value = setting;
+      }
+      return name;
+    }
+  }
+  return nullptr;
+}
+
+bool IsScreenCaptureFlagSet() {
+  const char* const paths[] = {kScreenCaptureFlagPath};
+  return PathProbe::Instance().FindFirst(paths, 1) == 0;
+}
+
+}  // namespace ultra_secure_flutter_kit
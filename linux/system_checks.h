@@ -0,0 +1,40 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_SYSTEM_CHECKS_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_SYSTEM_CHECKS_H_
+
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+// The file and environment probes behind the Linux yes/no checks. Each
+// Find* function returns the first entry of its fixed list that is present
+// (a path, interface or variable name with static storage) or nullptr, so
+// callers can report the evidence without allocating. Paths resolve under
+// FilesystemRoot() and are answered by PathProbe, so repeated checks cost
+// one statx() per directory while nothing changes.
+
+// isRooted: privilege escalation tools.
+const char* FindRootTool();
+bool IsRunningAsRoot();
+
+// isJailbroken: package-manager state that indicates a modified system.
+const char* FindPackageManagerTrace();
+
+// isDeveloperModeEnabled: compilers, editors and build tools.
+const char* FindDeveloperTool();
+
+// preventReverseEngineering: every debugger or binary inspection tool
+// present.
+std::vector<const char*> FindReverseEngineeringTools();
+
+// hasProxySettings: the first non-empty proxy variable; its value is
+// stored in `value` when not null.
+const char* FindProxyVariable(const char** value);
+
+// isScreenCaptureBlocked: the flag file written by
+// enableScreenCaptureProtection.
+extern const char kScreenCaptureFlagPath[];
+bool IsScreenCaptureFlagSet();
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_SYSTEM_CHECKS_H_
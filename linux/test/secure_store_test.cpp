@@ -0,0 +1,149 @@
+#include "secure_store.h"
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace ultra_secure_flutter_kit {
+namespace {
+
+constexpr size_t kHeaderSize = 64;
+
+const SecureVector<uint8_t>& TestKey() {
+  static const SecureVector<uint8_t> key(32, 7);
+  return key;
+}
+
+class SecureStoreTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char directory[] = "/tmp/secure_store_test.XXXXXX";
+    ASSERT_NE(mkdtemp(directory), nullptr);
+    directory_ = directory;
+    options_.path = directory_ + "/store.log";
+  }
+
+  void TearDown() override {
+    unlink(options_.path.c_str());
+    rmdir(directory_.c_str());
+  }
+
+  std::string Get(SecureStore& store, const std::string& key) {
+    SecureString value;
+    if (!store.Get(key, &value)) {
+      return "<absent>";
+    }
+    return std::string(value.data(), value.size());
+  }
+
+  off_t LogSize() const {
+    struct stat status;
+    return stat(options_.path.c_str(), &status) == 0 ? status.st_size : -1;
+  }
+
+  void Overwrite(off_t offset, const void* data, size_t size) {
+    const int fd = open(options_.path.c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(pwrite(fd, data, size, offset), static_cast<ssize_t>(size));
+    close(fd);
+  }
+
+  void AppendBytes(const void* data, size_t size) {
+    const int fd = open(options_.path.c_str(), O_WRONLY | O_APPEND);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(write(fd, data, size), static_cast<ssize_t>(size));
+    close(fd);
+  }
+
+  std::string directory_;
+  SecureStoreOptions options_;
+};
+
+TEST_F(SecureStoreTest, CutsOffTornTail) {
+  {
+    SecureStore store(&TestKey, options_);
+    store.Put("a", "1");
+  }
+  // A size prefix declaring more bytes than the append got to write.
+  AppendBytes("\x30\0\0\0partial", 11);
+
+  SecureStore store(&TestKey, options_);
+  EXPECT_EQ(Get(store, "a"), "1");
+  EXPECT_EQ(store.GetStats().truncated_bytes, 11u);
+}
+
+TEST_F(SecureStoreTest, RefusesDamagedSizePrefixBeforeLastRecord) {
+  off_t second = 0;
+  {
+    SecureStore store(&TestKey, options_);
+    store.Put("a", "1");
+    second = static_cast<off_t>(store.GetStats().log_bytes);
+    store.Put("b", "2");
+    store.Put("c", "3");
+  }
+  const off_t size = LogSize();
+  // The top byte of the second record's size prefix, so it claims far more
+  // than the rest of the log.
+  const uint8_t damaged = 0x7f;
+  Overwrite(second + 3, &damaged, 1);
+
+  {
+    SecureStore store(&TestKey, options_);
+    EXPECT_THROW(Get(store, "a"), std::runtime_error);
+  }
+  EXPECT_EQ(LogSize(), size);
+
+  const uint8_t repaired = 0;
+  Overwrite(second + 3, &repaired, 1);
+  SecureStore store(&TestKey, options_);
+  EXPECT_EQ(Get(store, "b"), "2");
+  EXPECT_EQ(Get(store, "c"), "3");
+}
+
+TEST_F(SecureStoreTest, RefusesRecordFailingBeforeLastRecord) {
+  {
+    SecureStore store(&TestKey, options_);
+    store.Put("a", "1");
+    store.Put("b", "2");
+  }
+  const off_t size = LogSize();
+  const uint8_t damaged = 0xff;
+  Overwrite(kHeaderSize + 4 + 20, &damaged, 1);
+
+  SecureStore store(&TestKey, options_);
+  EXPECT_THROW(Get(store, "b"), std::runtime_error);
+  EXPECT_EQ(LogSize(), size);
+}
+
+TEST_F(SecureStoreTest, RejectsReplayedRecord) {
+  off_t put_end = 0;
+  {
+    SecureStore store(&TestKey, options_);
+    store.Put("a", "1");
+    put_end = static_cast<off_t>(store.GetStats().log_bytes);
+    store.Put("a", "2");
+    store.Put("b", "3");
+    ASSERT_TRUE(store.Delete("b"));
+  }
+  // Both puts of "a" are sealed under the same key; append the first again.
+  std::string first(put_end - kHeaderSize, '\0');
+  const int fd = open(options_.path.c_str(), O_RDONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(pread(fd, first.data(), first.size(), kHeaderSize),
+            static_cast<ssize_t>(first.size()));
+  close(fd);
+  AppendBytes(first.data(), first.size());
+
+  SecureStore store(&TestKey, options_);
+  EXPECT_EQ(Get(store, "a"), "2");
+  EXPECT_EQ(Get(store, "b"), "<absent>");
+  EXPECT_EQ(store.GetStats().truncated_bytes, first.size());
+}
+
+}  // namespace
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,279 @@
+#include "text_scanner.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+int64_t ThreadCpuNanos() {
+  timespec now;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+  return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+std::string BaseName(std::string_view path) {
+  const size_t slash = path.rfind('/');
+  return std::string(slash == std::string_view::npos ? path
+                                                     : path.substr(slash + 1));
+}
+
+bool ParseHex(std::string_view text, uintptr_t* value) {
+  uintptr_t result = 0;
+  if (text.empty()) {
+    return false;
+  }
+  for (const char c : text) {
+    int digit;
+    if (c >= '0' && c <= '9') {
+      digit = c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      digit = c - 'a' + 10;
+    } else {
+      return false;
+    }
+    result = result * 16 + static_cast<uintptr_t>(digit);
+  }
+  *value = result;
+  return true;
+}
+
+std::string ExecutableBaseName() {
+  char buffer[4096];
+  const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+  return length > 0 ? BaseName(std::string_view(buffer, length)) : std::string();
+}
+
+}  // namespace
+
+uint64_t HashCodePage(const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  uint64_t lanes[4] = {kPrime1, kPrime2, kPrime3, kPrime1 ^ kPrime2};
+
+  size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    for (int lane = 0; lane < 4; ++lane) {
+      uint64_t word;
+      memcpy(&word, bytes + offset + lane * 8, sizeof(word));
+      lanes[lane] = RotateLeft(lanes[lane] + word * kPrime2, 31) * kPrime1;
+    }
+  }
+
+  uint64_t hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) +
+                  RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+  for (; offset < size; ++offset) {
+    hash = RotateLeft(hash ^ (bytes[offset] * kPrime3), 11) * kPrime1;
+  }
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  return hash;
+}
+
+TextScanner::TextScanner(TamperCallback callback)
+    : callback_(std::move(callback)) {}
+
+TextScanner::~TextScanner() { Stop(); }
+
+bool TextScanner::Start(const TextScannerOptions& options) {
+  Stop();
+
+  options_ = options;
+  if (options_.modules.empty()) {
+    options_.modules.push_back(ExecutableBaseName());
+  }
+
+  regions_.clear();
+  ScanLines("/proc/self/maps", [this](std::string_view line) {
+    // "start-end perms offset dev inode   path"
+    const size_t dash = line.find('-');
+    const size_t space = line.find(' ');
+    const size_t path_start = line.find('/');
+    if (dash == std::string_view::npos || space == std::string_view::npos ||
+        path_start == std::string_view::npos || space + 5 > line.size() ||
+        line.substr(space + 1, 4) != "r-xp") {
+      return true;
+    }
+    const std::string_view path = line.substr(path_start);
+    const std::string name = BaseName(path);
+    if (std::find(options_.modules.begin(), options_.modules.end(), name) ==
+        options_.modules.end()) {
+      return true;
+    }
+    const size_t offset_start = space + 6;
+    const size_t offset_end = line.find(' ', offset_start);
+    const size_t device_end = line.find(' ', offset_end + 1);
+    const size_t inode_end = line.find(' ', device_end + 1);
+    Region region;
+    uintptr_t file_offset = 0;
+    long inode = 0;
+    if (inode_end == std::string_view::npos ||
+        !ParseHex(line.substr(0, dash), &region.start) ||
+        !ParseHex(line.substr(dash + 1, space - dash - 1), &region.end) ||
+        !ParseHex(line.substr(offset_start, offset_end - offset_start),
+                  &file_offset) ||
+        !ParseInt(line.substr(device_end + 1, inode_end - device_end - 1),
+                  &inode)) {
+      return true;
+    }
+    region.file_offset = file_offset;
+    region.inode = static_cast<ino_t>(inode);
+    region.path.assign(path.data(), path.size());
+    regions_.push_back(std::move(region));
+    return true;
+  });
+  if (regions_.empty()) {
+    return false;
+  }
+
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  uint64_t pages = 0;
+  for (auto& region : regions_) {
+    TakeBaseline(&region, page_size);
+    region.reported.assign(region.page_hashes.size(), false);
+    pages += region.page_hashes.size();
+  }
+  pages_ = pages;
+  pages_scanned_ = 0;
+  full_passes_ = 0;
+  tampered_pages_ = 0;
+  region_cursor_ = 0;
+  page_cursor_ = 0;
+
+  running_ = true;
+  thread_ = std::thread(&TextScanner::Run, this);
+  return true;
+}
+
+void TextScanner::TakeBaseline(Region* region, size_t page_size) {
+  // A file replaced since it was mapped (an upgrade, or " (deleted)" in
+  // the maps line) no longer describes the mapping.
+  int fd = open(region->path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat info;
+  if (fd >= 0 && (fstat(fd, &info) != 0 || info.st_ino != region->inode)) {
+    close(fd);
+    fd = -1;
+  }
+
+  std::vector<uint8_t> buffer(page_size);
+  for (uintptr_t page = region->start; page < region->end; page += page_size) {
+    const void* contents = reinterpret_cast<const void*>(page);
+    if (fd >= 0) {
+      const off_t offset =
+          static_cast<off_t>(region->file_offset + (page - region->start));
+      const ssize_t length = pread(fd, buffer.data(), page_size, offset);
+      if (length > 0) {
+        // The part of the last page beyond the end of the file is mapped
+        // as zeros.
+        std::fill(buffer.begin() + length, buffer.end(), 0);
+        contents = buffer.data();
+      }
+    }
+    region->page_hashes.push_back(HashCodePage(contents, page_size));
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+void TextScanner::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    if (!running_.exchange(false)) {
+      return;
+    }
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+TextScannerStats TextScanner::GetStats() const {
+  TextScannerStats stats;
+  stats.pages = pages_.load();
+  stats.pages_scanned = pages_scanned_.load();
+  stats.full_passes = full_passes_.load();
+  stats.tampered_pages = tampered_pages_.load();
+  return stats;
+}
+
+void TextScanner::Run() {
+  const int64_t budget_ns = static_cast<int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(options_.tick)
+          .count() *
+      options_.cpu_fraction);
+
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  while (running_.load()) {
+    lock.unlock();
+    ScanSlice(std::max<int64_t>(budget_ns, 1));
+    lock.lock();
+    wake_.wait_for(lock, options_.tick, [this] { return !running_.load(); });
+  }
+}
+
+void TextScanner::ScanSlice(int64_t budget_ns) {
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const int64_t deadline = ThreadCpuNanos() + budget_ns;
+
+  // Check the clock every few pages; a page hashes in well under a
+  // microsecond, so the overshoot stays small.
+  constexpr int kPagesPerClockCheck = 8;
+  for (int since_check = 0;; ++since_check) {
+    if (since_check == kPagesPerClockCheck) {
+      if (ThreadCpuNanos() >= deadline) {
+        return;
+      }
+      since_check = 0;
+    }
+
+    Region& region = regions_[region_cursor_];
+    const uintptr_t page = region.start + page_cursor_ * page_size;
+    const uint64_t hash =
+        HashCodePage(reinterpret_cast<const void*>(page), page_size);
+    pages_scanned_.fetch_add(1, std::memory_order_relaxed);
+
+    if (hash != region.page_hashes[page_cursor_] &&
+        !region.reported[page_cursor_]) {
+      region.reported[page_cursor_] = true;
+      tampered_pages_.fetch_add(1, std::memory_order_relaxed);
+      if (callback_) {
+        CodeTamperEvent event;
+        event.module = region.path;
+        event.address = page;
+        event.offset = page - region.start;
+        callback_(event);
+      }
+    }
+
+    if (++page_cursor_ == region.page_hashes.size()) {
+      page_cursor_ = 0;
+      if (++region_cursor_ == regions_.size()) {
+        region_cursor_ = 0;
+        full_passes_.fetch_add(1, std::memory_order_relaxed);
+        // Small watch sets would otherwise re-hash the same pages until the
+        // budget runs out.
+        return;
+      }
+    }
+  }
+}
+
+}  // namespace ultra_secure_flutter_kit
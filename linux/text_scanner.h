@@ -0,0 +1,112 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_TEXT_SCANNER_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_TEXT_SCANNER_H_
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+struct TextScannerOptions {
+  // Share of one core the scanner may use, e.g. 0.002 for 0.2 %.
+  double cpu_fraction = 0.002;
+  // How often the scanner wakes up. Each tick spends at most
+  // tick * cpu_fraction of thread CPU time hashing pages.
+  std::chrono::milliseconds tick{100};
+  // Base names of the mapped files whose executable segments are watched.
+  // Empty means the main executable only.
+  std::vector<std::string> modules;
+};
+
+struct CodeTamperEvent {
+  std::string module;  // path of the mapped file
+  uintptr_t address = 0;
+  uint64_t offset = 0;  // offset of the page from the start of the mapping
+};
+
+struct TextScannerStats {
+  uint64_t pages = 0;          // pages under watch
+  uint64_t pages_scanned = 0;  // pages hashed since start
+  uint64_t full_passes = 0;    // completed sweeps over every page
+  uint64_t tampered_pages = 0;
+};
+
+// Re-hashes the executable mappings of selected modules in the background
+// and reports pages whose contents differ from the files they were mapped
+// from. The baseline is hashed from those files rather than from memory,
+// so code patched before Start() is reported on the first pass too.
+//
+// Work is sliced by CPU time rather than page count: each tick hashes pages
+// until its share of the budget is spent and resumes there on the next tick,
+// so the cost stays fixed no matter how large the watched libraries are and
+// a patched page is found within roughly (code size / throughput / budget).
+class TextScanner {
+ public:
+  using TamperCallback = std::function<void(const CodeTamperEvent&)>;
+
+  explicit TextScanner(TamperCallback callback);
+  ~TextScanner();
+
+  TextScanner(const TextScanner&) = delete;
+  TextScanner& operator=(const TextScanner&) = delete;
+
+  // Captures the baseline and starts the scanner thread. Restarts with the
+  // new options if already running. Returns false if no executable mapping
+  // matched `options.modules`.
+  bool Start(const TextScannerOptions& options);
+  void Stop();
+
+  bool IsRunning() const { return running_.load(); }
+  TextScannerStats GetStats() const;
+
+ private:
+  struct Region {
+    std::string path;
+    uintptr_t start = 0;
+    uintptr_t end = 0;
+    uint64_t file_offset = 0;
+    ino_t inode = 0;
+    std::vector<uint64_t> page_hashes;
+    std::vector<bool> reported;
+  };
+
+  // Hashes each page of `region` as read from its file, or from memory
+  // where the file no longer matches the mapping.
+  static void TakeBaseline(Region* region, size_t page_size);
+  void Run();
+  // Hashes pages from the cursor until `budget_ns` of thread CPU time is
+  // used or a full pass completes.
+  void ScanSlice(int64_t budget_ns);
+
+  TamperCallback callback_;
+  TextScannerOptions options_;
+  std::vector<Region> regions_;
+  size_t region_cursor_ = 0;
+  size_t page_cursor_ = 0;
+
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+
+  std::atomic<uint64_t> pages_{0};
+  std::atomic<uint64_t> pages_scanned_{0};
+  std::atomic<uint64_t> full_passes_{0};
+  std::atomic<uint64_t> tampered_pages_{0};
+};
+
+// Fast non-cryptographic 64-bit hash of one code page. Four independent
+// multiply-rotate lanes over 8-byte words, which compilers vectorize.
+uint64_t HashCodePage(const void* data, size_t size);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_TEXT_SCANNER_H_
@@ -0,0 +1,307 @@
+// Generates the signing key, the signed asset manifest checked by
+// AssetVerifier (asset_integrity.h) and the signed integrity manifest
+// checked by AppIntegrityVerifier (app_integrity.h).
+//
+// Usage:
+//   ultra_secure_flutter_kit_asset_manifest keygen <private.pem> <header>
+//   ultra_secure_flutter_kit_asset_manifest sign <private.pem> <output>
+//       <bundle dir>
+//   ultra_secure_flutter_kit_asset_manifest sign-binaries <private.pem>
+//       <output> <file>...
+//
+// `keygen` creates an Ed25519 key at <private.pem> unless one is already
+// there and writes its public half to <header> as kAssetManifestPublicKey.
+// The header is only rewritten when it changes, so the plugin is not
+// rebuilt on every configure.
+//
+// `sign` runs at install time over <bundle dir>/data/flutter_assets and
+// <bundle dir>/lib/libapp.so (absent in debug builds). `sign-binaries`
+// runs over the bundled executable and libraries, listed by base name;
+// files that do not exist are skipped.
+
+#include <dirent.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../app_integrity.h"
+#include "../asset_integrity.h"
+#include "../parallel_for.h"
+
+namespace {
+
+using ultra_secure_flutter_kit::ManifestEntry;
+
+EVP_PKEY* ReadPrivateKey(const std::string& path) {
+  FILE* file = fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    return nullptr;
+  }
+  EVP_PKEY* key = PEM_read_PrivateKey(file, nullptr, nullptr, nullptr);
+  fclose(file);
+  return key;
+}
+
+EVP_PKEY* CreatePrivateKey(const std::string& path) {
+  EVP_PKEY* key = nullptr;
+  EVP_PKEY_CTX* context = EVP_PKEY_CTX_new_id(EVP_PKEY_ED25519, nullptr);
+  if (context == nullptr || EVP_PKEY_keygen_init(context) != 1 ||
+      EVP_PKEY_keygen(context, &key) != 1) {
+    EVP_PKEY_CTX_free(context);
+    return nullptr;
+  }
+  EVP_PKEY_CTX_free(context);
+
+  const mode_t previous = umask(077);
+  FILE* file = fopen(path.c_str(), "w");
+  umask(previous);
+  if (file == nullptr ||
+      PEM_write_PrivateKey(file, key, nullptr, nullptr, 0, nullptr, nullptr) !=
+          1) {
+    if (file != nullptr) {
+      fclose(file);
+    }
+    EVP_PKEY_free(key);
+    return nullptr;
+  }
+  fclose(file);
+  return key;
+}
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+int Keygen(const std::string& key_path, const std::string& header_path) {
+  EVP_PKEY* key = ReadPrivateKey(key_path);
+  if (key == nullptr) {
+    key = CreatePrivateKey(key_path);
+    if (key == nullptr) {
+      std::cerr << "Asset manifest: cannot create " << key_path << std::endl;
+      return 1;
+    }
+    std::cout << "Asset manifest: new signing key " << key_path << std::endl;
+  }
+  ultra_secure_flutter_kit::AssetManifestKey public_key{};
+  size_t size = public_key.size();
+  const bool ok = EVP_PKEY_get_raw_public_key(key, public_key.data(), &size) ==
+                      1 &&
+                  size == public_key.size();
+  EVP_PKEY_free(key);
+  if (!ok) {
+    std::cerr << "Asset manifest: " << key_path << " is not an Ed25519 key"
+              << std::endl;
+    return 1;
+  }
+
+  std::ostringstream header;
+  header << "// Generated by ultra_secure_flutter_kit_asset_manifest from the "
+            "asset\n// signing key; do not edit.\n\n"
+         << "#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_ASSET_MANIFEST_KEY_H_\n"
+         << "#define ULTRA_SECURE_FLUTTER_KIT_LINUX_ASSET_MANIFEST_KEY_H_\n\n"
+         << "#include \"asset_integrity.h\"\n\n"
+         << "namespace ultra_secure_flutter_kit {\n\n"
+         << "constexpr AssetManifestKey kAssetManifestPublicKey = {";
+  for (size_t i = 0; i < public_key.size(); ++i) {
+    char byte[8];
+    snprintf(byte, sizeof(byte), "0x%02x", public_key[i]);
+    header << (i % 8 == 0 ? "\n    " : " ") << byte
+           << (i + 1 < public_key.size() ? "," : "");
+  }
+  header << "};\n\n}  // namespace ultra_secure_flutter_kit\n\n"
+         << "#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_ASSET_MANIFEST_KEY_H_\n";
+
+  if (ReadFile(header_path) == header.str()) {
+    return 0;
+  }
+  std::ofstream file(header_path, std::ios::trunc | std::ios::binary);
+  file << header.str();
+  if (!file.good()) {
+    std::cerr << "Asset manifest: cannot write " << header_path << std::endl;
+    return 1;
+  }
+  return 0;
+}
+
+// Formats `entries`, appends the signature line and replaces `output`
+// with the result. Takes ownership of `key`.
+bool WriteSigned(EVP_PKEY* key, const std::vector<ManifestEntry>& entries,
+                 const std::string& output) {
+  std::string text = ultra_secure_flutter_kit::FormatIntegrityManifest(entries);
+  uint8_t signature[64];
+  size_t signature_size = sizeof(signature);
+  EVP_MD_CTX* context = EVP_MD_CTX_new();
+  const bool signed_ok =
+      context != nullptr &&
+      EVP_DigestSignInit(context, nullptr, nullptr, nullptr, key) == 1 &&
+      EVP_DigestSign(context, signature, &signature_size,
+                     reinterpret_cast<const uint8_t*>(text.data()),
+                     text.size()) == 1 &&
+      signature_size == sizeof(signature);
+  EVP_MD_CTX_free(context);
+  EVP_PKEY_free(key);
+  if (!signed_ok) {
+    std::cerr << "Manifest: signing " << output << " failed" << std::endl;
+    return false;
+  }
+  text += ultra_secure_flutter_kit::kAssetSignaturePrefix;
+  for (const uint8_t byte : signature) {
+    text += "0123456789abcdef"[byte / 16];
+    text += "0123456789abcdef"[byte % 16];
+  }
+  text += '\n';
+
+  const std::string temporary = output + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::trunc | std::ios::binary);
+    file << text;
+    if (!file.good()) {
+      std::cerr << "Manifest: cannot write " << temporary << std::endl;
+      return false;
+    }
+  }
+  if (rename(temporary.c_str(), output.c_str()) != 0) {
+    std::cerr << "Manifest: cannot write " << output << std::endl;
+    return false;
+  }
+  return true;
+}
+
+// Adds the regular files under `bundle`/`relative`, recursively, as paths
+// relative to `bundle`.
+void ListFiles(const std::string& bundle, const std::string& relative,
+               std::vector<std::string>* names) {
+  DIR* directory = opendir((bundle + "/" + relative).c_str());
+  if (directory == nullptr) {
+    return;
+  }
+  while (const dirent* entry = readdir(directory)) {
+    const std::string name = entry->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    const std::string child = relative + "/" + name;
+    struct stat info;
+    if (lstat((bundle + "/" + child).c_str(), &info) != 0) {
+      continue;
+    }
+    if (S_ISDIR(info.st_mode)) {
+      ListFiles(bundle, child, names);
+    } else if (S_ISREG(info.st_mode)) {
+      names->push_back(child);
+    }
+  }
+  closedir(directory);
+}
+
+int Sign(const std::string& key_path, const std::string& output,
+         const std::string& bundle) {
+  EVP_PKEY* key = ReadPrivateKey(key_path);
+  if (key == nullptr) {
+    std::cerr << "Asset manifest: cannot read " << key_path << std::endl;
+    return 1;
+  }
+
+  std::vector<std::string> names;
+  ListFiles(bundle, "data/flutter_assets", &names);
+  struct stat info;
+  if (stat((bundle + "/lib/libapp.so").c_str(), &info) == 0) {
+    names.push_back("lib/libapp.so");
+  }
+  std::sort(names.begin(), names.end());
+
+  // Files across cores, each hashed by one thread.
+  std::vector<ManifestEntry> entries(names.size());
+  std::vector<char> failed(names.size(), 0);
+  ultra_secure_flutter_kit::ParallelFor(
+      names.size(), ultra_secure_flutter_kit::HardwareWorkers(), [&](size_t i) {
+        entries[i].name = names[i];
+        failed[i] = ultra_secure_flutter_kit::HashFileMerkle(
+                        bundle + "/" + names[i], nullptr, &entries[i].digest,
+                        1) != ultra_secure_flutter_kit::HashOutcome::kOk;
+        return true;
+      });
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (failed[i]) {
+      std::cerr << "Asset manifest: cannot hash " << names[i] << std::endl;
+      EVP_PKEY_free(key);
+      return 1;
+    }
+  }
+
+  if (!WriteSigned(key, entries, output)) {
+    return 1;
+  }
+  std::cout << "Asset manifest: " << entries.size() << " files -> " << output
+            << std::endl;
+  return 0;
+}
+
+int SignBinaries(const std::string& key_path, const std::string& output,
+                 const std::vector<std::string>& paths) {
+  EVP_PKEY* key = ReadPrivateKey(key_path);
+  if (key == nullptr) {
+    std::cerr << "Integrity manifest: cannot read " << key_path << std::endl;
+    return 1;
+  }
+
+  std::vector<ManifestEntry> entries;
+  for (const auto& path : paths) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0) {
+      std::cout << "Integrity manifest: skipping missing " << path << std::endl;
+      continue;
+    }
+    ManifestEntry entry;
+    const size_t slash = path.rfind('/');
+    entry.name = slash == std::string::npos ? path : path.substr(slash + 1);
+    if (ultra_secure_flutter_kit::HashFileMerkle(path, nullptr,
+                                                 &entry.digest) !=
+        ultra_secure_flutter_kit::HashOutcome::kOk) {
+      std::cerr << "Integrity manifest: cannot hash " << path << std::endl;
+      EVP_PKEY_free(key);
+      return 1;
+    }
+    entries.push_back(std::move(entry));
+  }
+
+  if (!WriteSigned(key, entries, output)) {
+    return 1;
+  }
+  std::cout << "Integrity manifest: " << entries.size() << " files -> "
+            << output << std::endl;
+  return 0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const std::string command = argc > 1 ? argv[1] : "";
+  if (command == "keygen" && argc == 4) {
+    return Keygen(argv[2], argv[3]);
+  }
+  if (command == "sign" && argc == 5) {
+    return Sign(argv[2], argv[3], argv[4]);
+  }
+  if (command == "sign-binaries" && argc >= 5) {
+    return SignBinaries(argv[2], argv[3],
+                        std::vector<std::string>(argv + 4, argv + argc));
+  }
+  std::cerr << "Usage: " << argv[0] << " keygen <private.pem> <header>\n"
+            << "       " << argv[0]
+            << " sign <private.pem> <output> <bundle dir>\n"
+            << "       " << argv[0]
+            << " sign-binaries <private.pem> <output> <file>..." << std::endl;
+  return 2;
+}
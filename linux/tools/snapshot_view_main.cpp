@@ -0,0 +1,253 @@
+// Generates the Dart view over the binary security snapshot record.
+//
+// Usage: ultra_secure_flutter_kit_snapshot_view <output.dart>
+//
+// Run through the ultra_secure_flutter_kit_generate_snapshot_view target
+// whenever snapshot_record.h or the snapshot checks in check_registry.h
+// change, and commit the result.
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "../snapshot_record.h"
+
+namespace {
+
+using ultra_secure_flutter_kit::RecordField;
+using ultra_secure_flutter_kit::RecordFieldRole;
+using ultra_secure_flutter_kit::RecordFieldType;
+
+const char* ByteDataGetter(RecordFieldType type) {
+  switch (type) {
+    case RecordFieldType::kUint8:
+      return "getUint8";
+    case RecordFieldType::kUint16:
+      return "getUint16";
+    case RecordFieldType::kUint32:
+      return "getUint32";
+    case RecordFieldType::kUint64:
+      return "getUint64";
+    case RecordFieldType::kInt64:
+      return "getInt64";
+  }
+  return "";
+}
+
+std::string Read(const RecordField& field) {
+  std::ostringstream read;
+  read << "_data." << ByteDataGetter(field.type) << "(" << field.offset;
+  if (field.type != RecordFieldType::kUint8) {
+    read << ", Endian.little";
+  }
+  read << ")";
+  return read.str();
+}
+
+std::string NamesConstant(const RecordField& field) {
+  return std::string(field.name) + "Names";
+}
+
+void WriteStringList(std::ostream& out, const std::string& name,
+                     const std::string_view* names, size_t count) {
+  out << "  static const List<String> " << name << " = [\n";
+  for (size_t i = 0; i < count; ++i) {
+    out << "    '" << names[i] << "',\n";
+  }
+  out << "  ];\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  namespace usfk = ultra_secure_flutter_kit;
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <output.dart>" << std::endl;
+    return 2;
+  }
+
+  // Every getter shares the class namespace with every other.
+  std::set<std::string> getters = {"bytes", "check", "failedChecks", "toMap"};
+  const auto claim = [&getters](std::string_view name) {
+    if (!getters.insert(std::string(name)).second) {
+      std::cerr << "Snapshot view: duplicate getter " << name << std::endl;
+      return false;
+    }
+    return true;
+  };
+
+  std::ostringstream out;
+  out << "// GENERATED CODE - DO NOT MODIFY BY HAND.\n"
+         "// Generated by linux/tools/snapshot_view_main.cpp from\n"
+         "// linux/snapshot_record.h and src/check_registry.h.\n"
+         "\n"
+         "import 'dart:typed_data';\n"
+         "\n"
+         "/// Read-only view over the binary security snapshot record, format\n"
+         "/// version "
+      << usfk::kSnapshotRecordVersion
+      << ".\n"
+         "///\n"
+         "/// Nothing is decoded up front; each getter reads its field from "
+         "[bytes]\n"
+         "/// when called. [bytes] can be stored or forwarded unchanged.\n"
+         "class SecuritySnapshotView {\n"
+         "  /// Wraps [bytes]; throws a [FormatException] unless they hold a "
+         "record\n"
+         "  /// of [formatVersion].\n"
+         "  SecuritySnapshotView(this.bytes) : _data = "
+         "ByteData.sublistView(bytes) {\n"
+         "    if (bytes.lengthInBytes < recordSize || magic != recordMagic) {\n"
+         "      throw const FormatException('Not a security snapshot "
+         "record');\n"
+         "    }\n"
+         "    if (version != formatVersion ||\n"
+         "        size < recordSize ||\n"
+         "        size > bytes.lengthInBytes) {\n"
+         "      throw FormatException(\n"
+         "        'Unsupported security snapshot record (version $version, "
+         "size $size)',\n"
+         "      );\n"
+         "    }\n"
+         "  }\n"
+         "\n"
+         "  static const int recordMagic = 0x"
+      << std::hex << std::uppercase << usfk::kSnapshotRecordMagic << std::dec
+      << ";\n"
+         "  static const int formatVersion = "
+      << usfk::kSnapshotRecordVersion
+      << ";\n"
+         "  static const int recordSize = "
+      << usfk::kSnapshotRecordSize
+      << ";\n"
+         "\n"
+         "  /// Bit of each check in [checkBits], [presentBits] and "
+         "[failedBits].\n"
+         "  static const Map<String, int> checkIndex = {\n";
+  for (const auto& method : usfk::kMethods) {
+    if (method.IsSnapshotCheck()) {
+      out << "    '" << method.name << "': " << static_cast<int>(method.id)
+          << ",\n";
+    }
+  }
+  out << "  };\n";
+
+  for (const auto& field : usfk::kSnapshotRecordFields) {
+    if (field.role == RecordFieldRole::kEnum) {
+      out << "\n";
+      WriteStringList(out, NamesConstant(field), field.names,
+                      field.name_count);
+    }
+  }
+
+  out << "\n"
+         "  final Uint8List bytes;\n"
+         "  final ByteData _data;\n";
+
+  for (const auto& field : usfk::kSnapshotRecordFields) {
+    out << "\n";
+    switch (field.role) {
+      case RecordFieldRole::kNumber:
+      case RecordFieldRole::kCheckBits:
+        if (!claim(field.name)) {
+          return 1;
+        }
+        out << "  int get " << field.name << " => " << Read(field) << ";\n";
+        break;
+      case RecordFieldRole::kEnum: {
+        if (!claim(field.name)) {
+          return 1;
+        }
+        const std::string getter =
+            "  String get " + std::string(field.name) + " =>";
+        const std::string value =
+            "_name(" + NamesConstant(field) + ", " + Read(field) + ");";
+        // Wrapped the way dart format does.
+        if (getter.size() + 1 + value.size() <= 80) {
+          out << getter << " " << value << "\n";
+        } else {
+          out << getter << "\n      " << value << "\n";
+        }
+        break;
+      }
+      case RecordFieldRole::kFlags:
+        if (!claim(field.name)) {
+          return 1;
+        }
+        out << "  int get " << field.name << " => " << Read(field) << ";\n";
+        for (size_t bit = 0; bit < field.name_count; ++bit) {
+          if (!claim(field.names[bit])) {
+            return 1;
+          }
+          out << "  bool get " << field.names[bit] << " => (" << field.name
+              << " & 0x" << std::hex << (1u << bit) << std::dec
+              << ") != 0;\n";
+        }
+        break;
+    }
+  }
+
+  out << "\n";
+  for (const auto& method : usfk::kMethods) {
+    if (!method.IsSnapshotCheck()) {
+      continue;
+    }
+    if (!claim(method.name)) {
+      return 1;
+    }
+    out << "  /// The `" << method.name
+        << "` result, or null if that check did not run.\n"
+        << "  bool? get " << method.name << " => _check("
+        << static_cast<int>(method.id) << ");\n";
+  }
+
+  out << "\n"
+         "  /// The result of the check named [name], or null if it did not "
+         "run.\n"
+         "  bool? check(String name) {\n"
+         "    final index = checkIndex[name];\n"
+         "    return index == null ? null : _check(index);\n"
+         "  }\n"
+         "\n"
+         "  /// Checks that threw instead of answering.\n"
+         "  List<String> get failedChecks => [\n"
+         "    for (final entry in checkIndex.entries)\n"
+         "      if ((failedBits & (1 << entry.value)) != 0) entry.key,\n"
+         "  ];\n"
+         "\n"
+         "  /// The snapshot in the shape getSecuritySnapshot() returns.\n"
+         "  Map<String, dynamic> toMap() {\n"
+         "    final map = <String, dynamic>{};\n"
+         "    for (final entry in checkIndex.entries) {\n"
+         "      final value = _check(entry.value);\n"
+         "      if (value != null) map[entry.key] = value;\n"
+         "    }\n"
+         "    map['failedChecks'] = failedChecks;\n"
+         "    map['platform'] = platform;\n"
+         "    map['timestamp'] = timestamp;\n"
+         "    map['durationMicros'] = durationMicros;\n"
+         "    map['queueDepth'] = queueDepth;\n"
+         "    return map;\n"
+         "  }\n"
+         "\n"
+         "  bool? _check(int index) {\n"
+         "    final bit = 1 << index;\n"
+         "    if ((presentBits & bit) == 0) return null;\n"
+         "    return (checkBits & bit) != 0;\n"
+         "  }\n"
+         "\n"
+         "  static String _name(List<String> names, int code) =>\n"
+         "      code < names.length ? names[code] : 'unknown';\n"
+         "}\n";
+
+  std::ofstream file(argv[1], std::ios::binary | std::ios::trunc);
+  file << out.str();
+  if (!file.flush()) {
+    std::cerr << "Snapshot view: cannot write " << argv[1] << std::endl;
+    return 1;
+  }
+  std::cout << "Snapshot view: " << argv[1] << std::endl;
+  return 0;
+}
@@ -2,15 +2,20 @@
 // // #include <flutter/standard_method_codec.h>
 // #include <flutter/method_channel.h>
 // #include <flutter/method_result_functions.h>
+// #include <flutter/event_channel.h>
+// #include <flutter/event_stream_handler_functions.h>
 
-// #include <iostream>
+// #include <algorithm>
+// #include <functional>
 // #include <memory>
+// #include <optional>
 // #include <string>
 // #include <vector>
 // #include <map>
 // #include <filesystem>
 // #include <fstream>
 // #include <sstream>
+// #include <stdexcept>
 // #include <cstdlib>
 // #include <unistd.h>
 // #include <sys/stat.h>
@@ -22,6 +27,33 @@
 // #include <openssl/pem.h>
 // #include <curl/curl.h>
 
+// #include "aead_cipher.h"
+// #include "app_integrity.h"
+// #include "asset_integrity.h"
+// #include "asset_manifest_key.h"
+// #include "check_registry.h"
+// #include "data_key.h"
+// #include "debug_watchdog.h"
+// #include "emulator_detector.h"
+// #include "fingerprint_cache.h"
+// #include "logger.h"
+// #include "method_stats.h"
+// #include "monitoring_engine.h"
+// #include "native_checks.h"
+// #include "network_interfaces.h"
+// #include "parallel_for.h"
+// #include "proc_reader.h"
+// #include "process_monitor.h"
+// #include "secure_memory.h"
+// #include "secure_store.h"
+// #include "security_snapshot.h"
+// #include "snapshot_record.h"
+// #include "ssl_pinning.h"
+// #include "system_checks.h"
+// #include "text_scanner.h"
+// #include "usb_device_table.h"
+// #include "work_pool.h"
+
 // namespace {
 
 // class UltraSecureFlutterKitLinux : public flutter::Plugin {
@@ -38,254 +70,425 @@
 //           plugin_pointer->HandleMethodCall(call, std::move(result));
 //         });
 
+//     auto event_channel = std::make_unique<flutter::EventChannel<flutter::EncodableValue>>(
+//         registrar->messenger(), "ultra_secure_flutter_kit/events",
+//         &flutter::StandardMethodCodec::GetInstance());
+
+//     event_channel->SetStreamHandler(
+//         std::make_unique<flutter::StreamHandlerFunctions<flutter::EncodableValue>>(
+//             [plugin_pointer = plugin.get()](const auto* arguments, auto&& events)
+//                 -> std::unique_ptr<flutter::StreamHandlerError<flutter::EncodableValue>> {
+//               plugin_pointer->event_sink_ = std::move(events);
+//               return nullptr;
+//             },
+//             [plugin_pointer = plugin.get()](const auto* arguments)
+//                 -> std::unique_ptr<flutter::StreamHandlerError<flutter::EncodableValue>> {
+//               plugin_pointer->event_sink_.reset();
+//               return nullptr;
+//             }));
+//     plugin->event_channel_ = std::move(event_channel);
+
 //     registrar->AddPlugin(std::move(plugin));
 //   }
 
-//   UltraSecureFlutterKitLinux() {}
+//   UltraSecureFlutterKitLinux() {
+//     // Map and lock the secure slabs now rather than on the first pin or
+//     // fingerprint.
+//     ultra_secure_flutter_kit::SecureArena::Instance();
+//   }
 
-//   virtual ~UltraSecureFlutterKitLinux() {}
+//   virtual ~UltraSecureFlutterKitLinux() {
+//     // The watchdog outlives the plugin and its callback points back here.
+//     ultra_secure_flutter_kit::DebugWatchdog::Instance().Stop();
+//   }
 
 //  private:
-//   std::vector<std::string> pinned_certificates_;
-//   std::vector<std::string> pinned_public_keys_;
+//   ultra_secure_flutter_kit::SslPinVerifier ssl_pin_verifier_;
+//   std::unique_ptr<flutter::EventChannel<flutter::EncodableValue>> event_channel_;
+//   std::unique_ptr<flutter::EventSink<flutter::EncodableValue>> event_sink_;
+//   std::unique_ptr<ultra_secure_flutter_kit::MonitoringEngine> monitoring_engine_;
+//   // Last hasVPNConnection sent on the event channel.
+//   std::optional<bool> reported_has_vpn_;
+//   std::unique_ptr<ultra_secure_flutter_kit::TextScanner> text_scanner_;
+//   // Shared with the C API (native_api.h).
+//   ultra_secure_flutter_kit::UsbDeviceTable& usb_devices_ =
+//       ultra_secure_flutter_kit::UsbDeviceTable::Instance();
+//   ultra_secure_flutter_kit::NetworkInterfaceTable& network_interfaces_ =
+//       ultra_secure_flutter_kit::NetworkInterfaceTable::Instance();
+//   ultra_secure_flutter_kit::ProcessMonitor process_monitor_;
+//   // Open beginEncrypt/beginDecrypt streams; the key is loaded on the first.
+//   ultra_secure_flutter_kit::CipherStreamTable cipher_streams_{
+//       &ultra_secure_flutter_kit::DataKey};
+//   // Opened on the first secure storage call.
+//   ultra_secure_flutter_kit::SecureStore secure_store_{
+//       &ultra_secure_flutter_kit::DataKey};
+//   // Started by anti-tampering or the first verifyAssets call.
+//   ultra_secure_flutter_kit::AssetVerifier asset_verifier_{
+//       [this](const ultra_secure_flutter_kit::AssetEvent& event) {
+//         RunOnMainThread([this, event] { DispatchAssetEvent(event); });
+//       }};
+//   // Last, so its workers are joined before anything they use is destroyed.
+//   ultra_secure_flutter_kit::MethodScheduler method_scheduler_{
+//       std::min<size_t>(4, ultra_secure_flutter_kit::HardwareWorkers()), 64};
 
 //   void HandleMethodCall(
 //       const flutter::MethodCall<flutter::EncodableValue>& method_call,
 //       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-    
-//     const std::string& method_name = method_call.method_name();
-
-//     if (method_name.compare("getPlatformVersion") == 0) {
-//       result->Success(flutter::EncodableValue("Linux " + GetLinuxVersion()));
-//     } else if (method_name.compare("isRooted") == 0) {
-//       result->Success(flutter::EncodableValue(IsRooted()));
-//     } else if (method_name.compare("isJailbroken") == 0) {
-//       result->Success(flutter::EncodableValue(IsJailbroken()));
-//     } else if (method_name.compare("isEmulator") == 0) {
-//       result->Success(flutter::EncodableValue(IsEmulator()));
-//     } else if (method_name.compare("isDebuggerAttached") == 0) {
-//       result->Success(flutter::EncodableValue(IsDebuggerAttached()));
-//     } else if (method_name.compare("enableScreenCaptureProtection") == 0) {
-//       EnableScreenCaptureProtection();
-//       result->Success();
-//     } else if (method_name.compare("disableScreenCaptureProtection") == 0) {
-//       DisableScreenCaptureProtection();
-//       result->Success();
-//     } else if (method_name.compare("isScreenCaptureBlocked") == 0) {
-//       result->Success(flutter::EncodableValue(IsScreenCaptureBlocked()));
-//     } else if (method_name.compare("isUsbCableAttached") == 0) {
-//       result->Success(flutter::EncodableValue(IsUsbCableAttached()));
-//     } else if (method_name.compare("getUsbConnectionStatus") == 0) {
-//       result->Success(GetUsbConnectionStatus());
-//     } else if (method_name.compare("getAppSignature") == 0) {
-//       result->Success(flutter::EncodableValue(GetAppSignature()));
-//     } else if (method_name.compare("verifyAppIntegrity") == 0) {
-//       result->Success(flutter::EncodableValue(VerifyAppIntegrity()));
-//     } else if (method_name.compare("getDeviceFingerprint") == 0) {
-//       result->Success(flutter::EncodableValue(GetDeviceFingerprint()));
-//     } else if (method_name.compare("enableSecureFlag") == 0) {
-//       EnableSecureFlag();
-//       result->Success();
-//     } else if (method_name.compare("enableNetworkMonitoring") == 0) {
-//       EnableNetworkMonitoring();
-//       result->Success();
-//     } else if (method_name.compare("enableRealTimeMonitoring") == 0) {
-//       EnableRealTimeMonitoring();
-//       result->Success();
-//     } else if (method_name.compare("preventReverseEngineering") == 0) {
-//       PreventReverseEngineering();
-//       result->Success();
-//     } else if (method_name.compare("applyAntiTampering") == 0) {
-//       ApplyAntiTampering();
-//       result->Success();
-//     } else if (method_name.compare("hasProxySettings") == 0) {
-//       result->Success(flutter::EncodableValue(HasProxySettings()));
-//     } else if (method_name.compare("hasVPNConnection") == 0) {
-//       result->Success(flutter::EncodableValue(HasVPNConnection()));
-//     } else if (method_name.compare("getUnexpectedCertificates") == 0) {
-//       result->Success(flutter::EncodableValue(GetUnexpectedCertificates()));
-//     } else if (method_name.compare("isDeveloperModeEnabled") == 0) {
-//       result->Success(flutter::EncodableValue(IsDeveloperModeEnabled()));
-//     } else if (method_name.compare("openDeveloperOptionsSettings") == 0) {
-//       OpenDeveloperOptionsSettings();
-//       result->Success();
-//     } else if (method_name.compare("configureSSLPinning") == 0) {
-//       const auto* arguments = std::get_if<flutter::EncodableMap>(method_call.arguments());
-//       if (arguments) {
-//         auto certificates_it = arguments->find(flutter::EncodableValue("certificates"));
-//         auto public_keys_it = arguments->find(flutter::EncodableValue("publicKeys"));
-        
-//         std::vector<std::string> certificates;
-//         std::vector<std::string> public_keys;
-        
-//         if (certificates_it != arguments->end()) {
-//           const auto* cert_list = std::get_if<flutter::EncodableList>(&certificates_it->second);
-//           if (cert_list) {
-//             for (const auto& cert : *cert_list) {
-//               if (const auto* cert_str = std::get_if<std::string>(&cert)) {
-//                 certificates.push_back(*cert_str);
-//               }
+//     const auto* method = ultra_secure_flutter_kit::FindMethod(method_call.method_name());
+//     if (method == nullptr) {
+//       result->NotImplemented();
+//       return;
+//     }
+//
+//     // Cheap calls are answered in place; anything that touches the
+//     // filesystem, spawns a process or goes to the network runs on the pool
+//     // and replies from the GTK main loop, so a slow /sys or home directory
+//     // never stalls a frame.
+//     if (method->cost == ultra_secure_flutter_kit::CostClass::kTrivial) {
+//       result->Success(Invoke(*method, method_call.arguments()));
+//       return;
+//     }
+//
+//     std::shared_ptr<flutter::MethodResult<flutter::EncodableValue>> reply(std::move(result));
+//     auto arguments = std::make_shared<flutter::EncodableValue>(
+//         method_call.arguments() ? *method_call.arguments() : flutter::EncodableValue());
+//     const bool scheduled = method_scheduler_.Schedule(method->id, [this, method, reply, arguments] {
+//       std::function<void()> complete;
+//       try {
+//         auto value = std::make_shared<flutter::EncodableValue>(Invoke(*method, arguments.get()));
+//         complete = [reply, value] { reply->Success(*value); };
+//       } catch (const std::exception& e) {
+//         std::string message = e.what();
+//         complete = [reply, message] { reply->Error("native_error", message); };
+//       }
+//       RunOnMainThread(std::move(complete));
+//     });
+//     if (!scheduled) {
+//       reply->Error("busy", "Too many pending native security calls");
+//     }
+//   }
+
+//   // Runs one method and returns its reply (null for methods without one).
+//   // Called on the platform thread for trivial methods and on a pool worker
+//   // otherwise. Its run time, not counting time queued, goes into the
+//   // method's latency histogram.
+//   flutter::EncodableValue Invoke(const ultra_secure_flutter_kit::MethodInfo& method,
+//                                  const flutter::EncodableValue* arguments_value) {
+//     using ultra_secure_flutter_kit::Method;
+//     ultra_secure_flutter_kit::MethodTimer timer(method.id);
+//
+//     if (method.IsSnapshotCheck()) {
+//       return flutter::EncodableValue(RunCheck(method.id));
+//     }
+//
+//     const auto* arguments = arguments_value
+//         ? std::get_if<flutter::EncodableMap>(arguments_value)
+//         : nullptr;
+//     switch (method.id) {
+//       case Method::kGetPlatformVersion:
+//         return flutter::EncodableValue("Linux " + GetLinuxVersion());
+//       case Method::kGetEmulatorDetails:
+//         return flutter::EncodableValue(GetEmulatorDetails());
+//       case Method::kEnableScreenCaptureProtection:
+//         EnableScreenCaptureProtection();
+//         return flutter::EncodableValue();
+//       case Method::kDisableScreenCaptureProtection:
+//         DisableScreenCaptureProtection();
+//         return flutter::EncodableValue();
+//       case Method::kGetUsbConnectionStatus:
+//         return flutter::EncodableValue(GetUsbConnectionStatus());
+//       case Method::kListUsbDevices:
+//         return flutter::EncodableValue(ListUsbDevices());
+//       case Method::kGetAppSignature:
+//         return flutter::EncodableValue(GetAppSignature());
+//       case Method::kGetDeviceFingerprint:
+//         return flutter::EncodableValue(GetDeviceFingerprint());
+//       case Method::kRefreshFingerprint: {
+//         bool force = false;
+//         if (arguments) {
+//           auto force_it = arguments->find(flutter::EncodableValue("force"));
+//           if (force_it != arguments->end()) {
+//             if (const auto* value = std::get_if<bool>(&force_it->second)) {
+//               force = *value;
+//             }
+//           }
+//         }
+//         return flutter::EncodableValue(RefreshFingerprint(force));
+//       }
+//       case Method::kEnableSecureFlag:
+//         EnableSecureFlag();
+//         return flutter::EncodableValue();
+//       case Method::kEnableNetworkMonitoring:
+//         EnableNetworkMonitoring();
+//         return flutter::EncodableValue();
+//       case Method::kEnableRealTimeMonitoring:
+//         EnableRealTimeMonitoring();
+//         return flutter::EncodableValue();
+//       case Method::kPreventReverseEngineering: {
+//         // Optional {"denyDebuggerAttach": bool} also makes the process
+//         // non-dumpable, refusing ptrace attach from non-root debuggers.
+//         ultra_secure_flutter_kit::DebugWatchdogOptions options;
+//         if (arguments) {
+//           auto deny = arguments->find(flutter::EncodableValue("denyDebuggerAttach"));
+//           if (deny != arguments->end() && std::holds_alternative<bool>(deny->second)) {
+//             options.deny_attach = std::get<bool>(deny->second);
+//           }
+//         }
+//         PreventReverseEngineering(options);
+//         return flutter::EncodableValue();
+//       }
+//       case Method::kApplyAntiTampering: {
+//         // Optional {"cpuBudgetPercent": double, "tickMillis": int} tunes the
+//         // background code scanner.
+//         ultra_secure_flutter_kit::TextScannerOptions options;
+//         if (arguments) {
+//           auto budget = arguments->find(flutter::EncodableValue("cpuBudgetPercent"));
+//           if (budget != arguments->end() && std::holds_alternative<double>(budget->second)) {
+//             options.cpu_fraction = std::get<double>(budget->second) / 100.0;
+//           }
+//           auto tick = arguments->find(flutter::EncodableValue("tickMillis"));
+//           if (tick != arguments->end() && std::holds_alternative<int32_t>(tick->second)) {
+//             options.tick = std::chrono::milliseconds(std::get<int32_t>(tick->second));
+//           }
+//         }
+//         ApplyAntiTampering(options);
+//         return flutter::EncodableValue();
+//       }
+//       case Method::kGetUnexpectedCertificates:
+//         return flutter::EncodableValue(GetUnexpectedCertificates());
+//       case Method::kOpenDeveloperOptionsSettings:
+//         OpenDeveloperOptionsSettings();
+//         return flutter::EncodableValue();
+//       case Method::kGetSecuritySnapshot: {
+//         // {"format": "binary"} answers with the fixed-layout record.
+//         if (arguments) {
+//           auto format = arguments->find(flutter::EncodableValue("format"));
+//           if (format != arguments->end()) {
+//             const auto* value = std::get_if<std::string>(&format->second);
+//             if (value && *value == "binary") {
+//               return flutter::EncodableValue(GetSecuritySnapshotRecord());
 //             }
 //           }
 //         }
-        
-//         if (public_keys_it != arguments->end()) {
-//           const auto* key_list = std::get_if<flutter::EncodableList>(&public_keys_it->second);
-//           if (key_list) {
-//             for (const auto& key : *key_list) {
-//               if (const auto* key_str = std::get_if<std::string>(&key)) {
-//                 public_keys.push_back(*key_str);
-//               }
+//         return flutter::EncodableValue(GetSecuritySnapshot());
+//       }
+//       case Method::kGetPerformanceStats:
+//         return flutter::EncodableValue(GetPerformanceStats());
+//       case Method::kGetNetworkInterfaces:
+//         return flutter::EncodableValue(GetNetworkInterfaces());
+//       case Method::kGetRunningAnalysisTools:
+//         return flutter::EncodableValue(GetRunningAnalysisTools());
+//       case Method::kSetProcessSignatures: {
+//         // {"signatures": ["gdb", "frida*", ...]}; empty restores the defaults
+//         auto signatures = arguments ? StringList(*arguments, "signatures")
+//                                     : std::vector<std::string>();
+//         process_monitor_.SetSignatures(
+//             signatures.empty() ? ultra_secure_flutter_kit::DefaultProcessSignatures()
+//                                : std::move(signatures));
+//         return flutter::EncodableValue();
+//       }
+//       case Method::kConfigureSSLPinning:
+//         if (arguments) {
+//           ConfigureSSLPinning(StringList(*arguments, "certificates"),
+//                               StringList(*arguments, "publicKeys"));
+//         }
+//         return flutter::EncodableValue();
+//       case Method::kVerifySSLPinning: {
+//         const std::string* url = nullptr;
+//         if (arguments) {
+//           auto url_it = arguments->find(flutter::EncodableValue("url"));
+//           if (url_it != arguments->end()) {
+//             url = std::get_if<std::string>(&url_it->second);
+//           }
+//         }
+//         return flutter::EncodableValue(url != nullptr && VerifySSLPinning(*url));
+//       }
+//       case Method::kSetLogLevel: {
+//         // {"level": "debug" | "info" | "warning" | "error" | "off"}
+//         if (arguments) {
+//           auto level_it = arguments->find(flutter::EncodableValue("level"));
+//           if (level_it != arguments->end()) {
+//             if (const auto* name = std::get_if<std::string>(&level_it->second)) {
+//               SetLogLevel(*name);
 //             }
 //           }
 //         }
-        
-//         ConfigureSSLPinning(certificates, public_keys);
+//         return flutter::EncodableValue();
+//       }
+//       case Method::kEncrypt: {
+//         // {"data": Uint8List}; the reply is a Uint8List in the format
+//         // described in aead_cipher.h.
+//         const auto& data = Bytes(arguments, "data");
+//         return flutter::EncodableValue(ultra_secure_flutter_kit::EncryptMessage(
+//             ultra_secure_flutter_kit::DataKey(), data.data(), data.size()));
 //       }
-//       result->Success();
-//     } else if (method_name.compare("verifySSLPinning") == 0) {
-//       const auto* arguments = std::get_if<flutter::EncodableMap>(method_call.arguments());
-//       if (arguments) {
-//         auto url_it = arguments->find(flutter::EncodableValue("url"));
-//         if (url_it != arguments->end()) {
-//           const auto* url = std::get_if<std::string>(&url_it->second);
-//           if (url) {
-//             result->Success(flutter::EncodableValue(VerifySSLPinning(*url)));
-//           } else {
-//             result->Success(flutter::EncodableValue(false));
+//       case Method::kDecrypt: {
+//         const auto& data = Bytes(arguments, "data");
+//         return flutter::EncodableValue(ultra_secure_flutter_kit::DecryptMessage(
+//             ultra_secure_flutter_kit::DataKey(), data.data(), data.size()));
+//       }
+//       case Method::kBeginEncrypt:
+//         return flutter::EncodableValue(cipher_streams_.Begin(true));
+//       case Method::kBeginDecrypt:
+//         return flutter::EncodableValue(cipher_streams_.Begin(false));
+//       case Method::kCipherUpdate: {
+//         // {"handle": int, "data": Uint8List}
+//         const auto& data = Bytes(arguments, "data");
+//         return flutter::EncodableValue(
+//             cipher_streams_.Update(Handle(arguments), data.data(), data.size()));
+//       }
+//       case Method::kCipherFinish:
+//         return flutter::EncodableValue(cipher_streams_.Finish(Handle(arguments)));
+//       case Method::kSecureStore: {
+//         // {"key": String, "value": String, "expiresInMillis": int?}
+//         int64_t expires_at_ms = 0;
+//         if (arguments) {
+//           auto expires = arguments->find(flutter::EncodableValue("expiresInMillis"));
+//           if (expires != arguments->end() && !expires->second.IsNull()) {
+//             expires_at_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+//                 std::chrono::system_clock::now().time_since_epoch()).count();
+//             if (const auto* small = std::get_if<int32_t>(&expires->second)) {
+//               expires_at_ms += *small;
+//             } else if (const auto* large = std::get_if<int64_t>(&expires->second)) {
+//               expires_at_ms += *large;
+//             }
 //           }
-//         } else {
-//           result->Success(flutter::EncodableValue(false));
 //         }
-//       } else {
-//         result->Success(flutter::EncodableValue(false));
+//         secure_store_.Put(Text(arguments, "key"), Text(arguments, "value"), expires_at_ms);
+//         return flutter::EncodableValue();
 //       }
-//     } else {
-//       result->NotImplemented();
-//     }
-//   }
-
-//   // Platform-specific methods
-//   std::string GetLinuxVersion() {
-//     std::ifstream file("/etc/os-release");
-//     std::string line;
-//     std::string version = "Unknown";
-    
-//     if (file.is_open()) {
-//       while (std::getline(file, line)) {
-//         if (line.find("PRETTY_NAME=") == 0) {
-//           version = line.substr(12);
-//           if (version.front() == '"') version = version.substr(1);
-//           if (version.back() == '"') version = version.substr(0, version.length() - 1);
-//           break;
+//       case Method::kSecureRetrieve: {
+//         ultra_secure_flutter_kit::SecureString value;
+//         if (!secure_store_.Get(Text(arguments, "key"), &value)) {
+//           return flutter::EncodableValue();
 //         }
+//         return flutter::EncodableValue(std::string(value.data(), value.size()));
 //       }
-//       file.close();
+//       case Method::kSecureDelete:
+//         return flutter::EncodableValue(secure_store_.Delete(Text(arguments, "key")));
+//       case Method::kClearAllSecureData:
+//         secure_store_.Clear();
+//         return flutter::EncodableValue();
+//       case Method::kVerifyAssets: {
+//         // {"wait": bool?}; without it the reply is the progress so far.
+//         bool wait = false;
+//         if (arguments) {
+//           auto wait_it = arguments->find(flutter::EncodableValue("wait"));
+//           if (wait_it != arguments->end()) {
+//             if (const auto* value = std::get_if<bool>(&wait_it->second)) {
+//               wait = *value;
+//             }
+//           }
+//         }
+//         return flutter::EncodableValue(VerifyAssets(wait));
+//       }
+//       default:
+//         return flutter::EncodableValue();
 //     }
-    
-//     return version;
 //   }
 
-//   bool IsRooted() {
-//     // Check for root access on Linux
-//     std::vector<std::string> root_paths = {
-//       "/usr/bin/sudo",
-//       "/usr/bin/su",
-//       "/usr/local/bin/brew"
-//     };
+//   // Hands `task` to the GTK main loop; method results and event sinks may
+//   // only be used from there.
+//   static void RunOnMainThread(std::function<void()> task) {
+//     g_main_context_invoke(nullptr, [](gpointer data) -> gboolean {
+//       std::unique_ptr<std::function<void()>> task(static_cast<std::function<void()>*>(data));
+//       (*task)();
+//       return G_SOURCE_REMOVE;
+//     }, new std::function<void()>(std::move(task)));
+//   }
 
-//     for (const auto& path : root_paths) {
-//       if (std::filesystem::exists(path)) {
-//         std::cout << "Security: Root access detected via: " << path << std::endl;
-//         return true;
-//       }
-//     }
+//   // Answers the argument-free yes/no checks, i.e. the methods for which
+//   // MethodInfo::IsSnapshotCheck() holds. The checks live in
+//   // native_checks.cpp so the C API answers them the same way.
+//   bool RunCheck(ultra_secure_flutter_kit::Method id) {
+//     return ultra_secure_flutter_kit::RunCheck(id);
+//   }
 
-//     // Check if running as root
-//     if (getuid() == 0) {
-//       std::cout << "Security: Running as root user" << std::endl;
-//       return true;
+//   static std::vector<std::string> StringList(const flutter::EncodableMap& arguments,
+//                                              const char* key) {
+//     std::vector<std::string> values;
+//     auto it = arguments.find(flutter::EncodableValue(key));
+//     if (it == arguments.end()) {
+//       return values;
 //     }
-
-//     return false;
+//     if (const auto* list = std::get_if<flutter::EncodableList>(&it->second)) {
+//       for (const auto& value : *list) {
+//         if (const auto* text = std::get_if<std::string>(&value)) {
+//           values.push_back(*text);
+//         }
+//       }
+//     }
+//     return values;
 //   }
 
-//   bool IsJailbroken() {
-//     // Linux doesn't have jailbreak concept, but we can check for security bypasses
-//     std::vector<std::string> suspicious_paths = {
-//       "/tmp/cydia",
-//       "/var/lib/dpkg",
-//       "/etc/apt"
-//     };
-
-//     for (const auto& path : suspicious_paths) {
-//       if (std::filesystem::exists(path)) {
-//         std::cout << "Security: Suspicious modification detected: " << path << std::endl;
-//         return true;
+//   // Argument accessors for the cipher and storage methods, which cannot do
+//   // anything sensible with a missing argument. The throw becomes a
+//   // native_error.
+//   static const std::vector<uint8_t>& Bytes(const flutter::EncodableMap* arguments,
+//                                            const char* key) {
+//     if (arguments) {
+//       auto it = arguments->find(flutter::EncodableValue(key));
+//       if (it != arguments->end()) {
+//         if (const auto* bytes = std::get_if<std::vector<uint8_t>>(&it->second)) {
+//           return *bytes;
+//         }
 //       }
 //     }
-
-//     return false;
+//     throw std::invalid_argument(std::string("expected a Uint8List '") + key + "'");
 //   }
-
-//   bool IsEmulator() {
-//     // Check if running in a virtual machine
-//     std::vector<std::string> vm_indicators = {
-//       "VMware",
-//       "VirtualBox",
-//       "QEMU",
-//       "Xen",
-//       "KVM"
-//     };
-
-//     std::ifstream file("/proc/cpuinfo");
-//     std::string line;
-    
-//     if (file.is_open()) {
-//       while (std::getline(file, line)) {
-//         for (const auto& indicator : vm_indicators) {
-//           if (line.find(indicator) != std::string::npos) {
-//             std::cout << "Security: Virtual machine detected: " << indicator << std::endl;
-//             return true;
-//           }
+//
+//   static const std::string& Text(const flutter::EncodableMap* arguments,
+//                                  const char* key) {
+//     if (arguments) {
+//       auto it = arguments->find(flutter::EncodableValue(key));
+//       if (it != arguments->end()) {
+//         if (const auto* text = std::get_if<std::string>(&it->second)) {
+//           return *text;
 //         }
 //       }
-//       file.close();
 //     }
-
-//     return false;
+//     throw std::invalid_argument(std::string("expected a String '") + key + "'");
 //   }
-
-//   bool IsDebuggerAttached() {
-//     // Check if debugger is attached
-//     std::ifstream file("/proc/self/status");
-//     std::string line;
-    
-//     if (file.is_open()) {
-//       while (std::getline(file, line)) {
-//         if (line.find("TracerPid:") == 0) {
-//           std::string pid_str = line.substr(11);
-//           int tracer_pid = std::stoi(pid_str);
-//           if (tracer_pid != 0) {
-//             std::cout << "Security: Debugger attached (PID: " << tracer_pid << ")" << std::endl;
-//             return true;
-//           }
-//           break;
+//
+//   static int64_t Handle(const flutter::EncodableMap* arguments) {
+//     if (arguments) {
+//       auto it = arguments->find(flutter::EncodableValue("handle"));
+//       if (it != arguments->end()) {
+//         // The codec sends small Dart ints as int32.
+//         if (const auto* small = std::get_if<int32_t>(&it->second)) {
+//           return *small;
+//         }
+//         if (const auto* large = std::get_if<int64_t>(&it->second)) {
+//           return *large;
 //         }
 //       }
-//       file.close();
 //     }
+//     throw std::invalid_argument("expected an int 'handle'");
+//   }
+
+//   // Platform-specific methods
+//   std::string GetLinuxVersion() {
+//     return ultra_secure_flutter_kit::FingerprintCache::Instance().Get().linux_version;
+//   }
 
-//     return false;
+//   flutter::EncodableMap GetEmulatorDetails() {
+//     auto detection = ultra_secure_flutter_kit::DetectEmulator();
+//     flutter::EncodableMap details;
+//     details[flutter::EncodableValue("isEmulator")] = flutter::EncodableValue(detection.detected);
+//     details[flutter::EncodableValue("confidence")] = flutter::EncodableValue(detection.confidence);
+//     details[flutter::EncodableValue("source")] =
+//         flutter::EncodableValue(ultra_secure_flutter_kit::EmulatorSourceName(detection.source));
+//     details[flutter::EncodableValue("vendor")] = flutter::EncodableValue(detection.vendor);
+//     return details;
 //   }
 
 //   void EnableScreenCaptureProtection() {
 //     // Linux doesn't support native screen capture blocking
 //     // But we can implement some protection measures
-//     std::cout << "Security: Screen capture protection requested (Linux)" << std::endl;
+//     USFK_LOG(kInfo) << "Security: Screen capture protection requested (Linux)";
     
 //     // Set a flag to indicate protection is enabled
-//     std::ofstream file("/tmp/screenshot_blocking_enabled");
+//     std::ofstream file(ultra_secure_flutter_kit::kScreenCaptureFlagPath);
 //     if (file.is_open()) {
 //       file << "1";
 //       file.close();
@@ -293,296 +496,557 @@
 //   }
 
 //   void DisableScreenCaptureProtection() {
-//     std::remove("/tmp/screenshot_blocking_enabled");
-//     std::cout << "Security: Screen capture protection disabled" << std::endl;
-//   }
-
-//   bool IsScreenCaptureBlocked() {
-//     return std::filesystem::exists("/tmp/screenshot_blocking_enabled");
-//   }
-
-//   bool IsUsbCableAttached() {
-//     // Check for USB devices on Linux
-//     std::vector<std::string> usb_paths = {
-//       "/proc/bus/usb",
-//       "/sys/bus/usb",
-//       "/dev/bus/usb"
-//     };
-
-//     for (const auto& path : usb_paths) {
-//       if (std::filesystem::exists(path)) {
-//         std::cout << "Security: USB system detected at: " << path << std::endl;
-//         return true;
-//       }
-//     }
-
-//     // Check for USB devices in /sys/bus/usb/devices
-//     std::string usb_devices_path = "/sys/bus/usb/devices";
-//     if (std::filesystem::exists(usb_devices_path)) {
-//       for (const auto& entry : std::filesystem::directory_iterator(usb_devices_path)) {
-//         if (entry.is_directory()) {
-//           std::string device_path = entry.path().string();
-//           // Skip the "usb" directory itself
-//           if (device_path.find("/usb") == std::string::npos) {
-//             std::cout << "Security: USB device detected: " << device_path << std::endl;
-//             return true;
-//           }
-//         }
-//       }
-//     }
-
-//     std::cout << "Security: No USB devices detected" << std::endl;
-//     return false;
+//     std::remove(ultra_secure_flutter_kit::kScreenCaptureFlagPath);
+//     USFK_LOG(kInfo) << "Security: Screen capture protection disabled";
 //   }
 
 //   flutter::EncodableMap GetUsbConnectionStatus() {
 //     flutter::EncodableMap status;
-    
-//     bool isAttached = IsUsbCableAttached();
+//
+//     const int64_t deviceCount = static_cast<int64_t>(usb_devices_.Count());
+//     const bool isAttached = deviceCount > 0;
 //     status[flutter::EncodableValue("isAttached")] = flutter::EncodableValue(isAttached);
-    
+//
 //     std::string connectionType = isAttached ? "data_transfer" : "none";
 //     status[flutter::EncodableValue("connectionType")] = flutter::EncodableValue(connectionType);
-    
+//
 //     status[flutter::EncodableValue("isCharging")] = flutter::EncodableValue(false); // Linux can't detect charging
 //     status[flutter::EncodableValue("isDataTransfer")] = flutter::EncodableValue(isAttached);
 //     status[flutter::EncodableValue("isUsbCharging")] = flutter::EncodableValue(false);
 //     status[flutter::EncodableValue("isConnectedToComputer")] = flutter::EncodableValue(false);
 //     status[flutter::EncodableValue("isConnectedViaUsb")] = flutter::EncodableValue(isAttached);
-    
-//     // Count USB devices
-//     int deviceCount = 0;
-//     std::string usb_devices_path = "/sys/bus/usb/devices";
-//     if (std::filesystem::exists(usb_devices_path)) {
-//       for (const auto& entry : std::filesystem::directory_iterator(usb_devices_path)) {
-//         if (entry.is_directory()) {
-//           std::string device_path = entry.path().string();
-//           if (device_path.find("/usb") == std::string::npos) {
-//             deviceCount++;
-//           }
-//         }
-//       }
-//     }
-    
 //     status[flutter::EncodableValue("deviceCount")] = flutter::EncodableValue(deviceCount);
 //     status[flutter::EncodableValue("powerSource")] = flutter::EncodableValue("unknown");
 //     status[flutter::EncodableValue("platform")] = flutter::EncodableValue("linux");
 //     status[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(static_cast<int64_t>(time(nullptr) * 1000));
-    
-//     std::cout << "Security: USB connection status - Attached: " << isAttached 
-//               << ", Devices: " << deviceCount << std::endl;
-    
+//
 //     return status;
 //   }
 
-//   std::string GetAppSignature() {
-//     // Generate a Linux-specific app signature
-//     std::string signature_data = GetLinuxVersion() + GetDeviceFingerprint();
-    
-//     // Create SHA-256 hash
-//     unsigned char hash[SHA256_DIGEST_LENGTH];
-//     SHA256_CTX sha256;
-//     SHA256_Init(&sha256);
-//     SHA256_Update(&sha256, signature_data.c_str(), signature_data.length());
-//     SHA256_Final(hash, &sha256);
-    
-//     // Convert to base64
-//     std::string result;
-//     for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-//       result += "0123456789ABCDEF"[hash[i] / 16];
-//       result += "0123456789ABCDEF"[hash[i] % 16];
+//   flutter::EncodableList ListUsbDevices() {
+//     flutter::EncodableList devices;
+//     for (const auto& device : usb_devices_.List()) {
+//       flutter::EncodableMap map;
+//       map[flutter::EncodableValue("name")] = flutter::EncodableValue(device.name);
+//       map[flutter::EncodableValue("vendorId")] = flutter::EncodableValue(device.vendor_id);
+//       map[flutter::EncodableValue("productId")] = flutter::EncodableValue(device.product_id);
+//       map[flutter::EncodableValue("deviceClass")] = flutter::EncodableValue(device.device_class);
+//       map[flutter::EncodableValue("manufacturer")] = flutter::EncodableValue(device.manufacturer);
+//       map[flutter::EncodableValue("product")] = flutter::EncodableValue(device.product);
+//       devices.emplace_back(std::move(map));
 //     }
-    
-//     return result;
+//     return devices;
 //   }
 
-//   bool VerifyAppIntegrity() {
-//     // Check if the app has been modified
-//     // This is a simplified implementation
-//     std::cout << "Security: App integrity verification requested" << std::endl;
-//     return true;
+//   std::string GetAppSignature() {
+//     // Linux-specific app signature, derived once per boot from the OS
+//     // version and device fingerprint
+//     // The channel copies it out of the secure arena regardless.
+//     const auto& signature = ultra_secure_flutter_kit::FingerprintCache::Instance().Get().app_signature;
+//     return std::string(signature.data(), signature.size());
 //   }
 
 //   std::string GetDeviceFingerprint() {
-//     std::string fingerprint;
-    
-//     // Get hostname
-//     char hostname[256];
-//     if (gethostname(hostname, sizeof(hostname)) == 0) {
-//       fingerprint += hostname;
-//     }
-//     fingerprint += "|";
-    
-//     // Get machine ID
-//     std::ifstream file("/etc/machine-id");
-//     if (file.is_open()) {
-//       std::string machine_id;
-//       std::getline(file, machine_id);
-//       fingerprint += machine_id;
-//       file.close();
-//     }
-//     fingerprint += "|";
-    
-//     // Get CPU info
-//     std::ifstream cpu_file("/proc/cpuinfo");
-//     if (cpu_file.is_open()) {
-//       std::string line;
-//       while (std::getline(cpu_file, line)) {
-//         if (line.find("processor") == 0) {
-//           fingerprint += line + "|";
-//           break;
-//         }
-//       }
-//       cpu_file.close();
-//     }
-    
-//     // Create hash
-//     unsigned char hash[SHA256_DIGEST_LENGTH];
-//     SHA256_CTX sha256;
-//     SHA256_Init(&sha256);
-//     SHA256_Update(&sha256, fingerprint.c_str(), fingerprint.length());
-//     SHA256_Final(hash, &sha256);
-    
-//     std::string result;
-//     for (int i = 0; i < SHA256_DIGEST_LENGTH; i++) {
-//       result += "0123456789ABCDEF"[hash[i] / 16];
-//       result += "0123456789ABCDEF"[hash[i] % 16];
-//     }
-    
-//     return result;
+//     // hostname|machine-id|first processor line, hashed with SHA-256
+//     const auto& fingerprint = ultra_secure_flutter_kit::FingerprintCache::Instance().Get().device_fingerprint;
+//     return std::string(fingerprint.data(), fingerprint.size());
+//   }
+
+//   bool RefreshFingerprint(bool force) {
+//     bool changed = ultra_secure_flutter_kit::FingerprintCache::Instance().Refresh(force);
+//     USFK_LOG(kInfo) << "Security: Device fingerprint refreshed (changed: " << changed << ")";
+//     return changed;
 //   }
 
 //   void EnableSecureFlag() {
-//     std::cout << "Security: Secure flag requested (Linux)" << std::endl;
+//     USFK_LOG(kInfo) << "Security: Secure flag requested (Linux)";
 //   }
 
 //   void EnableNetworkMonitoring() {
-//     std::cout << "Security: Network monitoring enabled (Linux)" << std::endl;
+//     StartMonitoring(true, false);
+//     USFK_LOG(kInfo) << "Security: Network monitoring enabled (Linux)";
 //   }
 
 //   void EnableRealTimeMonitoring() {
-//     std::cout << "Security: Real-time monitoring enabled (Linux)" << std::endl;
+//     StartMonitoring(true, true);
+//     USFK_LOG(kInfo) << "Security: Real-time monitoring enabled (Linux)";
 //   }
 
-//   void PreventReverseEngineering() {
-//     // Check for common reverse engineering tools
-//     std::vector<std::string> suspicious_paths = {
-//       "/usr/bin/gdb",
-//       "/usr/bin/lldb",
-//       "/usr/bin/objdump",
-//       "/usr/bin/strings",
-//       "/usr/bin/nm",
-//       "/usr/bin/strace",
-//       "/usr/bin/ltrace"
-//     };
+//   void StartMonitoring(bool watch_network, bool watch_usb) {
+//     if (!monitoring_engine_) {
+//       monitoring_engine_ = std::make_unique<ultra_secure_flutter_kit::MonitoringEngine>(
+//           [this](const ultra_secure_flutter_kit::MonitoringEvent& event) {
+//             // Called on the engine thread; the sink must be used from the
+//             // GTK main loop.
+//             RunOnMainThread([this, event] { DispatchMonitoringEvent(event); });
+//           });
+//     }
+//
+//     if (!monitoring_engine_->Start(watch_network, watch_usb)) {
+//       USFK_LOG(kWarning) << "Security: Netlink monitoring unavailable, Dart polling remains active";
+//     }
+//   }
 
-//     for (const auto& path : suspicious_paths) {
-//       if (std::filesystem::exists(path)) {
-//         std::cout << "Security: Reverse engineering tool detected: " << path << std::endl;
+//   void DispatchMonitoringEvent(const ultra_secure_flutter_kit::MonitoringEvent& event) {
+//     if (!event_sink_) {
+//       return;
+//     }
+//
+//     flutter::EncodableMap map;
+//     map[flutter::EncodableValue("type")] =
+//         flutter::EncodableValue(ultra_secure_flutter_kit::MonitoringEventTypeName(event.type));
+//     map[flutter::EncodableValue("name")] = flutter::EncodableValue(event.name);
+//     map[flutter::EncodableValue("isUp")] = flutter::EncodableValue(event.is_up);
+//     map[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(event.timestamp_ms);
+//
+//     // Re-evaluate only the check affected by this source.
+//     if (event.type == ultra_secure_flutter_kit::MonitoringEventType::kUsbDeviceAdded ||
+//         event.type == ultra_secure_flutter_kit::MonitoringEventType::kUsbDeviceRemoved) {
+//       map[flutter::EncodableValue("isUsbCableAttached")] = flutter::EncodableValue(
+//           RunCheck(ultra_secure_flutter_kit::Method::kIsUsbCableAttached));
+//     } else {
+//       // Most link and address changes leave the classification as it
+//       // was; only a change is sent.
+//       const bool has_vpn = RunCheck(ultra_secure_flutter_kit::Method::kHasVPNConnection);
+//       if (reported_has_vpn_ != has_vpn) {
+//         reported_has_vpn_ = has_vpn;
+//         map[flutter::EncodableValue("hasVPNConnection")] = flutter::EncodableValue(has_vpn);
 //       }
 //     }
+//
+//     event_sink_->Success(flutter::EncodableValue(map));
+//   }
+
+//   void PreventReverseEngineering(const ultra_secure_flutter_kit::DebugWatchdogOptions& options) {
+//     // Check for common reverse engineering tools
+//     for (const char* path : ultra_secure_flutter_kit::FindReverseEngineeringTools()) {
+//       USFK_LOG(kWarning) << "Security: Reverse engineering tool detected: " << path;
+//     }
+//
+//     // Installed is one thing, running is another; keep the process table
+//     // current from here on.
+//     process_monitor_.Start();
+//     for (const auto& process : process_monitor_.Matches()) {
+//       USFK_LOG(kWarning) << "Security: Reverse engineering tool running: " << process.name
+//                          << " (PID: " << process.pid << ")";
+//     }
+//     if (auto tracer = process_monitor_.Tracer()) {
+//       USFK_LOG(kWarning) << "Security: Process traced by " << tracer->name
+//                          << " (PID: " << tracer->pid << ")";
+//     }
+//
+//     // From here on debugger checks answer from the watchdog, and attaches
+//     // reported by the proc connector wake it at once.
+//     auto& watchdog = ultra_secure_flutter_kit::DebugWatchdog::Instance();
+//     process_monitor_.SetPtraceListener([&watchdog](pid_t) { watchdog.Wake(); });
+//     watchdog.Start(options, [this](const ultra_secure_flutter_kit::DebugEvent& event) {
+//       RunOnMainThread([this, event] { DispatchDebugEvent(event); });
+//     });
 
-//     std::cout << "Security: Anti-reverse engineering measures applied" << std::endl;
+//     USFK_LOG(kInfo) << "Security: Anti-reverse engineering measures applied";
 //   }
 
-//   void ApplyAntiTampering() {
-//     // Check for app modification
-//     if (!VerifyAppIntegrity()) {
-//       std::cout << "Security: App tampering detected" << std::endl;
+//   void DispatchDebugEvent(const ultra_secure_flutter_kit::DebugEvent& event) {
+//     using ultra_secure_flutter_kit::DebugSignal;
+//     const char* type = "debuggerAttached";
+//     switch (event.signal) {
+//       case DebugSignal::kTracerPid:
+//         type = event.attached ? "debuggerAttached" : "debuggerDetached";
+//         break;
+//       case DebugSignal::kAttachProbe:
+//         type = "debuggerAttached";
+//         break;
+//       case DebugSignal::kDumpableReset:
+//         type = "dumpableReset";
+//         break;
+//       case DebugSignal::kStall:
+//         type = "executionStalled";
+//         break;
+//     }
+//     USFK_LOG(kWarning) << "Security: " << type << " ("
+//                        << ultra_secure_flutter_kit::DebugSignalName(event.signal)
+//                        << ", tracer PID: " << event.tracer_pid
+//                        << ", stalled: " << event.stall_ms << " ms)";
+//     if (!event_sink_) {
+//       return;
 //     }
+//
+//     flutter::EncodableMap map;
+//     map[flutter::EncodableValue("type")] = flutter::EncodableValue(type);
+//     map[flutter::EncodableValue("name")] =
+//         flutter::EncodableValue(ultra_secure_flutter_kit::DebugSignalName(event.signal));
+//     map[flutter::EncodableValue("tracerPid")] =
+//         flutter::EncodableValue(static_cast<int32_t>(event.tracer_pid));
+//     map[flutter::EncodableValue("stallMillis")] = flutter::EncodableValue(event.stall_ms);
+//     map[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(event.timestamp_ms);
+//     event_sink_->Success(flutter::EncodableValue(map));
+//   }
 
-//     std::cout << "Security: Anti-tampering measures applied" << std::endl;
+//   flutter::EncodableMap GetRunningAnalysisTools() {
+//     process_monitor_.Start();
+//     auto to_map = [](const ultra_secure_flutter_kit::ProcessInfo& process) {
+//       flutter::EncodableMap map;
+//       map[flutter::EncodableValue("pid")] = flutter::EncodableValue(static_cast<int32_t>(process.pid));
+//       map[flutter::EncodableValue("name")] = flutter::EncodableValue(process.name);
+//       map[flutter::EncodableValue("exe")] = flutter::EncodableValue(process.exe);
+//       map[flutter::EncodableValue("signature")] = flutter::EncodableValue(process.signature);
+//       return map;
+//     };
+//
+//     flutter::EncodableList processes;
+//     for (const auto& process : process_monitor_.Matches()) {
+//       processes.emplace_back(to_map(process));
+//     }
+//     auto tracer = process_monitor_.Tracer();
+//
+//     flutter::EncodableMap report;
+//     report[flutter::EncodableValue("processes")] = flutter::EncodableValue(std::move(processes));
+//     report[flutter::EncodableValue("tracer")] =
+//         tracer ? flutter::EncodableValue(to_map(*tracer)) : flutter::EncodableValue();
+//     report[flutter::EncodableValue("eventDriven")] =
+//         flutter::EncodableValue(process_monitor_.IsEventDriven());
+//     return report;
 //   }
 
-//   bool HasProxySettings() {
-//     // Check for proxy environment variables
-//     const char* proxy_vars[] = {"http_proxy", "https_proxy", "HTTP_PROXY", "HTTPS_PROXY"};
-    
-//     for (const auto& var : proxy_vars) {
-//       const char* value = std::getenv(var);
-//       if (value && strlen(value) > 0) {
-//         std::cout << "Security: Proxy detected: " << var << "=" << value << std::endl;
-//         return true;
-//       }
+//   void ApplyAntiTampering(ultra_secure_flutter_kit::TextScannerOptions options) {
+//     // Check for app modification
+//     if (!RunCheck(ultra_secure_flutter_kit::Method::kVerifyAppIntegrity)) {
+//       USFK_LOG(kError) << "Security: App tampering detected";
+//     }
+//     // The assets are hashed in the background, the ones in use first.
+//     StartAssetVerifier();
+
+//     // Keep watching the loaded code for runtime patches (inline hooks,
+//     // software breakpoints) after the on-disk check.
+//     if (!text_scanner_) {
+//       text_scanner_ = std::make_unique<ultra_secure_flutter_kit::TextScanner>(
+//           [this](const ultra_secure_flutter_kit::CodeTamperEvent& event) {
+//             RunOnMainThread([this, event] { DispatchCodeTamperEvent(event); });
+//           });
+//     }
+//     char executable[4096];
+//     const ssize_t length = readlink("/proc/self/exe", executable, sizeof(executable) - 1);
+//     if (length > 0) {
+//       const std::string path(executable, static_cast<size_t>(length));
+//       options.modules.push_back(path.substr(path.rfind('/') + 1));
+//     }
+//     options.modules.push_back("libapp.so");
+//     options.modules.push_back("libflutter_linux_gtk.so");
+//     options.modules.push_back("libultra_secure_flutter_kit_plugin.so");
+//     if (!text_scanner_->Start(options)) {
+//       USFK_LOG(kWarning) << "Security: No code mappings found to scan";
 //     }
 
-//     return false;
+//     USFK_LOG(kInfo) << "Security: Anti-tampering measures applied";
 //   }
 
-//   bool HasVPNConnection() {
-//     // Check for VPN interfaces
-//     std::vector<std::string> vpn_interfaces = {
-//       "tun0", "tun1", "tun2", "tun3",
-//       "tap0", "tap1", "tap2", "tap3"
-//     };
+//   void StartAssetVerifier() {
+//     ultra_secure_flutter_kit::AssetVerifierOptions options;
+//     options.public_key = ultra_secure_flutter_kit::kAssetManifestPublicKey;
+//     if (!asset_verifier_.Start(options)) {
+//       USFK_LOG(kInfo) << "Security: No valid asset manifest, assets not verified";
+//     }
+//   }
+//
+//   flutter::EncodableMap VerifyAssets(bool wait) {
+//     StartAssetVerifier();
+//     const auto report = asset_verifier_.Verify(wait);
+//     flutter::EncodableList mismatched;
+//     for (const auto& name : report.mismatched) {
+//       mismatched.emplace_back(name);
+//     }
+//     flutter::EncodableList missing;
+//     for (const auto& name : report.missing) {
+//       missing.emplace_back(name);
+//     }
+//
+//     flutter::EncodableMap result;
+//     result[flutter::EncodableValue("manifestFound")] = flutter::EncodableValue(report.manifest_found);
+//     result[flutter::EncodableValue("signatureValid")] = flutter::EncodableValue(report.signature_valid);
+//     result[flutter::EncodableValue("complete")] = flutter::EncodableValue(report.complete);
+//     result[flutter::EncodableValue("verified")] = flutter::EncodableValue(report.verified);
+//     result[flutter::EncodableValue("filesTotal")] =
+//         flutter::EncodableValue(static_cast<int64_t>(report.files_total));
+//     result[flutter::EncodableValue("filesVerified")] =
+//         flutter::EncodableValue(static_cast<int64_t>(report.files_verified));
+//     result[flutter::EncodableValue("mismatched")] = flutter::EncodableValue(std::move(mismatched));
+//     result[flutter::EncodableValue("missing")] = flutter::EncodableValue(std::move(missing));
+//     result[flutter::EncodableValue("filesHashed")] =
+//         flutter::EncodableValue(static_cast<int64_t>(report.files_hashed));
+//     result[flutter::EncodableValue("bytesHashed")] =
+//         flutter::EncodableValue(static_cast<int64_t>(report.bytes_hashed));
+//     return result;
+//   }
+//
+//   void DispatchAssetEvent(const ultra_secure_flutter_kit::AssetEvent& event) {
+//     USFK_LOG(kError) << "Security: Asset "
+//                      << ultra_secure_flutter_kit::AssetStatusName(event.status) << ": "
+//                      << event.name;
+//     if (!event_sink_) {
+//       return;
+//     }
+//
+//     flutter::EncodableMap map;
+//     map[flutter::EncodableValue("type")] = flutter::EncodableValue("assetTampered");
+//     map[flutter::EncodableValue("name")] = flutter::EncodableValue(event.name);
+//     map[flutter::EncodableValue("status")] =
+//         flutter::EncodableValue(ultra_secure_flutter_kit::AssetStatusName(event.status));
+//     map[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(
+//         static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+//             std::chrono::system_clock::now().time_since_epoch()).count()));
+//     event_sink_->Success(flutter::EncodableValue(map));
+//   }
 
-//     for (const auto& interface : vpn_interfaces) {
-//       std::string path = "/sys/class/net/" + interface;
-//       if (std::filesystem::exists(path)) {
-//         std::cout << "Security: VPN interface detected: " << interface << std::endl;
-//         return true;
-//       }
+//   void DispatchCodeTamperEvent(const ultra_secure_flutter_kit::CodeTamperEvent& event) {
+//     USFK_LOG(kError) << "Security: Code modified in memory: " << event.module
+//                      << " +0x" << ultra_secure_flutter_kit::Hex{event.offset};
+//     if (!event_sink_) {
+//       return;
 //     }
+//
+//     flutter::EncodableMap map;
+//     map[flutter::EncodableValue("type")] = flutter::EncodableValue("codeTampered");
+//     map[flutter::EncodableValue("name")] = flutter::EncodableValue(event.module);
+//     map[flutter::EncodableValue("offset")] =
+//         flutter::EncodableValue(static_cast<int64_t>(event.offset));
+//     map[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(
+//         static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+//             std::chrono::system_clock::now().time_since_epoch()).count()));
+//     event_sink_->Success(flutter::EncodableValue(map));
+//   }
 
-//     return false;
+//   flutter::EncodableMap GetNetworkInterfaces() {
+//     auto network = network_interfaces_.Get();
+//     flutter::EncodableList interfaces;
+//     for (const auto& link : network->interfaces) {
+//       flutter::EncodableMap map;
+//       map[flutter::EncodableValue("index")] = flutter::EncodableValue(link.index);
+//       map[flutter::EncodableValue("name")] = flutter::EncodableValue(link.name);
+//       map[flutter::EncodableValue("kind")] = flutter::EncodableValue(link.kind);
+//       map[flutter::EncodableValue("type")] =
+//           flutter::EncodableValue(ultra_secure_flutter_kit::InterfaceClassName(link.type));
+//       map[flutter::EncodableValue("hardwareType")] =
+//           flutter::EncodableValue(static_cast<int32_t>(link.hardware_type));
+//       map[flutter::EncodableValue("isUp")] = flutter::EncodableValue(link.is_up);
+//       map[flutter::EncodableValue("isTunnel")] = flutter::EncodableValue(link.IsTunnel());
+//       interfaces.emplace_back(std::move(map));
+//     }
+//     flutter::EncodableList default_route_interfaces;
+//     for (const auto& name : network->default_route_interfaces) {
+//       default_route_interfaces.emplace_back(name);
+//     }
+//
+//     flutter::EncodableMap result;
+//     result[flutter::EncodableValue("interfaces")] = flutter::EncodableValue(std::move(interfaces));
+//     result[flutter::EncodableValue("defaultRouteInterfaces")] =
+//         flutter::EncodableValue(std::move(default_route_interfaces));
+//     result[flutter::EncodableValue("defaultRouteViaTunnel")] =
+//         flutter::EncodableValue(network->default_route_via_tunnel);
+//     result[flutter::EncodableValue("hasVPN")] = flutter::EncodableValue(network->has_vpn);
+//     result[flutter::EncodableValue("vpnInterface")] = flutter::EncodableValue(network->vpn_interface);
+//     return result;
 //   }
 
 //   std::vector<std::string> GetUnexpectedCertificates() {
 //     std::vector<std::string> unexpected_certs;
-//     std::cout << "Security: Certificate validation requested" << std::endl;
+//     USFK_LOG(kInfo) << "Security: Certificate validation requested";
 //     return unexpected_certs;
 //   }
 
-//   bool IsDeveloperModeEnabled() {
-//     // Check if developer mode is enabled on Linux
-//     std::vector<std::string> developer_paths = {
-//       "/usr/bin/gcc",
-//       "/usr/bin/make",
-//       "/usr/bin/git",
-//       "/usr/bin/vim",
-//       "/usr/bin/emacs"
-//     };
+//   void OpenDeveloperOptionsSettings() {
+//     // Open system settings on Linux
+//     USFK_LOG(kInfo) << "Security: Opening system settings";
+//     system("xdg-open /usr/share/applications/");
+//   }
 
-//     for (const auto& path : developer_paths) {
-//       if (std::filesystem::exists(path)) {
-//         std::cout << "Security: Developer tools detected: " << path << std::endl;
-//         return true;
+//   // Runs the boolean checks concurrently, so a monitoring tick costs a
+//   // single channel round trip. `ids` receives the method of each result.
+//   ultra_secure_flutter_kit::SecuritySnapshot RunSnapshotChecks(
+//       std::vector<ultra_secure_flutter_kit::Method>* ids) {
+//     std::vector<ultra_secure_flutter_kit::SecurityCheck> checks;
+//     for (const auto& method : ultra_secure_flutter_kit::kMethods) {
+//       if (method.IsSnapshotCheck()) {
+//         ids->push_back(method.id);
+//         checks.push_back({std::string(method.name),
+//                           [this, id = method.id] {
+//                             ultra_secure_flutter_kit::MethodTimer timer(id);
+//                             return RunCheck(id);
+//                           }});
 //       }
 //     }
+//     return ultra_secure_flutter_kit::RunSecuritySnapshot(checks);
+//   }
 
-//     return false;
+//   flutter::EncodableMap GetSecuritySnapshot() {
+//     std::vector<ultra_secure_flutter_kit::Method> ids;
+//     auto snapshot = RunSnapshotChecks(&ids);
+//
+//     flutter::EncodableMap map;
+//     flutter::EncodableList failed;
+//     for (const auto& check : snapshot.results) {
+//       map[flutter::EncodableValue(check.name)] = flutter::EncodableValue(check.value);
+//       if (check.failed) {
+//         failed.push_back(flutter::EncodableValue(check.name));
+//       }
+//     }
+//     map[flutter::EncodableValue("failedChecks")] = flutter::EncodableValue(failed);
+//     map[flutter::EncodableValue("platform")] = flutter::EncodableValue("linux");
+//     map[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(snapshot.timestamp_ms);
+//     map[flutter::EncodableValue("durationMicros")] = flutter::EncodableValue(snapshot.duration_us);
+//     const auto scheduler = method_scheduler_.GetStats();
+//     map[flutter::EncodableValue("queueDepth")] = flutter::EncodableValue(
+//         static_cast<int64_t>(scheduler.queue_depth + scheduler.waiting));
+//
+//     USFK_LOG(kDebug) << "Security: Snapshot of " << ids.size() << " checks took "
+//                      << snapshot.duration_us << "us";
+//
+//     return map;
 //   }
 
-//   void OpenDeveloperOptionsSettings() {
-//     // Open system settings on Linux
-//     std::cout << "Security: Opening system settings" << std::endl;
-//     system("xdg-open /usr/share/applications/");
+//   // The same snapshot, plus the USB status, as one little-endian record
+//   // that Dart reads through the generated SecuritySnapshotView.
+//   std::vector<uint8_t> GetSecuritySnapshotRecord() {
+//     std::vector<ultra_secure_flutter_kit::Method> ids;
+//     auto snapshot = RunSnapshotChecks(&ids);
+//
+//     ultra_secure_flutter_kit::SnapshotRecord record;
+//     for (size_t i = 0; i < ids.size(); ++i) {
+//       record.SetCheck(ids[i], snapshot.results[i].value, snapshot.results[i].failed);
+//     }
+//     record.timestamp_ms = snapshot.timestamp_ms;
+//     record.duration_us = snapshot.duration_us;
+//     const auto scheduler = method_scheduler_.GetStats();
+//     record.queue_depth = static_cast<uint32_t>(scheduler.queue_depth + scheduler.waiting);
+//     record.platform = ultra_secure_flutter_kit::RecordPlatform::kLinux;
+//
+//     record.usb_device_count = static_cast<uint32_t>(usb_devices_.Count());
+//     if (record.usb_device_count > 0) {
+//       record.usb_connection_type = ultra_secure_flutter_kit::UsbConnectionType::kDataTransfer;
+//       record.usb_flags = ultra_secure_flutter_kit::kUsbFlagDataTransfer |
+//                          ultra_secure_flutter_kit::kUsbFlagConnectedViaUsb;
+//     }
+//
+//     return ultra_secure_flutter_kit::EncodeSnapshotRecord(record);
+//   }
+
+//   flutter::EncodableMap GetPerformanceStats() {
+//     flutter::EncodableMap methods;
+//     for (const auto& latency : ultra_secure_flutter_kit::MethodStats::Instance().Collect()) {
+//       const auto micros = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+//       flutter::EncodableMap entry;
+//       entry[flutter::EncodableValue("count")] = flutter::EncodableValue(static_cast<int64_t>(latency.count));
+//       entry[flutter::EncodableValue("errors")] = flutter::EncodableValue(static_cast<int64_t>(latency.errors));
+//       entry[flutter::EncodableValue("meanMicros")] = flutter::EncodableValue(micros(latency.mean_ns));
+//       entry[flutter::EncodableValue("p50Micros")] = flutter::EncodableValue(micros(latency.p50_ns));
+//       entry[flutter::EncodableValue("p90Micros")] = flutter::EncodableValue(micros(latency.p90_ns));
+//       entry[flutter::EncodableValue("p99Micros")] = flutter::EncodableValue(micros(latency.p99_ns));
+//       entry[flutter::EncodableValue("maxMicros")] = flutter::EncodableValue(micros(latency.max_ns));
+//       methods[flutter::EncodableValue(std::string(
+//           ultra_secure_flutter_kit::GetMethodInfo(latency.id).name))] = flutter::EncodableValue(entry);
+//     }
+//
+//     const auto scheduler = method_scheduler_.GetStats();
+//     flutter::EncodableMap pool;
+//     pool[flutter::EncodableValue("queueDepth")] = flutter::EncodableValue(static_cast<int64_t>(scheduler.queue_depth));
+//     pool[flutter::EncodableValue("waiting")] = flutter::EncodableValue(static_cast<int64_t>(scheduler.waiting));
+//     pool[flutter::EncodableValue("running")] = flutter::EncodableValue(static_cast<int64_t>(scheduler.running));
+//     pool[flutter::EncodableValue("rejected")] = flutter::EncodableValue(static_cast<int64_t>(scheduler.rejected));
+//     pool[flutter::EncodableValue("steals")] = flutter::EncodableValue(static_cast<int64_t>(scheduler.steals));
+//
+//     flutter::EncodableMap stats;
+//     stats[flutter::EncodableValue("methods")] = flutter::EncodableValue(methods);
+//     stats[flutter::EncodableValue("scheduler")] = flutter::EncodableValue(pool);
+//     const auto arena = ultra_secure_flutter_kit::SecureArena::Instance().GetStats();
+//     flutter::EncodableMap arena_map;
+//     arena_map[flutter::EncodableValue("capacity")] = flutter::EncodableValue(static_cast<int64_t>(arena.capacity));
+//     arena_map[flutter::EncodableValue("inUse")] = flutter::EncodableValue(static_cast<int64_t>(arena.in_use));
+//     arena_map[flutter::EncodableValue("peak")] = flutter::EncodableValue(static_cast<int64_t>(arena.peak));
+//     arena_map[flutter::EncodableValue("fallbackAllocations")] =
+//         flutter::EncodableValue(static_cast<int64_t>(arena.fallback_allocations));
+//     arena_map[flutter::EncodableValue("locked")] = flutter::EncodableValue(arena.locked);
+//     stats[flutter::EncodableValue("secureArena")] = flutter::EncodableValue(arena_map);
+//     const auto& watchdog = ultra_secure_flutter_kit::DebugWatchdog::Instance();
+//     if (watchdog.IsRunning()) {
+//       const auto debug = watchdog.GetStats();
+//       flutter::EncodableMap debug_map;
+//       debug_map[flutter::EncodableValue("ticks")] = flutter::EncodableValue(static_cast<int64_t>(debug.ticks));
+//       debug_map[flutter::EncodableValue("probes")] = flutter::EncodableValue(static_cast<int64_t>(debug.probes));
+//       debug_map[flutter::EncodableValue("intervalMillis")] = flutter::EncodableValue(debug.interval_ms);
+//       debug_map[flutter::EncodableValue("cpuMicros")] = flutter::EncodableValue(debug.cpu_us);
+//       stats[flutter::EncodableValue("debugWatchdog")] = flutter::EncodableValue(debug_map);
+//     }
+//     flutter::EncodableMap cipher_map;
+//     cipher_map[flutter::EncodableValue("algorithm")] = flutter::EncodableValue(
+//         ultra_secure_flutter_kit::AeadAlgorithmName(ultra_secure_flutter_kit::PreferredAeadAlgorithm()));
+//     cipher_map[flutter::EncodableValue("openStreams")] =
+//         flutter::EncodableValue(static_cast<int64_t>(cipher_streams_.OpenStreams()));
+//     stats[flutter::EncodableValue("cipher")] = flutter::EncodableValue(cipher_map);
+//     const auto store = secure_store_.GetStats();
+//     if (store.open) {
+//       flutter::EncodableMap store_map;
+//       store_map[flutter::EncodableValue("records")] = flutter::EncodableValue(static_cast<int64_t>(store.records));
+//       store_map[flutter::EncodableValue("logBytes")] = flutter::EncodableValue(static_cast<int64_t>(store.log_bytes));
+//       store_map[flutter::EncodableValue("garbageBytes")] =
+//           flutter::EncodableValue(static_cast<int64_t>(store.garbage_bytes));
+//       store_map[flutter::EncodableValue("commits")] = flutter::EncodableValue(static_cast<int64_t>(store.commits));
+//       store_map[flutter::EncodableValue("compactions")] =
+//           flutter::EncodableValue(static_cast<int64_t>(store.compactions));
+//       store_map[flutter::EncodableValue("truncatedBytes")] =
+//           flutter::EncodableValue(static_cast<int64_t>(store.truncated_bytes));
+//       stats[flutter::EncodableValue("secureStore")] = flutter::EncodableValue(store_map);
+//     }
+//     if (asset_verifier_.IsRunning()) {
+//       const auto assets = asset_verifier_.Verify(false);
+//       flutter::EncodableMap assets_map;
+//       assets_map[flutter::EncodableValue("filesTotal")] =
+//           flutter::EncodableValue(static_cast<int64_t>(assets.files_total));
+//       assets_map[flutter::EncodableValue("filesVerified")] =
+//           flutter::EncodableValue(static_cast<int64_t>(assets.files_verified));
+//       assets_map[flutter::EncodableValue("filesHashed")] =
+//           flutter::EncodableValue(static_cast<int64_t>(assets.files_hashed));
+//       assets_map[flutter::EncodableValue("bytesHashed")] =
+//           flutter::EncodableValue(static_cast<int64_t>(assets.bytes_hashed));
+//       stats[flutter::EncodableValue("assets")] = flutter::EncodableValue(assets_map);
+//     }
+//     stats[flutter::EncodableValue("platform")] = flutter::EncodableValue("linux");
+//     stats[flutter::EncodableValue("timestamp")] = flutter::EncodableValue(static_cast<int64_t>(time(nullptr) * 1000));
+//     return stats;
 //   }
 
 //   void ConfigureSSLPinning(const std::vector<std::string>& certificates, 
 //                            const std::vector<std::string>& public_keys) {
-//     pinned_certificates_ = certificates;
-//     pinned_public_keys_ = public_keys;
+//     const size_t rejected = ssl_pin_verifier_.Configure(certificates, public_keys);
+//     if (rejected > 0) {
+//       USFK_LOG(kWarning) << "Security: Ignored " << rejected
+//                          << " malformed pins (expected sha256/<base64>)";
+//     }
     
-//     std::cout << "Security: SSL Pinning configured with " 
-//               << certificates.size() << " certificates and " 
-//               << public_keys.size() << " public keys" << std::endl;
+//     USFK_LOG(kInfo) << "Security: SSL Pinning configured with " 
+//                     << certificates.size() << " certificates and " 
+//                     << public_keys.size() << " public keys";
 //   }
 
 //   bool VerifySSLPinning(const std::string& url) {
-//     if (pinned_certificates_.empty() && pinned_public_keys_.empty()) {
+//     if (!ssl_pin_verifier_.HasPins()) {
 //       return true; // No pinning configured
 //     }
 
-//     // In Linux environment, SSL pinning is handled by the system
-//     // We can only verify that we're using HTTPS
-//     if (url.find("https://") != 0) {
-//       return false;
+//     const ultra_secure_flutter_kit::PinVerification verification =
+//         ssl_pin_verifier_.Verify(url);
+//     if (!verification.matched) {
+//       USFK_LOG(kWarning) << "Security: SSL pinning failed for " << url << ": "
+//                          << verification.error;
 //     }
+//     return verification.matched;
+//   }
 
-//     // For Linux, we rely on system's certificate validation
-//     // Additional pinning would require libcurl or other mechanisms
-//     return true;
+//   void SetLogLevel(const std::string& name) {
+//     ultra_secure_flutter_kit::LogLevel level;
+//     if (!ultra_secure_flutter_kit::ParseLogLevel(name, &level)) {
+//       USFK_LOG(kWarning) << "Security: Unknown log level: " << name;
+//       return;
+//     }
+//     ultra_secure_flutter_kit::Logger::Instance().SetLevel(level);
 //   }
 // };
 
@@ -0,0 +1,201 @@
+#include "usb_device_table.h"
+
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <set>
+#include <utility>
+
+#include "filesystem_root.h"
+#include "monitoring_engine.h"
+#include "proc_reader.h"
+
+namespace ultra_secure_flutter_kit {
+
+namespace {
+
+constexpr size_t kReceiveBufferSize = 16 * 1024;
+constexpr size_t kDirentBufferSize = 8 * 1024;
+
+// Record layout returned by getdents64(2); glibc does not export it.
+struct LinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+
+// Reads one sysfs attribute without its trailing newline.
+std::string ReadAttribute(const std::string& path) {
+  char buffer[256];
+  std::string_view value = ReadFile(path.c_str(), buffer, sizeof(buffer));
+  while (!value.empty() && (value.back() == '\n' || value.back() == ' ')) {
+    value.remove_suffix(1);
+  }
+  return std::string(value);
+}
+
+}  // namespace
+
+bool IsUsbDeviceName(const char* name) {
+  if (name[0] < '0' || name[0] > '9') {
+    return false;  // ".", "..", "usbN"
+  }
+  return strchr(name, ':') == nullptr;
+}
+
+UsbDeviceTable& UsbDeviceTable::Instance() {
+  static UsbDeviceTable* instance = new UsbDeviceTable();
+  return *instance;
+}
+
+UsbDeviceTable::UsbDeviceTable()
+    : UsbDeviceTable(RootedPath("/sys/bus/usb/devices").c_str()) {}
+
+UsbDeviceTable::UsbDeviceTable(std::string devices_dir)
+    : devices_dir_(std::move(devices_dir)) {
+  OpenUeventSocket();
+  Rescan();
+}
+
+UsbDeviceTable::~UsbDeviceTable() {
+  if (uevent_fd_ >= 0) {
+    close(uevent_fd_);
+  }
+}
+
+size_t UsbDeviceTable::Count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Sync();
+  return devices_.size();
+}
+
+std::vector<UsbDevice> UsbDeviceTable::List() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Sync();
+  std::vector<UsbDevice> devices;
+  devices.reserve(devices_.size());
+  for (auto& [name, entry] : devices_) {
+    if (!entry.loaded) {
+      Load(&entry);
+    }
+    devices.push_back(entry.device);
+  }
+  return devices;
+}
+
+void UsbDeviceTable::OpenUeventSocket() {
+  uevent_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                      NETLINK_KOBJECT_UEVENT);
+  if (uevent_fd_ < 0) {
+    return;
+  }
+  sockaddr_nl address{};
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = 1;
+  if (bind(uevent_fd_, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) < 0) {
+    close(uevent_fd_);
+    uevent_fd_ = -1;
+  }
+}
+
+void UsbDeviceTable::Sync() {
+  if (uevent_fd_ < 0 || !DrainUevents()) {
+    Rescan();
+  }
+}
+
+bool UsbDeviceTable::DrainUevents() {
+  char buffer[kReceiveBufferSize];
+  for (;;) {
+    const ssize_t length = recv(uevent_fd_, buffer, sizeof(buffer) - 1, 0);
+    if (length < 0) {
+      // ENOBUFS: the kernel dropped events while nobody was reading, so the
+      // table can no longer be trusted.
+      return errno != ENOBUFS;
+    }
+    if (length == 0) {
+      return true;
+    }
+    buffer[length] = '\0';
+    const size_t size = static_cast<size_t>(length);
+
+    if (UeventValue(buffer, size, "SUBSYSTEM") != "usb" ||
+        UeventValue(buffer, size, "DEVTYPE") != "usb_device") {
+      continue;
+    }
+    const std::string path = UeventValue(buffer, size, "DEVPATH");
+    const std::string name = path.substr(path.rfind('/') + 1);
+    if (!IsUsbDeviceName(name.c_str())) {
+      continue;
+    }
+    const std::string action = UeventValue(buffer, size, "ACTION");
+    if (action == "add") {
+      // A re-plugged device may be a different one on the same port.
+      Entry& entry = devices_[name];
+      entry = Entry();
+      entry.device.name = name;
+    } else if (action == "remove") {
+      devices_.erase(name);
+    }
+  }
+}
+
+void UsbDeviceTable::Rescan() {
+  const int fd =
+      open(devices_dir_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0) {
+    devices_.clear();
+    return;
+  }
+
+  std::set<std::string> present;
+  alignas(LinuxDirent64) char buffer[kDirentBufferSize];
+  for (;;) {
+    const long length = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      break;
+    }
+    for (long offset = 0; offset < length;) {
+      const auto* entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+      if (IsUsbDeviceName(entry->d_name)) {
+        present.emplace(entry->d_name);
+      }
+      offset += entry->d_reclen;
+    }
+  }
+  close(fd);
+
+  // Keep entries that are still present so their descriptors stay loaded.
+  for (auto it = devices_.begin(); it != devices_.end();) {
+    it = present.count(it->first) ? std::next(it) : devices_.erase(it);
+  }
+  for (const auto& name : present) {
+    auto [it, inserted] = devices_.try_emplace(name);
+    if (inserted) {
+      it->second.device.name = name;
+    }
+  }
+}
+
+void UsbDeviceTable::Load(Entry* entry) const {
+  const std::string base = devices_dir_ + "/" + entry->device.name + "/";
+  UsbDevice& device = entry->device;
+  device.vendor_id = ReadAttribute(base + "idVendor");
+  device.product_id = ReadAttribute(base + "idProduct");
+  device.device_class = ReadAttribute(base + "bDeviceClass");
+  device.manufacturer = ReadAttribute(base + "manufacturer");
+  device.product = ReadAttribute(base + "product");
+  entry->loaded = true;
+}
+
+}  // namespace ultra_secure_flutter_kit
@@ -0,0 +1,76 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_USB_DEVICE_TABLE_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_USB_DEVICE_TABLE_H_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ultra_secure_flutter_kit {
+
+struct UsbDevice {
+  std::string name;  // sysfs name, e.g. "1-1.4"
+  std::string vendor_id;
+  std::string product_id;
+  std::string device_class;
+  std::string manufacturer;
+  std::string product;
+};
+
+// In-memory table of the USB devices currently attached, excluding root
+// hubs and interfaces.
+//
+// The constructor subscribes to kernel uevents and then lists the devices
+// directory with one getdents64() pass; subscribing first means a device
+// plugged in during the listing is not missed. Every query drains pending
+// uevents without blocking (one recv() when nothing changed) and answers
+// from the table. Descriptor strings are read from sysfs the first time a
+// listing needs them. When the socket cannot be opened, or the kernel
+// dropped uevents because nobody drained it, the directory is listed again.
+class UsbDeviceTable {
+ public:
+  // The table the plugin and the C API answer from.
+  static UsbDeviceTable& Instance();
+
+  // Watches /sys/bus/usb/devices under FilesystemRoot().
+  UsbDeviceTable();
+  explicit UsbDeviceTable(std::string devices_dir);
+  ~UsbDeviceTable();
+
+  UsbDeviceTable(const UsbDeviceTable&) = delete;
+  UsbDeviceTable& operator=(const UsbDeviceTable&) = delete;
+
+  size_t Count();
+  bool HasDevices() { return Count() != 0; }
+
+  // Devices ordered by sysfs name, with their descriptor strings.
+  std::vector<UsbDevice> List();
+
+  bool IsWatching() const { return uevent_fd_ >= 0; }
+
+ private:
+  struct Entry {
+    bool loaded = false;
+    UsbDevice device;
+  };
+
+  void OpenUeventSocket();
+  void Sync();
+  bool DrainUevents();
+  void Rescan();
+  void Load(Entry* entry) const;
+
+  const std::string devices_dir_;
+  int uevent_fd_ = -1;
+  std::mutex mutex_;
+  std::map<std::string, Entry> devices_;
+};
+
+// True for the sysfs names of USB devices proper ("1-1", "3-2.4"), false
+// for root hubs ("usb1") and interfaces ("1-1:1.0").
+bool IsUsbDeviceName(const char* name);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_USB_DEVICE_TABLE_H_
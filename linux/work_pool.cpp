@@ -0,0 +1,157 @@
+#include "work_pool.h"
+
+namespace ultra_secure_flutter_kit {
+
+WorkPool::WorkPool(size_t workers, size_t max_queued)
+    : max_queued_(max_queued) {
+  if (workers == 0) {
+    workers = 1;
+  }
+  for (size_t i = 0; i < workers; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < workers; ++i) {
+    threads_.emplace_back(&WorkPool::Run, this, i);
+  }
+}
+
+WorkPool::~WorkPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+bool WorkPool::Submit(std::function<void()> task) {
+  // Reserve a slot first so the bound holds under concurrent submitters.
+  if (queued_.fetch_add(1) >= max_queued_) {
+    queued_.fetch_sub(1);
+    return false;
+  }
+  Queue& queue = *queues_[next_queue_.fetch_add(1) % queues_.size()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+  }
+  wake_.notify_one();
+  return true;
+}
+
+bool WorkPool::Take(size_t index, std::function<void()>* task) {
+  {
+    Queue& own = *queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      *task = std::move(own.tasks.front());
+      own.tasks.pop_front();
+      return true;
+    }
+  }
+  for (size_t offset = 1; offset < queues_.size(); ++offset) {
+    Queue& victim = *queues_[(index + offset) % queues_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      *task = std::move(victim.tasks.back());
+      victim.tasks.pop_back();
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkPool::Run(size_t index) {
+  for (;;) {
+    std::function<void()> task;
+    if (Take(index, &task)) {
+      queued_.fetch_sub(1);
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    // A reserved slot whose task is still being pushed also counts as
+    // queued, so this can return early and retry; it never sleeps through
+    // a submitted task.
+    wake_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+    if (stopping_ && queued_.load() == 0) {
+      return;
+    }
+  }
+}
+
+MethodScheduler::MethodScheduler(size_t workers, size_t max_queued)
+    : max_waiting_(max_queued), pool_(workers, max_queued) {}
+
+size_t MethodScheduler::ConcurrencyLimit(const MethodInfo& method) {
+  if (method.effect == Effect::kSideEffect) {
+    return 1;
+  }
+  return method.cost == CostClass::kScan ? 2 : 4;
+}
+
+bool MethodScheduler::Schedule(Method id, std::function<void()> task) {
+  const size_t index = static_cast<size_t>(id);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_[index] >= ConcurrencyLimit(GetMethodInfo(id))) {
+      if (waiting_total_ >= max_waiting_) {
+        rejected_.fetch_add(1);
+        return false;
+      }
+      waiting_[index].push_back(std::move(task));
+      ++waiting_total_;
+      return true;
+    }
+    ++running_[index];
+  }
+
+  auto chain = std::make_shared<std::function<void()>>(std::move(task));
+  if (!pool_.Submit([this, id, chain] { RunChain(id, std::move(*chain)); })) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --running_[index];
+    rejected_.fetch_add(1);
+    return false;
+  }
+  return true;
+}
+
+void MethodScheduler::RunChain(Method id, std::function<void()> task) {
+  const size_t index = static_cast<size_t>(id);
+  for (;;) {
+    task();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (waiting_[index].empty()) {
+      --running_[index];
+      return;
+    }
+    task = std::move(waiting_[index].front());
+    waiting_[index].pop_front();
+    --waiting_total_;
+  }
+}
+
+SchedulerStats MethodScheduler::GetStats() const {
+  SchedulerStats stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < kMethodCount; ++i) {
+      stats.running += running_[i];
+    }
+    stats.waiting = waiting_total_;
+  }
+  stats.queue_depth = pool_.QueueDepth();
+  stats.rejected = rejected_.load();
+  stats.steals = pool_.Steals();
+  return stats;
+}
+
+}  // namespace ultra_secure_flutter_kit
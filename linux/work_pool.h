@@ -0,0 +1,99 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_LINUX_WORK_POOL_H_
+#define ULTRA_SECURE_FLUTTER_KIT_LINUX_WORK_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "check_registry.h"
+
+namespace ultra_secure_flutter_kit {
+
+// Fixed set of worker threads, each with its own task deque. Submit()
+// spreads tasks round-robin; a worker takes from the front of its own
+// deque and, when that is empty, steals from the back of another's, so one
+// slow task (a hung NFS stat, xdg-open) never holds up the tasks queued
+// behind it while other workers are idle.
+class WorkPool {
+ public:
+  WorkPool(size_t workers, size_t max_queued);
+  ~WorkPool();
+
+  WorkPool(const WorkPool&) = delete;
+  WorkPool& operator=(const WorkPool&) = delete;
+
+  // Returns false without queuing when `max_queued` tasks are waiting.
+  bool Submit(std::function<void()> task);
+
+  size_t QueueDepth() const { return queued_.load(); }
+  uint64_t Steals() const { return steals_.load(); }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void Run(size_t index);
+  bool Take(size_t index, std::function<void()>* task);
+
+  const size_t max_queued_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::atomic<size_t> next_queue_{0};
+  std::atomic<size_t> queued_{0};
+  std::atomic<uint64_t> steals_{0};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  std::vector<std::thread> threads_;
+};
+
+struct SchedulerStats {
+  size_t queue_depth = 0;  // tasks queued in the pool
+  size_t waiting = 0;      // calls held back by a per-method limit
+  size_t running = 0;
+  uint64_t rejected = 0;
+  uint64_t steals = 0;
+};
+
+// Runs method-channel handlers on a WorkPool with a concurrency limit per
+// method taken from its registry entry: side-effecting methods run one at
+// a time, scans two at a time. Calls over the limit wait in a per-method
+// FIFO and are run by the worker that finishes the previous one, so a
+// burst of identical status calls occupies at most `limit` workers.
+class MethodScheduler {
+ public:
+  MethodScheduler(size_t workers, size_t max_queued);
+
+  // Returns false when the call had to be rejected because the pool or
+  // the method's waiting list is full.
+  bool Schedule(Method id, std::function<void()> task);
+
+  SchedulerStats GetStats() const;
+
+  static size_t ConcurrencyLimit(const MethodInfo& method);
+
+ private:
+  void RunChain(Method id, std::function<void()> task);
+
+  const size_t max_waiting_;
+  mutable std::mutex mutex_;
+  std::array<size_t, kMethodCount> running_{};
+  std::array<std::deque<std::function<void()>>, kMethodCount> waiting_;
+  size_t waiting_total_ = 0;
+  std::atomic<uint64_t> rejected_{0};
+  // Declared last so its workers are joined before the state above goes.
+  WorkPool pool_;
+};
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_LINUX_WORK_POOL_H_
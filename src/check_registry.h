@@ -0,0 +1,292 @@
+#ifndef ULTRA_SECURE_FLUTTER_KIT_SRC_CHECK_REGISTRY_H_
+#define ULTRA_SECURE_FLUTTER_KIT_SRC_CHECK_REGISTRY_H_
+
+// Method-channel methods shared by the desktop plugins.
+//
+// Every method the plugins answer is declared once in kMethods together
+// with what it costs and whether it changes state. Name lookup goes
+// through a perfect hash generated from that table at compile time: one
+// hash of the incoming name, one table load and one string comparison,
+// whatever the method's position. Each platform binds the ids to its own
+// handlers; the metadata is what batching (getSecuritySnapshot),
+// scheduling and statistics are driven by.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace ultra_secure_flutter_kit {
+
+// Rough cost of answering a method, used to decide where it may run.
+enum class CostClass : uint8_t {
+  kTrivial,    // in-memory state or a single cheap syscall
+  kFileProbe,  // a handful of stat()/access() calls
+  kScan,       // walks /proc, /sys or the registry, or hashes files
+  kNetwork,    // talks to a remote host
+};
+
+enum class Effect : uint8_t {
+  kPure,        // only observes the system; safe to batch and repeat
+  kSideEffect,  // changes plugin or system state
+};
+
+// What a successful call replies with.
+enum class ReplyKind : uint8_t {
+  kBool,
+  kValue,  // string, list or map
+  kNone,
+};
+
+enum class Method : uint8_t {
+  kGetPlatformVersion,
+  kIsRooted,
+  kIsJailbroken,
+  kIsEmulator,
+  kGetEmulatorDetails,
+  kIsDebuggerAttached,
+  kEnableScreenCaptureProtection,
+  kDisableScreenCaptureProtection,
+  kIsScreenCaptureBlocked,
+  kIsUsbCableAttached,
+  kGetUsbConnectionStatus,
+  kGetAppSignature,
+  kVerifyAppIntegrity,
+  kGetDeviceFingerprint,
+  kRefreshFingerprint,
+  kEnableSecureFlag,
+  kEnableNetworkMonitoring,
+  kEnableRealTimeMonitoring,
+  kPreventReverseEngineering,
+  kApplyAntiTampering,
+  kHasProxySettings,
+  kHasVPNConnection,
+  kGetUnexpectedCertificates,
+  kIsDeveloperModeEnabled,
+  kOpenDeveloperOptionsSettings,
+  kGetSecuritySnapshot,
+  kConfigureSSLPinning,
+  kVerifySSLPinning,
+  kListUsbDevices,
+  kSetLogLevel,
+  kGetPerformanceStats,
+  kGetRunningAnalysisTools,
+  kSetProcessSignatures,
+  kGetNetworkInterfaces,
+  kEncrypt,
+  kDecrypt,
+  kBeginEncrypt,
+  kBeginDecrypt,
+  kCipherUpdate,
+  kCipherFinish,
+  kSecureStore,
+  kSecureRetrieve,
+  kSecureDelete,
+  kClearAllSecureData,
+  kVerifyAssets,
+};
+
+struct MethodInfo {
+  std::string_view name;
+  Method id;
+  CostClass cost;
+  Effect effect;
+  ReplyKind reply;
+
+  // Pure yes/no checks are what a security snapshot is made of.
+  constexpr bool IsSnapshotCheck() const {
+    return effect == Effect::kPure && reply == ReplyKind::kBool &&
+           cost != CostClass::kNetwork;
+  }
+};
+
+// Ordered by Method; checked below.
+inline constexpr MethodInfo kMethods[] = {
+    {"getPlatformVersion", Method::kGetPlatformVersion, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kValue},
+    {"isRooted", Method::kIsRooted, CostClass::kFileProbe, Effect::kPure,
+     ReplyKind::kBool},
+    {"isJailbroken", Method::kIsJailbroken, CostClass::kFileProbe,
+     Effect::kPure, ReplyKind::kBool},
+    {"isEmulator", Method::kIsEmulator, CostClass::kScan, Effect::kPure,
+     ReplyKind::kBool},
+    {"getEmulatorDetails", Method::kGetEmulatorDetails, CostClass::kScan,
+     Effect::kPure, ReplyKind::kValue},
+    {"isDebuggerAttached", Method::kIsDebuggerAttached, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kBool},
+    {"enableScreenCaptureProtection", Method::kEnableScreenCaptureProtection,
+     CostClass::kFileProbe, Effect::kSideEffect, ReplyKind::kNone},
+    {"disableScreenCaptureProtection",
+     Method::kDisableScreenCaptureProtection, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"isScreenCaptureBlocked", Method::kIsScreenCaptureBlocked,
+     CostClass::kFileProbe, Effect::kPure, ReplyKind::kBool},
+    {"isUsbCableAttached", Method::kIsUsbCableAttached, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kBool},
+    {"getUsbConnectionStatus", Method::kGetUsbConnectionStatus,
+     CostClass::kTrivial, Effect::kPure, ReplyKind::kValue},
+    {"getAppSignature", Method::kGetAppSignature, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kValue},
+    {"verifyAppIntegrity", Method::kVerifyAppIntegrity, CostClass::kScan,
+     Effect::kPure, ReplyKind::kBool},
+    {"getDeviceFingerprint", Method::kGetDeviceFingerprint,
+     CostClass::kTrivial, Effect::kPure, ReplyKind::kValue},
+    {"refreshFingerprint", Method::kRefreshFingerprint, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kBool},
+    {"enableSecureFlag", Method::kEnableSecureFlag, CostClass::kTrivial,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"enableNetworkMonitoring", Method::kEnableNetworkMonitoring,
+     CostClass::kTrivial, Effect::kSideEffect, ReplyKind::kNone},
+    {"enableRealTimeMonitoring", Method::kEnableRealTimeMonitoring,
+     CostClass::kTrivial, Effect::kSideEffect, ReplyKind::kNone},
+    {"preventReverseEngineering", Method::kPreventReverseEngineering,
+     CostClass::kFileProbe, Effect::kSideEffect, ReplyKind::kNone},
+    {"applyAntiTampering", Method::kApplyAntiTampering, CostClass::kScan,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"hasProxySettings", Method::kHasProxySettings, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kBool},
+    {"hasVPNConnection", Method::kHasVPNConnection, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kBool},
+    {"getUnexpectedCertificates", Method::kGetUnexpectedCertificates,
+     CostClass::kTrivial, Effect::kPure, ReplyKind::kValue},
+    {"isDeveloperModeEnabled", Method::kIsDeveloperModeEnabled,
+     CostClass::kFileProbe, Effect::kPure, ReplyKind::kBool},
+    {"openDeveloperOptionsSettings", Method::kOpenDeveloperOptionsSettings,
+     CostClass::kScan, Effect::kSideEffect, ReplyKind::kNone},
+    {"getSecuritySnapshot", Method::kGetSecuritySnapshot, CostClass::kScan,
+     Effect::kPure, ReplyKind::kValue},
+    {"configureSSLPinning", Method::kConfigureSSLPinning, CostClass::kTrivial,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"verifySSLPinning", Method::kVerifySSLPinning, CostClass::kNetwork,
+     Effect::kPure, ReplyKind::kBool},
+    {"listUsbDevices", Method::kListUsbDevices, CostClass::kFileProbe,
+     Effect::kPure, ReplyKind::kValue},
+    {"setLogLevel", Method::kSetLogLevel, CostClass::kTrivial,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"getPerformanceStats", Method::kGetPerformanceStats, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kValue},
+    {"getRunningAnalysisTools", Method::kGetRunningAnalysisTools,
+     CostClass::kScan, Effect::kPure, ReplyKind::kValue},
+    {"setProcessSignatures", Method::kSetProcessSignatures, CostClass::kTrivial,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"getNetworkInterfaces", Method::kGetNetworkInterfaces, CostClass::kTrivial,
+     Effect::kPure, ReplyKind::kValue},
+    {"encrypt", Method::kEncrypt, CostClass::kScan, Effect::kPure,
+     ReplyKind::kValue},
+    {"decrypt", Method::kDecrypt, CostClass::kScan, Effect::kPure,
+     ReplyKind::kValue},
+    {"beginEncrypt", Method::kBeginEncrypt, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kValue},
+    {"beginDecrypt", Method::kBeginDecrypt, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kValue},
+    {"cipherUpdate", Method::kCipherUpdate, CostClass::kScan,
+     Effect::kSideEffect, ReplyKind::kValue},
+    {"cipherFinish", Method::kCipherFinish, CostClass::kScan,
+     Effect::kSideEffect, ReplyKind::kValue},
+    {"secureStore", Method::kSecureStore, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"secureRetrieve", Method::kSecureRetrieve, CostClass::kFileProbe,
+     Effect::kPure, ReplyKind::kValue},
+    {"secureDelete", Method::kSecureDelete, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kBool},
+    {"clearAllSecureData", Method::kClearAllSecureData, CostClass::kFileProbe,
+     Effect::kSideEffect, ReplyKind::kNone},
+    {"verifyAssets", Method::kVerifyAssets, CostClass::kScan, Effect::kPure,
+     ReplyKind::kValue},
+};
+
+inline constexpr size_t kMethodCount = std::size(kMethods);
+
+constexpr const MethodInfo& GetMethodInfo(Method id) {
+  return kMethods[static_cast<size_t>(id)];
+}
+
+namespace registry_internal {
+
+// Four times the method count rounded up to a power of two. A sparser
+// table makes a collision-free seed turn up within a few dozen attempts,
+// which keeps the search inside every compiler's constexpr step limit.
+constexpr size_t kSlotCount = [] {
+  size_t slots = 1;
+  while (slots < kMethodCount * 4) {
+    slots *= 2;
+  }
+  return slots;
+}();
+
+constexpr uint8_t kEmptySlot = 0xFF;
+
+// FNV-1a over the name, seeded.
+constexpr uint32_t Hash(std::string_view name, uint32_t seed) {
+  uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+  for (const char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash ^ (hash >> 15);
+}
+
+struct PerfectHash {
+  uint32_t seed = 0;
+  bool found = false;
+  std::array<uint8_t, kSlotCount> slots{};
+};
+
+constexpr PerfectHash BuildPerfectHash() {
+  PerfectHash table;
+  for (uint32_t seed = 0; seed < 1024; ++seed) {
+    for (auto& slot : table.slots) {
+      slot = kEmptySlot;
+    }
+    bool collision = false;
+    for (size_t i = 0; i < kMethodCount && !collision; ++i) {
+      auto& slot = table.slots[Hash(kMethods[i].name, seed) & (kSlotCount - 1)];
+      collision = slot != kEmptySlot;
+      slot = static_cast<uint8_t>(i);
+    }
+    if (!collision) {
+      table.seed = seed;
+      table.found = true;
+      return table;
+    }
+  }
+  return table;
+}
+
+constexpr bool IdsMatchOrder() {
+  for (size_t i = 0; i < kMethodCount; ++i) {
+    if (static_cast<size_t>(kMethods[i].id) != i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline constexpr PerfectHash kPerfectHash = BuildPerfectHash();
+
+static_assert(IdsMatchOrder(), "kMethods must be ordered by Method");
+static_assert(kMethodCount < kEmptySlot, "slot indices are one byte");
+static_assert(kPerfectHash.found,
+              "no collision-free seed; raise the seed limit or slot count");
+
+}  // namespace registry_internal
+
+// Returns the registry entry for a method-channel name, or nullptr.
+constexpr const MethodInfo* FindMethod(std::string_view name) {
+  using namespace registry_internal;
+  const uint8_t index =
+      kPerfectHash.slots[Hash(name, kPerfectHash.seed) & (kSlotCount - 1)];
+  if (index == kEmptySlot || kMethods[index].name != name) {
+    return nullptr;
+  }
+  return &kMethods[index];
+}
+
+static_assert(FindMethod("verifySSLPinning") ==
+              &kMethods[static_cast<size_t>(Method::kVerifySSLPinning)]);
+static_assert(FindMethod("isRootedX") == nullptr);
+
+}  // namespace ultra_secure_flutter_kit
+
+#endif  // ULTRA_SECURE_FLUTTER_KIT_SRC_CHECK_REGISTRY_H_
@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:ultra_secure_flutter_kit/ultra_secure_flutter_kit.dart';
 import 'package:ultra_secure_flutter_kit/ultra_secure_flutter_kit_platform_interface.dart';
@@ -18,6 +20,14 @@ class MockUltraSecureFlutterKitPlatform
   @override
   Future<bool> isEmulator() => Future.value(false);
 
+  @override
+  Future<Map<String, dynamic>> getEmulatorDetails() => Future.value({
+    'isEmulator': false,
+    'confidence': 0.0,
+    'source': 'none',
+    'vendor': '',
+  });
+
   @override
   Future<bool> isDebuggerAttached() => Future.value(false);
 
@@ -41,6 +51,9 @@ class MockUltraSecureFlutterKitPlatform
     'isDataTransfer': false,
   });
 
+  @override
+  Future<List<Map<String, dynamic>>> listUsbDevices() => Future.value([]);
+
   @override
   Future<String> getAppSignature() => Future.value('mock_signature');
 
@@ -50,6 +63,9 @@ class MockUltraSecureFlutterKitPlatform
   @override
   Future<String> getDeviceFingerprint() => Future.value('mock_fingerprint');
 
+  @override
+  Future<bool> refreshFingerprint({bool force = false}) => Future.value(force);
+
   @override
   Future<void> enableSecureFlag() => Future.value();
 
@@ -60,7 +76,8 @@ class MockUltraSecureFlutterKitPlatform
   Future<void> enableRealTimeMonitoring() => Future.value();
 
   @override
-  Future<void> preventReverseEngineering() => Future.value();
+  Future<void> preventReverseEngineering({bool denyDebuggerAttach = false}) =>
+      Future.value();
 
   @override
   Future<void> applyAntiTampering() => Future.value();
@@ -80,6 +97,30 @@ class MockUltraSecureFlutterKitPlatform
   @override
   Future<void> openDeveloperOptionsSettings() => Future.value();
 
+  @override
+  Future<Map<String, dynamic>> getSecuritySnapshot() => Future.value({
+    'isRooted': false,
+    'isEmulator': false,
+    'isDebuggerAttached': false,
+    'hasVPNConnection': false,
+    'failedChecks': <String>[],
+  });
+
+  @override
+  Future<Map<String, dynamic>> getPerformanceStats() => Future.value({
+    'methods': <String, dynamic>{
+      'isRooted': <String, dynamic>{
+        'count': 3,
+        'errors': 0,
+        'p50Micros': 12.5,
+        'p99Micros': 40.0,
+      },
+    },
+  });
+
+  @override
+  Stream<Map<String, dynamic>> securityEvents() => const Stream.empty();
+
   @override
   Future<void> configureSSLPinning(
     List<String> certificates,
@@ -88,6 +129,94 @@ class MockUltraSecureFlutterKitPlatform
 
   @override
   Future<bool> verifySSLPinning(String url) => Future.value(true);
+
+  @override
+  Future<void> setLogLevel(String level) => Future.value();
+
+  @override
+  Future<Map<String, dynamic>> getRunningAnalysisTools() => Future.value({
+    'processes': <Map<String, dynamic>>[
+      {
+        'pid': 4242,
+        'name': 'gdb',
+        'exe': '/usr/bin/gdb',
+        'signature': 'gdb',
+      },
+    ],
+    'tracer': null,
+    'eventDriven': true,
+  });
+
+  @override
+  Future<void> setProcessSignatures(List<String> signatures) =>
+      Future.value();
+
+  @override
+  Future<Map<String, dynamic>> getNetworkInterfaces() => Future.value({
+    'interfaces': <Map<String, dynamic>>[
+      {
+        'index': 1,
+        'name': 'lo',
+        'kind': '',
+        'type': 'loopback',
+        'hardwareType': 772,
+        'isUp': true,
+        'isTunnel': false,
+      },
+      {
+        'index': 2,
+        'name': 'eth0',
+        'kind': '',
+        'type': 'ethernet',
+        'hardwareType': 1,
+        'isUp': true,
+        'isTunnel': false,
+      },
+    ],
+    'defaultRouteInterfaces': <String>['eth0'],
+    'defaultRouteViaTunnel': false,
+    'hasVPN': false,
+    'vpnInterface': '',
+  });
+
+  @override
+  Future<Uint8List> getSecuritySnapshotRecord() => Future.value(Uint8List(0));
+
+  @override
+  Future<Uint8List> encrypt(Uint8List data) => Future.value(data);
+
+  @override
+  Future<Uint8List> decrypt(Uint8List data) => Future.value(data);
+
+  @override
+  Future<int> beginEncrypt() => Future.value(1);
+
+  @override
+  Future<int> beginDecrypt() => Future.value(2);
+
+  @override
+  Future<Uint8List> cipherUpdate(int handle, Uint8List data) =>
+      Future.value(data);
+
+  @override
+  Future<Uint8List> cipherFinish(int handle) => Future.value(Uint8List(0));
+
+  @override
+  Future<void> secureStore(String key, String value, {Duration? expiresIn}) =>
+      Future.value();
+
+  @override
+  Future<String?> secureRetrieve(String key) => Future.value(null);
+
+  @override
+  Future<void> secureDelete(String key) => Future.value();
+
+  @override
+  Future<void> clearAllSecureData() => Future.value();
+
+  @override
+  Future<Map<String, dynamic>> verifyAssets({bool wait = false}) =>
+      Future.value(<String, dynamic>{});
 }
 
 void main() {
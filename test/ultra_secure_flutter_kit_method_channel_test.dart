@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
 import 'package:ultra_secure_flutter_kit/ultra_secure_flutter_kit_method_channel.dart';
@@ -24,4 +26,217 @@ void main() {
   test('getPlatformVersion', () async {
     expect(await platform.getPlatformVersion(), '42');
   });
+
+  test('preventReverseEngineering forwards denyDebuggerAttach', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return null;
+      },
+    );
+
+    await platform.preventReverseEngineering(denyDebuggerAttach: true);
+    expect(call?.method, 'preventReverseEngineering');
+    expect(call?.arguments, {'denyDebuggerAttach': true});
+  });
+
+  test('encrypt sends the bytes as a Uint8List', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return Uint8List.fromList([9, 9]);
+      },
+    );
+
+    final data = Uint8List.fromList([1, 2, 3]);
+    expect(await platform.encrypt(data), [9, 9]);
+    expect(call?.method, 'encrypt');
+    expect(call?.arguments, {'data': data});
+  });
+
+  test('secureStore sends the expiry in milliseconds', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return null;
+      },
+    );
+
+    await platform.secureStore('k', 'v', expiresIn: const Duration(minutes: 1));
+    expect(call?.method, 'secureStore');
+    expect(call?.arguments, {'key': 'k', 'value': 'v', 'expiresInMillis': 60000});
+  });
+
+  test('verifyAssets sends wait', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return {'verified': true, 'mismatched': <String>[]};
+      },
+    );
+
+    final report = await platform.verifyAssets(wait: true);
+    expect(call?.method, 'verifyAssets');
+    expect(call?.arguments, {'wait': true});
+    expect(report['verified'], isTrue);
+  });
+
+  test('verifyAssets does not wait by default', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return null;
+      },
+    );
+
+    expect(await platform.verifyAssets(), isEmpty);
+    expect(call?.arguments, {'wait': false});
+  });
+
+  test('getSecuritySnapshot sends no arguments and string-keys the reply', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return {
+          'isRooted': true,
+          'hasVPNConnection': false,
+          'failedChecks': ['isEmulator'],
+          'platform': 'linux',
+          'timestamp': 1700000000000,
+        };
+      },
+    );
+
+    final snapshot = await platform.getSecuritySnapshot();
+    expect(call?.method, 'getSecuritySnapshot');
+    expect(call?.arguments, isNull);
+    expect(snapshot, isA<Map<String, dynamic>>());
+    expect(snapshot['isRooted'], isTrue);
+    expect(snapshot['hasVPNConnection'], isFalse);
+    expect(snapshot['failedChecks'], ['isEmulator']);
+    expect(snapshot['timestamp'], 1700000000000);
+  });
+
+  test('getSecuritySnapshot returns an empty map for a null reply', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async => null,
+    );
+
+    expect(await platform.getSecuritySnapshot(), isEmpty);
+  });
+
+  test('getPerformanceStats string-keys the nested method stats', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return {
+          'methods': {
+            'isRooted': {'count': 3, 'p99Micros': 40.0},
+          },
+        };
+      },
+    );
+
+    final stats = await platform.getPerformanceStats();
+    expect(call?.method, 'getPerformanceStats');
+    expect(call?.arguments, isNull);
+    expect(stats['methods'], isA<Map<String, dynamic>>());
+    expect(stats['methods']['isRooted'], isA<Map<String, dynamic>>());
+    expect(stats['methods']['isRooted']['count'], 3);
+  });
+
+  test('getRunningAnalysisTools string-keys the maps in the process list', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return {
+          'processes': [
+            {'pid': 42, 'name': 'gdb'},
+          ],
+          'tracer': null,
+        };
+      },
+    );
+
+    final report = await platform.getRunningAnalysisTools();
+    expect(call?.method, 'getRunningAnalysisTools');
+    expect(call?.arguments, isNull);
+    expect(report['processes'][0], isA<Map<String, dynamic>>());
+    expect(report['processes'][0]['name'], 'gdb');
+    expect(report.containsKey('tracer'), isTrue);
+    expect(report['tracer'], isNull);
+  });
+
+  test('getNetworkInterfaces string-keys each interface', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return {
+          'interfaces': [
+            {'name': 'wg0', 'kind': 'wireguard', 'type': 'tunnel', 'isTunnel': true},
+          ],
+          'defaultRouteInterfaces': ['wg0'],
+          'hasVPN': true,
+        };
+      },
+    );
+
+    final network = await platform.getNetworkInterfaces();
+    expect(call?.method, 'getNetworkInterfaces');
+    expect(call?.arguments, isNull);
+    expect(network['interfaces'][0], isA<Map<String, dynamic>>());
+    expect(network['interfaces'][0]['kind'], 'wireguard');
+    expect(network['defaultRouteInterfaces'], ['wg0']);
+    expect(network['hasVPN'], isTrue);
+  });
+
+  test('getNetworkInterfaces returns an empty map for a null reply', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async => null,
+    );
+
+    expect(await platform.getNetworkInterfaces(), isEmpty);
+  });
+
+  test('listUsbDevices string-keys each device and skips non-maps', () async {
+    MethodCall? call;
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger.setMockMethodCallHandler(
+      channel,
+      (MethodCall methodCall) async {
+        call = methodCall;
+        return [
+          {'vendorId': '1d6b', 'productId': '0002'},
+          'not a device',
+        ];
+      },
+    );
+
+    final devices = await platform.listUsbDevices();
+    expect(call?.method, 'listUsbDevices');
+    expect(call?.arguments, isNull);
+    expect(devices, [
+      {'vendorId': '1d6b', 'productId': '0002'},
+    ]);
+    expect(devices.single, isA<Map<String, dynamic>>());
+  });
 }
@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:flutter_test/flutter_test.dart';
 import 'package:ultra_secure_flutter_kit/ultra_secure_flutter_kit.dart';
 import 'package:ultra_secure_flutter_kit/ultra_secure_flutter_kit_platform_interface.dart';
@@ -19,6 +21,14 @@ class MockUltraSecureFlutterKitPlatform
   @override
   Future<bool> isEmulator() => Future.value(false);
 
+  @override
+  Future<Map<String, dynamic>> getEmulatorDetails() => Future.value({
+    'isEmulator': false,
+    'confidence': 0.0,
+    'source': 'none',
+    'vendor': '',
+  });
+
   @override
   Future<bool> isDebuggerAttached() => Future.value(false);
 
@@ -42,6 +52,9 @@ class MockUltraSecureFlutterKitPlatform
     'isDataTransfer': false,
   });
 
+  @override
+  Future<List<Map<String, dynamic>>> listUsbDevices() => Future.value([]);
+
   @override
   Future<String> getAppSignature() => Future.value('mock_signature');
 
@@ -51,6 +64,9 @@ class MockUltraSecureFlutterKitPlatform
   @override
   Future<String> getDeviceFingerprint() => Future.value('mock_fingerprint');
 
+  @override
+  Future<bool> refreshFingerprint({bool force = false}) => Future.value(force);
+
   @override
   Future<void> enableSecureFlag() => Future.value();
 
@@ -61,7 +77,8 @@ class MockUltraSecureFlutterKitPlatform
   Future<void> enableRealTimeMonitoring() => Future.value();
 
   @override
-  Future<void> preventReverseEngineering() => Future.value();
+  Future<void> preventReverseEngineering({bool denyDebuggerAttach = false}) =>
+      Future.value();
 
   @override
   Future<void> applyAntiTampering() => Future.value();
@@ -81,6 +98,30 @@ class MockUltraSecureFlutterKitPlatform
   @override
   Future<void> openDeveloperOptionsSettings() => Future.value();
 
+  @override
+  Future<Map<String, dynamic>> getSecuritySnapshot() => Future.value({
+    'isRooted': false,
+    'isEmulator': false,
+    'isDebuggerAttached': false,
+    'hasVPNConnection': false,
+    'failedChecks': <String>[],
+  });
+
+  @override
+  Future<Map<String, dynamic>> getPerformanceStats() => Future.value({
+    'methods': <String, dynamic>{
+      'isRooted': <String, dynamic>{
+        'count': 3,
+        'errors': 0,
+        'p50Micros': 12.5,
+        'p99Micros': 40.0,
+      },
+    },
+  });
+
+  @override
+  Stream<Map<String, dynamic>> securityEvents() => const Stream.empty();
+
   @override
   Future<void> configureSSLPinning(
     List<String> certificates,
@@ -89,6 +130,159 @@ class MockUltraSecureFlutterKitPlatform
 
   @override
   Future<bool> verifySSLPinning(String url) => Future.value(true);
+
+  @override
+  Future<void> setLogLevel(String level) => Future.value();
+
+  @override
+  Future<Map<String, dynamic>> getRunningAnalysisTools() => Future.value({
+    'processes': <Map<String, dynamic>>[
+      {
+        'pid': 4242,
+        'name': 'gdb',
+        'exe': '/usr/bin/gdb',
+        'signature': 'gdb',
+      },
+    ],
+    'tracer': null,
+    'eventDriven': true,
+  });
+
+  @override
+  Future<void> setProcessSignatures(List<String> signatures) =>
+      Future.value();
+
+  @override
+  Future<Map<String, dynamic>> getNetworkInterfaces() => Future.value({
+    'interfaces': <Map<String, dynamic>>[
+      {
+        'index': 1,
+        'name': 'lo',
+        'kind': '',
+        'type': 'loopback',
+        'hardwareType': 772,
+        'isUp': true,
+        'isTunnel': false,
+      },
+      {
+        'index': 2,
+        'name': 'eth0',
+        'kind': '',
+        'type': 'ethernet',
+        'hardwareType': 1,
+        'isUp': true,
+        'isTunnel': false,
+      },
+    ],
+    'defaultRouteInterfaces': <String>['eth0'],
+    'defaultRouteViaTunnel': false,
+    'hasVPN': false,
+    'vpnInterface': '',
+  });
+
+  @override
+  Future<Uint8List> getSecuritySnapshotRecord() =>
+      Future.value(_snapshotRecord());
+
+  // A stand-in cipher: XOR with 0x5a, with encryption streams holding
+  // back one byte until cipherFinish the way the native side holds back
+  // the last segment.
+  final Map<int, List<int>> _heldBack = {};
+  final List<int> startedStreams = [];
+  final List<int> finishedStreams = [];
+
+  static Uint8List _xor(List<int> data) =>
+      Uint8List.fromList([for (final byte in data) byte ^ 0x5a]);
+
+  @override
+  Future<Uint8List> encrypt(Uint8List data) => Future.value(_xor(data));
+
+  @override
+  Future<Uint8List> decrypt(Uint8List data) => Future.value(_xor(data));
+
+  @override
+  Future<int> beginEncrypt() {
+    startedStreams.add(1);
+    _heldBack[1] = [];
+    return Future.value(1);
+  }
+
+  @override
+  Future<int> beginDecrypt() {
+    startedStreams.add(2);
+    _heldBack[2] = [];
+    return Future.value(2);
+  }
+
+  @override
+  Future<Uint8List> cipherUpdate(int handle, Uint8List data) {
+    final pending = _heldBack[handle]!..addAll(data);
+    final ready = pending.length > 1 ? pending.length - 1 : 0;
+    final output = _xor(pending.sublist(0, ready));
+    pending.removeRange(0, ready);
+    return Future.value(output);
+  }
+
+  @override
+  Future<Uint8List> cipherFinish(int handle) {
+    finishedStreams.add(handle);
+    return Future.value(_xor(_heldBack.remove(handle)!));
+  }
+
+  final Map<String, String> storedValues = {};
+
+  @override
+  Future<void> secureStore(String key, String value, {Duration? expiresIn}) {
+    storedValues[key] = value;
+    return Future.value();
+  }
+
+  @override
+  Future<String?> secureRetrieve(String key) => Future.value(storedValues[key]);
+
+  @override
+  Future<void> secureDelete(String key) {
+    storedValues.remove(key);
+    return Future.value();
+  }
+
+  @override
+  Future<void> clearAllSecureData() {
+    storedValues.clear();
+    return Future.value();
+  }
+
+  @override
+  Future<Map<String, dynamic>> verifyAssets({bool wait = false}) =>
+      Future.value({
+        'manifestFound': true,
+        'signatureValid': true,
+        'complete': wait,
+        'verified': false,
+        'filesTotal': 3,
+        'filesVerified': wait ? 2 : 1,
+        'mismatched': wait ? ['data/flutter_assets/AssetManifest.json'] : [],
+        'missing': <String>[],
+      });
+}
+
+/// A record as the Linux plugin encodes it: isRooted answered true,
+/// hasVPNConnection threw, two USB devices attached.
+Uint8List _snapshotRecord() {
+  final data = ByteData(SecuritySnapshotView.recordSize);
+  data.setUint32(0, SecuritySnapshotView.recordMagic, Endian.little);
+  data.setUint16(4, SecuritySnapshotView.formatVersion, Endian.little);
+  data.setUint16(6, SecuritySnapshotView.recordSize, Endian.little);
+  data.setUint64(8, 1 << 1, Endian.little);
+  data.setUint64(16, (1 << 1) | (1 << 21), Endian.little);
+  data.setUint64(24, 1 << 21, Endian.little);
+  data.setInt64(32, 1700000000000, Endian.little);
+  data.setInt64(40, 850, Endian.little);
+  data.setUint32(52, 2, Endian.little);
+  data.setUint8(56, 1);
+  data.setUint8(57, 1);
+  data.setUint8(59, 0x12);
+  return data.buffer.asUint8List();
 }
 
 void main() {
@@ -129,4 +323,98 @@ void main() {
     expect(status['isCharging'], false);
     expect(status['isDataTransfer'], false);
   });
+
+
+
+
+
+
+  test('getSecuritySnapshotRecord', () async {
+    UltraSecureFlutterKit ultraSecureFlutterKitPlugin = UltraSecureFlutterKit();
+    MockUltraSecureFlutterKitPlatform fakePlatform =
+        MockUltraSecureFlutterKitPlatform();
+    UltraSecureFlutterKitPlatform.instance = fakePlatform;
+
+    final record = await ultraSecureFlutterKitPlugin.getSecuritySnapshotRecord();
+    expect(record, isNotNull);
+    expect(record!.isRooted, isTrue);
+    expect(record.isEmulator, isNull);
+    expect(record.failedChecks, ['hasVPNConnection']);
+    expect(record.platform, 'linux');
+    expect(record.usbConnectionType, 'data_transfer');
+    expect(record.isConnectedViaUsb, isTrue);
+    expect(record.usbDeviceCount, 2);
+    expect(record.toMap()['timestamp'], 1700000000000);
+    expect(
+      () => SecuritySnapshotView(Uint8List(SecuritySnapshotView.recordSize)),
+      throwsFormatException,
+    );
+  });
+
+  test('encryptStream matches encryptBytes and closes the stream', () async {
+    UltraSecureFlutterKit ultraSecureFlutterKitPlugin = UltraSecureFlutterKit();
+    MockUltraSecureFlutterKitPlatform fakePlatform =
+        MockUltraSecureFlutterKitPlatform();
+    UltraSecureFlutterKitPlatform.instance = fakePlatform;
+
+    final chunks = [
+      [1, 2, 3],
+      <int>[],
+      [4, 5],
+    ];
+    final sealed = await ultraSecureFlutterKitPlugin
+        .encryptStream(Stream.fromIterable(chunks))
+        .expand((chunk) => chunk)
+        .toList();
+    expect(
+      sealed,
+      await ultraSecureFlutterKitPlugin.encryptBytes(
+        Uint8List.fromList([1, 2, 3, 4, 5]),
+      ),
+    );
+
+    final opened = await ultraSecureFlutterKitPlugin
+        .decryptStream(Stream.value(sealed))
+        .expand((chunk) => chunk)
+        .toList();
+    expect(opened, [1, 2, 3, 4, 5]);
+    expect(fakePlatform.finishedStreams, [1, 2]);
+  });
+
+  test('encryptStream opens the native stream only when listened to', () async {
+    UltraSecureFlutterKit ultraSecureFlutterKitPlugin = UltraSecureFlutterKit();
+    MockUltraSecureFlutterKitPlatform fakePlatform =
+        MockUltraSecureFlutterKitPlatform();
+    UltraSecureFlutterKitPlatform.instance = fakePlatform;
+
+    final stream = ultraSecureFlutterKitPlugin.encryptStream(
+      Stream.value([1, 2, 3]),
+    );
+    ultraSecureFlutterKitPlugin.decryptStream(Stream.value([1, 2, 3]));
+    expect(fakePlatform.startedStreams, isEmpty);
+
+    await stream.drain<void>();
+    expect(fakePlatform.startedStreams, [1]);
+    expect(fakePlatform.finishedStreams, [1]);
+  });
+
+  test('secureStore uses the platform store', () async {
+    UltraSecureFlutterKit ultraSecureFlutterKitPlugin = UltraSecureFlutterKit();
+    MockUltraSecureFlutterKitPlatform fakePlatform =
+        MockUltraSecureFlutterKitPlatform();
+    UltraSecureFlutterKitPlatform.instance = fakePlatform;
+
+    await ultraSecureFlutterKitPlugin.secureStore('token', 'abc');
+    expect(fakePlatform.storedValues, {'token': 'abc'});
+    expect(await ultraSecureFlutterKitPlugin.secureRetrieve('token'), 'abc');
+    await ultraSecureFlutterKitPlugin.secureDelete('token');
+    expect(await ultraSecureFlutterKitPlugin.secureRetrieve('token'), isNull);
+  });
+
+
+  test('nativeChecks is null without the plugin library', () {
+    UltraSecureFlutterKit ultraSecureFlutterKitPlugin = UltraSecureFlutterKit();
+
+    expect(ultraSecureFlutterKitPlugin.nativeChecks, isNull);
+  });
 }
@@ -23,6 +23,8 @@
 // #include <setupapi.h>
 // #include <devguid.h>
 
+// #include "check_registry.h"
+
 // namespace {
 
 // class UltraSecureFlutterKitWindows : public flutter::Plugin {
@@ -53,117 +55,141 @@
 //   void HandleMethodCall(
 //       const flutter::MethodCall<flutter::EncodableValue>& method_call,
 //       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
-    
-//     const std::string& method_name = method_call.method_name();
-
-//     if (method_name.compare("getPlatformVersion") == 0) {
-//       result->Success(flutter::EncodableValue("Windows " + GetWindowsVersion()));
-//     } else if (method_name.compare("isRooted") == 0) {
-//       result->Success(flutter::EncodableValue(IsRooted()));
-//     } else if (method_name.compare("isJailbroken") == 0) {
-//       result->Success(flutter::EncodableValue(IsJailbroken()));
-//     } else if (method_name.compare("isEmulator") == 0) {
-//       result->Success(flutter::EncodableValue(IsEmulator()));
-//     } else if (method_name.compare("isDebuggerAttached") == 0) {
-//       result->Success(flutter::EncodableValue(IsDebuggerAttached()));
-//     } else if (method_name.compare("enableScreenCaptureProtection") == 0) {
-//       EnableScreenCaptureProtection();
-//       result->Success();
-//     } else if (method_name.compare("disableScreenCaptureProtection") == 0) {
-//       DisableScreenCaptureProtection();
-//       result->Success();
-//     } else if (method_name.compare("isScreenCaptureBlocked") == 0) {
-//       result->Success(flutter::EncodableValue(IsScreenCaptureBlocked()));
-//     } else if (method_name.compare("isUsbCableAttached") == 0) {
-//       result->Success(flutter::EncodableValue(IsUsbCableAttached()));
-//     } else if (method_name.compare("getUsbConnectionStatus") == 0) {
-//       result->Success(GetUsbConnectionStatus());
-//     } else if (method_name.compare("getAppSignature") == 0) {
-//       result->Success(flutter::EncodableValue(GetAppSignature()));
-//     } else if (method_name.compare("verifyAppIntegrity") == 0) {
-//       result->Success(flutter::EncodableValue(VerifyAppIntegrity()));
-//     } else if (method_name.compare("getDeviceFingerprint") == 0) {
-//       result->Success(flutter::EncodableValue(GetDeviceFingerprint()));
-//     } else if (method_name.compare("enableSecureFlag") == 0) {
-//       EnableSecureFlag();
-//       result->Success();
-//     } else if (method_name.compare("enableNetworkMonitoring") == 0) {
-//       EnableNetworkMonitoring();
-//       result->Success();
-//     } else if (method_name.compare("enableRealTimeMonitoring") == 0) {
-//       EnableRealTimeMonitoring();
-//       result->Success();
-//     } else if (method_name.compare("preventReverseEngineering") == 0) {
-//       PreventReverseEngineering();
-//       result->Success();
-//     } else if (method_name.compare("applyAntiTampering") == 0) {
-//       ApplyAntiTampering();
-//       result->Success();
-//     } else if (method_name.compare("hasProxySettings") == 0) {
-//       result->Success(flutter::EncodableValue(HasProxySettings()));
-//     } else if (method_name.compare("hasVPNConnection") == 0) {
-//       result->Success(flutter::EncodableValue(HasVPNConnection()));
-//     } else if (method_name.compare("getUnexpectedCertificates") == 0) {
-//       result->Success(flutter::EncodableValue(GetUnexpectedCertificates()));
-//     } else if (method_name.compare("isDeveloperModeEnabled") == 0) {
-//       result->Success(flutter::EncodableValue(IsDeveloperModeEnabled()));
-//     } else if (method_name.compare("openDeveloperOptionsSettings") == 0) {
-//       OpenDeveloperOptionsSettings();
-//       result->Success();
-//     } else if (method_name.compare("configureSSLPinning") == 0) {
-//       const auto* arguments = std::get_if<flutter::EncodableMap>(method_call.arguments());
-//       if (arguments) {
-//         auto certificates_it = arguments->find(flutter::EncodableValue("certificates"));
-//         auto public_keys_it = arguments->find(flutter::EncodableValue("publicKeys"));
-        
-//         std::vector<std::string> certificates;
-//         std::vector<std::string> public_keys;
-        
-//         if (certificates_it != arguments->end()) {
-//           const auto* cert_list = std::get_if<flutter::EncodableList>(&certificates_it->second);
-//           if (cert_list) {
-//             for (const auto& cert : *cert_list) {
-//               if (const auto* cert_str = std::get_if<std::string>(&cert)) {
-//                 certificates.push_back(*cert_str);
-//               }
-//             }
-//           }
+//     using ultra_secure_flutter_kit::Method;
+//
+//     const auto* method = ultra_secure_flutter_kit::FindMethod(method_call.method_name());
+//     if (method == nullptr) {
+//       result->NotImplemented();
+//       return;
+//     }
+//
+//     if (method->IsSnapshotCheck()) {
+//       result->Success(flutter::EncodableValue(RunCheck(method->id)));
+//       return;
+//     }
+//
+//     switch (method->id) {
+//       case Method::kGetPlatformVersion:
+//         result->Success(flutter::EncodableValue("Windows " + GetWindowsVersion()));
+//         break;
+//       case Method::kEnableScreenCaptureProtection:
+//         EnableScreenCaptureProtection();
+//         result->Success();
+//         break;
+//       case Method::kDisableScreenCaptureProtection:
+//         DisableScreenCaptureProtection();
+//         result->Success();
+//         break;
+//       case Method::kGetUsbConnectionStatus:
+//         result->Success(GetUsbConnectionStatus());
+//         break;
+//       case Method::kGetAppSignature:
+//         result->Success(flutter::EncodableValue(GetAppSignature()));
+//         break;
+//       case Method::kGetDeviceFingerprint:
+//         result->Success(flutter::EncodableValue(GetDeviceFingerprint()));
+//         break;
+//       case Method::kEnableSecureFlag:
+//         EnableSecureFlag();
+//         result->Success();
+//         break;
+//       case Method::kEnableNetworkMonitoring:
+//         EnableNetworkMonitoring();
+//         result->Success();
+//         break;
+//       case Method::kEnableRealTimeMonitoring:
+//         EnableRealTimeMonitoring();
+//         result->Success();
+//         break;
+//       case Method::kPreventReverseEngineering:
+//         PreventReverseEngineering();
+//         result->Success();
+//         break;
+//       case Method::kApplyAntiTampering:
+//         ApplyAntiTampering();
+//         result->Success();
+//         break;
+//       case Method::kGetUnexpectedCertificates:
+//         result->Success(flutter::EncodableValue(GetUnexpectedCertificates()));
+//         break;
+//       case Method::kOpenDeveloperOptionsSettings:
+//         OpenDeveloperOptionsSettings();
+//         result->Success();
+//         break;
+//       case Method::kConfigureSSLPinning: {
+//         const auto* arguments = std::get_if<flutter::EncodableMap>(method_call.arguments());
+//         if (arguments) {
+//           ConfigureSSLPinning(StringList(*arguments, "certificates"),
+//                               StringList(*arguments, "publicKeys"));
 //         }
-        
-//         if (public_keys_it != arguments->end()) {
-//           const auto* key_list = std::get_if<flutter::EncodableList>(&public_keys_it->second);
-//           if (key_list) {
-//             for (const auto& key : *key_list) {
-//               if (const auto* key_str = std::get_if<std::string>(&key)) {
-//                 public_keys.push_back(*key_str);
-//               }
-//             }
+//         result->Success();
+//         break;
+//       }
+//       case Method::kVerifySSLPinning: {
+//         const auto* arguments = std::get_if<flutter::EncodableMap>(method_call.arguments());
+//         const std::string* url = nullptr;
+//         if (arguments) {
+//           auto url_it = arguments->find(flutter::EncodableValue("url"));
+//           if (url_it != arguments->end()) {
+//             url = std::get_if<std::string>(&url_it->second);
 //           }
 //         }
-        
-//         ConfigureSSLPinning(certificates, public_keys);
+//         result->Success(flutter::EncodableValue(url != nullptr && VerifySSLPinning(*url)));
+//         break;
 //       }
-//       result->Success();
-//     } else if (method_name.compare("verifySSLPinning") == 0) {
-//       const auto* arguments = std::get_if<flutter::EncodableMap>(method_call.arguments());
-//       if (arguments) {
-//         auto url_it = arguments->find(flutter::EncodableValue("url"));
-//         if (url_it != arguments->end()) {
-//           const auto* url = std::get_if<std::string>(&url_it->second);
-//           if (url) {
-//             result->Success(flutter::EncodableValue(VerifySSLPinning(*url)));
-//           } else {
-//             result->Success(flutter::EncodableValue(false));
-//           }
-//         } else {
-//           result->Success(flutter::EncodableValue(false));
+//       default:
+//         // Registry methods not implemented on Windows.
+//         result->NotImplemented();
+//         break;
+//     }
+//   }
+
+//   // Answers the argument-free yes/no checks, i.e. the methods for which
+//   // MethodInfo::IsSnapshotCheck() holds.
+//   bool RunCheck(ultra_secure_flutter_kit::Method id) {
+//     using ultra_secure_flutter_kit::Method;
+//
+//     switch (id) {
+//       case Method::kIsRooted:
+//         return IsRooted();
+//       case Method::kIsJailbroken:
+//         return IsJailbroken();
+//       case Method::kIsEmulator:
+//         return IsEmulator();
+//       case Method::kIsDebuggerAttached:
+//         return IsDebuggerAttached();
+//       case Method::kIsScreenCaptureBlocked:
+//         return IsScreenCaptureBlocked();
+//       case Method::kIsUsbCableAttached:
+//         return IsUsbCableAttached();
+//       case Method::kVerifyAppIntegrity:
+//         return VerifyAppIntegrity();
+//       case Method::kHasProxySettings:
+//         return HasProxySettings();
+//       case Method::kHasVPNConnection:
+//         return HasVPNConnection();
+//       case Method::kIsDeveloperModeEnabled:
+//         return IsDeveloperModeEnabled();
+//       default:
+//         return false;
+//     }
+//   }
+
+//   static std::vector<std::string> StringList(const flutter::EncodableMap& arguments,
+//                                              const char* key) {
+//     std::vector<std::string> values;
+//     auto it = arguments.find(flutter::EncodableValue(key));
+//     if (it == arguments.end()) {
+//       return values;
+//     }
+//     if (const auto* list = std::get_if<flutter::EncodableList>(&it->second)) {
+//       for (const auto& value : *list) {
+//         if (const auto* text = std::get_if<std::string>(&value)) {
+//           values.push_back(*text);
 //         }
-//       } else {
-//         result->Success(flutter::EncodableValue(false));
 //       }
-//     } else {
-//       result->NotImplemented();
 //     }
+//     return values;
 //   }
 
 //   // Platform-specific methods